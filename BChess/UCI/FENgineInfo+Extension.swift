@@ -13,8 +13,20 @@ let StartPosFEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
 extension FEngineInfo {
     
     var uciInfoMessage: String {
-        let lineInfo = bestLine(true)
-        
+        return uciInfoMessage(lineInfo: bestLine(true), value: value, multiPV: nil)
+    }
+    
+    // One info message per line, each one with its "multipv" rank
+    var uciInfoMessages: [String] {
+        if variationCount <= 1 {
+            return [uciInfoMessage]
+        }
+        return (0..<variationCount).map { index in
+            uciInfoMessage(lineInfo: variationLine(index, uci: true), value: variationValue(index), multiPV: index + 1)
+        }
+    }
+    
+    func uciInfoMessage(lineInfo: String, value: Int, multiPV: UInt?) -> String {
         // For UCI, the value is always from the engine's point of view.
         // Because the evaluation function always evaluate from WHITE's point of view,
         // if the engine is playing black, make sure to inverse the value.
@@ -27,11 +39,26 @@ extension FEngineInfo {
         
         let totalDepth = max(depth, quiescenceDepth)
         
-        return "info depth \(totalDepth) time \(time) nodes \(nodeEvaluated) nps \(movesPerSecond) score cp \(uciValue) pv \(lineInfo)"
+        let multiPVInfo: String
+        if let multiPV = multiPV {
+            multiPVInfo = " multipv \(multiPV)"
+        } else {
+            multiPVInfo = ""
+        }
+        
+        return "info\(multiPVInfo) depth \(totalDepth) time \(time) nodes \(nodeEvaluated) nps \(movesPerSecond) tbhits \(tablebaseHits) score cp \(uciValue) pv \(lineInfo)"
+    }
+    
+    // Statistics of the hash tables used by the search
+    var uciStatsMessage: String {
+        return "info string pawn hash hit rate \(pawnTableHitRate)% eval cache hits \(evalCacheHits) misses \(evalCacheMisses)"
     }
     
     var uciBestMove: String {
         if let move = bestMove(true) {
+            if let ponder = ponderMove(true) {
+                return "bestmove \(move) ponder \(ponder)"
+            }
             return "bestmove \(move)"
         } else {
             return "bestmove ??"
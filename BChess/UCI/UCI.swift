@@ -87,7 +87,15 @@ class UCI {
     func processCmdGo(_ tokens: inout [String]) {
         // go infinite
         // go wtime 300000 btime 300000
-        let cmd = tokens.removeFirst()
+        // go ponder wtime 300000 btime 300000
+        var cmd = tokens.removeFirst()
+        
+        // When pondering, the position already contains the expected move of
+        // the opponent and the search goes on until "ponderhit" or "stop".
+        let ponder = cmd == "ponder"
+        if ponder {
+            cmd = tokens.isEmpty ? "" : tokens.removeFirst()
+        }
         
         // UCI only plays with time control
         let depth: Int
@@ -100,15 +108,90 @@ class UCI {
             depth = -1
             time = 10 // 10 seconds for now
         }
-        engine.evaluate(depth, time: time) { (info, completed) in
+        engine.evaluate(depth, time: time, ponder: ponder) { (info, completed) in
             if completed {
+                self.engineOutput(info.uciStatsMessage)
                 self.engineOutput(info.uciBestMove)
             } else {
-                self.engineOutput(info.uciInfoMessage)
+                for message in info.uciInfoMessages {
+                    self.engineOutput(message)
+                }
             }
         }
     }
     
+    func processCmdSetOption(_ tokens: inout [String]) {
+        // setoption name MultiPV value 3
+        guard tokens.count >= 4, tokens[0] == "name", tokens[2] == "value" else {
+            engineOutput("Invalid option \(tokens.joined(separator: " "))")
+            return
+        }
+        let name = tokens[1]
+        let value = tokens[3...].joined(separator: " ") // A path can contain spaces
+        tokens.removeAll()
+        
+        switch name {
+        case "MultiPV":
+            if let count = UInt(value), count > 0 {
+                engine.multiPV = count
+            }
+            
+        case "Threads":
+            if let count = UInt(value), count > 0 {
+                engine.threads = count
+            }
+            
+        case "Hash":
+            if let megabytes = UInt(value), megabytes > 0 {
+                let time = engine.setHashSize(megabytes)
+                engineOutput("info string hash resized to \(megabytes) MB in \(Int(time * 1000)) ms")
+            }
+            
+        case "Ponder":
+            // Nothing to do, the GUI decides when to ponder with "go ponder"
+            break
+            
+        case "EvalFile":
+            if engine.loadNeuralNetwork(value) {
+                engineOutput("info string loaded neural network \(value)")
+            } else {
+                engineOutput("info string cannot load neural network \(value)")
+            }
+            
+        case "UseNNUE":
+            engine.neuralEvaluation = value == "true"
+            
+        case "SyzygyPath":
+            let count = engine.loadTablebases(value == "<empty>" ? "" : value)
+            engineOutput("info string found \(count) tablebases in \(value)")
+            
+        case "UseSyzygy":
+            engine.tablebases = value == "true"
+            
+        case "SyzygyProbeDepth":
+            if let depth = UInt(value), depth > 0 {
+                engine.tablebaseProbeDepth = depth
+            }
+            
+        case "BitbasesFile":
+            if engine.loadBitbases(value) {
+                engineOutput("info string loaded bitbases \(value)")
+            } else {
+                engineOutput("info string cannot load bitbases \(value)")
+            }
+            
+        case "EvalWeights":
+            if engine.loadEvaluationWeights(value) {
+                engineOutput("info string loaded evaluation weights \(value)")
+            } else {
+                engineOutput("info string cannot load evaluation weights \(value)")
+            }
+            
+        default:
+            engineOutput("Unknown option \(name)")
+        }
+    }
+    
     func process(_ tokens: inout [String]) {
         let cmd = tokens.removeFirst()
         
@@ -124,8 +207,9 @@ class UCI {
             write("readyok")
             
         case "ucinewgame":
-            // New game
-            break
+            // New game: the analysis of the previous game is no longer useful
+            let time = engine.newGame()
+            engineOutput("info string hash cleared in \(Int(time * 1000)) ms")
             
         case "position":
             processCmdPosition(&tokens)
@@ -133,9 +217,42 @@ class UCI {
         case "go":
             processCmdGo(&tokens)
             
+        case "setoption":
+            processCmdSetOption(&tokens)
+            
         case "stop":
             engine.stop()
             
+        case "ponderhit":
+            engine.ponderhit()
+            
+        case "bench":
+            engineOutput("info string \(engine.benchmarkEvaluation())")
+            
+        case "tune":
+            // tune positions.epd weights.txt 100
+            guard tokens.count >= 2 else {
+                engineOutput("Usage: tune <positions file> <weights file> [epochs]")
+                return
+            }
+            let epochs = tokens.count > 2 ? UInt(tokens[2]) ?? 100 : 100
+            engine.tuneEvaluation(tokens[0], weightsPath: tokens[1], epochs: epochs) { message in
+                self.engineOutput("info string \(message)")
+            }
+            
+        case "bitbases":
+            // bitbases bitbases.bin KPK KRK KQK KBNK
+            guard tokens.count >= 2 else {
+                engineOutput("Usage: bitbases <file> <signature>...")
+                return
+            }
+            let path = tokens.removeFirst()
+            if !engine.generateBitbases(tokens, path: path, progress: { message in
+                self.engineOutput("info string \(message)")
+            }) {
+                engineOutput("info string cannot generate bitbases \(tokens.joined(separator: " "))")
+            }
+            
         default:
             engineOutput("Unknown command \(cmd)")
         }
@@ -148,6 +265,24 @@ class UCI {
             print(info.uciInfoMessage)
         }
     }
+    
+    // Measure the time it takes to reach each depth between minDepth and maxDepth,
+    // with and without ProbCut, in order to compare the time-to-depth.
+    func performanceProbCut(minDepth: Int = 10, maxDepth: Int = 14) {
+        engine.async = false
+        engine.useOpeningBook = false
+        for probCut in [false, true] {
+            engine.probCut = probCut
+            engine.setFEN("1rbq1rk1/p1b1nppp/1p2p3/8/1B1pN3/P2B4/1P3PPP/2RQ1R1K w - - 0 1")
+            let start = Date()
+            engine.evaluate(maxDepth) { (info, completed) in
+                if !completed && info.depth >= minDepth {
+                    let elapsed = Date().timeIntervalSince(start)
+                    print("probcut \(probCut) depth \(info.depth) time \(String(format: "%.3f", elapsed))s nodes \(info.nodeEvaluated)")
+                }
+            }
+        }
+    }
 
     
     func run() {
@@ -175,6 +310,17 @@ class UCI {
             
             write("id name BChess")
             write("id author Jean Bovet")
+            write("option name MultiPV type spin default 1 min 1 max 256")
+            write("option name Threads type spin default 1 min 1 max 64")
+            write("option name Hash type spin default 275 min 1 max 65536")
+            write("option name Ponder type check default false")
+            write("option name EvalFile type string default <empty>")
+            write("option name UseNNUE type check default false")
+            write("option name EvalWeights type string default <empty>")
+            write("option name SyzygyPath type string default <empty>")
+            write("option name UseSyzygy type check default false")
+            write("option name SyzygyProbeDepth type spin default 1 min 1 max 100")
+            write("option name BitbasesFile type string default <empty>")
             write("uciok")
             
             while let line = read() {
@@ -13,6 +13,7 @@ import Foundation
 
 let uci = UCI()
 //uci.performance()
+//uci.performanceProbCut()
 uci.run()
 
 
@@ -0,0 +1,163 @@
+//
+//  BitbasesTests.cpp
+//  BChessTests
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+
+#include "ChessEngine.hpp"
+#include "Bitbases.hpp"
+#include "FFEN.hpp"
+
+#include <stdio.h>
+
+class BitbasesTests: public ::testing::Test {
+public:
+    std::string path = std::string(P_tmpdir) + "/bchess-bitbases.bin";
+
+    void SetUp() {
+        ChessEngine::initialize();
+    }
+
+    void TearDown() {
+        remove(path.c_str());
+    }
+
+    static int probe(Bitbases &bitbases, std::string fen) {
+        ChessBoard board;
+        assert(FFEN::setFEN(fen, board));
+        int outcome = INT_MAX;
+        EXPECT_TRUE(bitbases.probe(board, outcome)) << fen;
+        return outcome;
+    }
+};
+
+TEST_F(BitbasesTests, Signatures) {
+    ASSERT_TRUE(Bitbases::isValidSignature("KPK"));
+    ASSERT_TRUE(Bitbases::isValidSignature("KBNK"));
+    ASSERT_TRUE(Bitbases::isValidSignature("KNBK"));
+    ASSERT_FALSE(Bitbases::isValidSignature("KK"));
+    ASSERT_FALSE(Bitbases::isValidSignature("KRPPK"));
+    ASSERT_FALSE(Bitbases::isValidSignature("KRKP"));
+    ASSERT_FALSE(Bitbases::isValidSignature("KXK"));
+
+    Bitbases bitbases;
+    ASSERT_FALSE(bitbases.generate({ "KQK", "KRKP" }));
+}
+
+TEST_F(BitbasesTests, GenerateKQK) {
+    Bitbases bitbases;
+    bitbases.threads = 4;
+    size_t positions = 0;
+    size_t wins = 0;
+    ASSERT_TRUE(bitbases.generate({ "KQK" }, [&](std::string signature, size_t p, size_t w, double milliseconds) {
+        ASSERT_EQ("KQK", signature);
+        positions = p;
+        wins = w;
+    }));
+    ASSERT_EQ(std::vector<std::string>({ "KQK" }), bitbases.signatures());
+
+    // All the positions with white to move are won, which is about half of them
+    ASSERT_GT(wins, positions / 2);
+    ASSERT_LT(wins, positions);
+
+    ASSERT_EQ(1, probe(bitbases, "8/8/8/3k4/8/8/8/KQ6 w - - 0 1"));
+    ASSERT_EQ(1, probe(bitbases, "8/8/8/3k4/8/8/8/KQ6 b - - 0 1"));
+
+    // Stalemate and capture of the queen
+    ASSERT_EQ(0, probe(bitbases, "k7/2Q5/1K6/8/8/8/8/8 b - - 0 1"));
+    ASSERT_EQ(0, probe(bitbases, "8/8/8/8/8/8/1Q6/k6K b - - 0 1"));
+
+    // Same positions with the colors swapped
+    ASSERT_EQ(-1, probe(bitbases, "kq6/8/8/8/3K4/8/8/8 w - - 0 1"));
+    ASSERT_EQ(0, probe(bitbases, "8/8/8/8/8/1k6/2q5/K7 w - - 0 1"));
+
+    // Not in the bitbases
+    ChessBoard board;
+    int outcome;
+    ASSERT_TRUE(FFEN::setFEN("8/8/8/3k4/8/8/8/KR6 w - - 0 1", board));
+    ASSERT_FALSE(bitbases.probe(board, outcome));
+    ASSERT_TRUE(FFEN::setFEN("8/8/8/3k4/8/8/8/KQ5q w - - 0 1", board));
+    ASSERT_FALSE(bitbases.probe(board, outcome));
+}
+
+TEST_F(BitbasesTests, GenerateKPK) {
+    Bitbases bitbases;
+    std::vector<std::string> generated;
+    ASSERT_TRUE(bitbases.generate({ "KPK" }, [&](std::string signature, size_t positions, size_t wins, double milliseconds) {
+        generated.push_back(signature);
+    }));
+
+    // The promotions reach these bitbases, which are generated first
+    ASSERT_EQ(std::vector<std::string>({ "KQK", "KRK", "KPK" }), generated);
+
+    // The king in front of its pawn on the 6th rank wins, whoever is to move
+    ASSERT_EQ(1, probe(bitbases, "4k3/8/4K3/4P3/8/8/8/8 w - - 0 1"));
+    ASSERT_EQ(1, probe(bitbases, "4k3/8/4K3/4P3/8/8/8/8 b - - 0 1"));
+
+    // The rule of the square: only a draw when black can enter the square of the pawn
+    ASSERT_EQ(1, probe(bitbases, "8/8/8/8/P4k2/8/8/7K w - - 0 1"));
+    ASSERT_EQ(0, probe(bitbases, "8/8/8/8/P4k2/8/8/7K b - - 0 1"));
+
+    // The rook pawn cannot win against the king in the corner
+    ASSERT_EQ(0, probe(bitbases, "k7/8/1K6/P7/8/8/8/8 w - - 0 1"));
+    ASSERT_EQ(0, probe(bitbases, "8/8/8/8/8/k7/P7/K7 w - - 0 1"));
+
+    // The pawn runs faster than the king (mirrored horizontally and with the colors swapped)
+    ASSERT_EQ(1, probe(bitbases, "7k/8/8/8/8/8/P7/K7 w - - 0 1"));
+    ASSERT_EQ(1, probe(bitbases, "k7/8/8/8/8/8/7P/7K w - - 0 1"));
+    ASSERT_EQ(-1, probe(bitbases, "k7/p7/8/8/8/8/8/7K b - - 0 1"));
+
+    // The king catches the pawn
+    ASSERT_EQ(0, probe(bitbases, "8/8/8/8/8/2k5/P7/7K w - - 0 1"));
+}
+
+TEST_F(BitbasesTests, SaveAndLoad) {
+    Bitbases bitbases;
+    ASSERT_TRUE(bitbases.generate({ "KRK" }));
+    ASSERT_TRUE(bitbases.save(path));
+
+    Bitbases loaded;
+    int version = loaded.getVersion();
+    ASSERT_FALSE(loaded.load(path + ".missing"));
+    ASSERT_TRUE(loaded.load(path));
+    ASSERT_NE(version, loaded.getVersion());
+    ASSERT_EQ(std::vector<std::string>({ "KRK" }), loaded.signatures());
+
+    for (auto fen : { "8/8/8/3k4/8/8/8/KR6 w - - 0 1", "8/8/8/8/8/8/1R6/k6K b - - 0 1", "8/8/8/8/8/8/kR6/K7 b - - 0 1" }) {
+        ASSERT_EQ(probe(bitbases, fen), probe(loaded, fen)) << fen;
+    }
+
+    // An invalid file leaves the bitbases unchanged
+    FILE *file = fopen(path.c_str(), "wb");
+    fputs("Not a bitbase", file);
+    fclose(file);
+    ASSERT_FALSE(loaded.load(path));
+    ASSERT_EQ(std::vector<std::string>({ "KRK" }), loaded.signatures());
+
+    loaded.clear();
+    ASSERT_TRUE(loaded.signatures().empty());
+}
+
+TEST_F(BitbasesTests, Evaluation) {
+    auto &bitbases = ChessEvaluater::bitbases;
+    ASSERT_TRUE(bitbases.generate({ "KPK" }));
+    int winValue = ChessEvaluater::BITBASE_WIN_VALUE;
+
+    // Exactly a draw, whatever the material
+    ChessBoard board;
+    ASSERT_TRUE(FFEN::setFEN("k7/8/1K6/P7/8/8/8/8 w - - 0 1", board));
+    ASSERT_EQ(0, ChessEvaluater::evaluate(board, NEW_HISTORY));
+
+    ASSERT_TRUE(FFEN::setFEN("8/8/8/8/P4k2/8/8/7K w - - 0 1", board));
+    ASSERT_GT(ChessEvaluater::evaluate(board, NEW_HISTORY), winValue);
+
+    ASSERT_TRUE(FFEN::setFEN("8/8/8/8/4p3/4k3/8/4K3 w - - 0 1", board));
+    ASSERT_LT(ChessEvaluater::evaluate(board, NEW_HISTORY), -winValue);
+
+    bitbases.clear();
+    ASSERT_TRUE(FFEN::setFEN("k7/8/1K6/P7/8/8/8/8 w - - 0 1", board));
+    ASSERT_NE(0, ChessEvaluater::evaluate(board, NEW_HISTORY));
+}
@@ -16,8 +16,6 @@
 #include "FPGN.hpp"
 
 TEST(BoardHash, MakeAndUndoMove) {
-    ChessBoardHash::initialize();
-    
     ChessBoard board;
     
     auto h1 = board.getHash();
@@ -38,8 +36,6 @@ TEST(BoardHash, MakeAndUndoMove) {
 }
 
 TEST(BoardHash, EnsureNoCollision) {
-    ChessBoardHash::initialize();
-
     ChessBoard boardA, boardB;
     
     FFEN::setFEN("rnbqkb1r/pppppppp/8/8/6P1/5N2/PPPP1n1P/RNBQKB1R w", boardA);
@@ -70,3 +66,25 @@ TEST(BoardHash, PlayAndTestForCollision) {
     // Finally, each hash should be different because the board is different!
     ASSERT_NE(gameA.board.getHash(), gameB.board.getHash());
 }
+
+TEST(BoardHash, PawnHash) {
+    ChessGame game;
+    ASSERT_EQ(game.board.getPawnHash(), ChessBoardHash::pawnHash(game.board));
+    
+    // The pawn key only changes when a pawn moves, is captured (including en-passant) or promotes
+    ASSERT_TRUE(FPGN::setGame("1.e4 d5 2.e5 f5 3.exf6 Nc6 4.fxg7 Nf6", game));
+    ASSERT_EQ(game.board.getPawnHash(), ChessBoardHash::pawnHash(game.board));
+    auto pawnHash = game.board.getPawnHash();
+    ASSERT_TRUE(FPGN::setGame("1.e4 d5 2.e5 f5 3.exf6 Nc6 4.fxg7 Nf6 5.gxh8=Q *", game));
+    ASSERT_EQ(game.board.getPawnHash(), ChessBoardHash::pawnHash(game.board));
+    ASSERT_NE(pawnHash, game.board.getPawnHash());
+    
+    // Same pawns, different pieces
+    ChessBoard boardA, boardB;
+    ASSERT_TRUE(FFEN::setFEN("4k3/pp6/8/8/8/8/PP6/4K3 w - - 0 1", boardA));
+    ASSERT_TRUE(FFEN::setFEN("3k4/pp6/8/8/8/8/PP6/3K4 w - - 0 1", boardB));
+    ASSERT_EQ(boardA.getPawnHash(), boardB.getPawnHash());
+    
+    boardA.clear();
+    ASSERT_EQ(0, boardA.getPawnHash());
+}
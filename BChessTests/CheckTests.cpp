@@ -79,3 +79,34 @@ TEST_F(CheckTests, BlackKingCheck) {
     ASSERT_FALSE(board.isCheck(Color::WHITE));
     ASSERT_TRUE(board.isCheck(Color::BLACK));
 }
+
+TEST_F(CheckTests, AttackInfoCheckersAndPinned) {
+    ChessBoard board;
+    ASSERT_TRUE(FFEN::setFEN("4k3/8/8/8/1b6/8/3N4/r3K2R w K - 0 1", board));
+    
+    AttackInfo info(board);
+    ASSERT_TRUE(info.isCheck(WHITE));
+    ASSERT_FALSE(info.isCheck(BLACK));
+    ASSERT_EQ(1UL << a1, info.checkers(WHITE));
+    ASSERT_EQ(1UL << d2, info.pinned(WHITE));
+    ASSERT_EQ(0, info.pinned(BLACK));
+    
+    // The pinned knight cannot block the check and the king cannot castle
+    // or move along the line of the rook, even on the square behind itself.
+    auto moves = ChessMoveGenerator::generateMoves(info);
+    ASSERT_EQ("Ke1e2 Ke1f2", moves.description());
+}
+
+TEST_F(CheckTests, AttackInfoAttacks) {
+    ChessBoard board;
+    AttackInfo info(board);
+    
+    ASSERT_EQ(0xFF0000UL, info.attacksBy(WHITE, PAWN));
+    ASSERT_EQ(1UL << a3 | 1UL << c3 | 1UL << d2 | 1UL << e2 | 1UL << f3 | 1UL << h3, info.attacksBy(WHITE, KNIGHT));
+    ASSERT_EQ(0xFFFF7EUL, info.attacksBy(WHITE));
+    ASSERT_EQ(0x7EFFFFUL << 40, info.attacksBy(BLACK));
+    
+    ASSERT_TRUE(info.isAttacked(e3, WHITE));
+    ASSERT_FALSE(info.isAttacked(e4, WHITE));
+    ASSERT_TRUE(info.isAttacked(e6, BLACK));
+}
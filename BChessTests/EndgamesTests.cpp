@@ -0,0 +1,132 @@
+//
+//  EndgamesTests.cpp
+//  BChessTests
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+
+#include "ChessEngine.hpp"
+#include "Endgames.hpp"
+#include "FFEN.hpp"
+#include "FPGN.hpp"
+
+class EndgamesTests: public ::testing::Test {
+public:
+    void SetUp() {
+        ChessEngine::initialize();
+    }
+
+    ChessBoard boardFor(std::string fen) {
+        ChessBoard board;
+        assert(FFEN::setFEN(fen, board));
+        return board;
+    }
+
+    int evaluate(std::string fen) {
+        return ChessEvaluater::evaluate(boardFor(fen), NEW_HISTORY);
+    }
+};
+
+TEST_F(EndgamesTests, MaterialKey) {
+    ChessGame game;
+    ASSERT_EQ(Endgames::materialKey("KQRRBBNNPPPPPPPPKQRRBBNNPPPPPPPP"), game.board.getMaterialKey());
+
+    // Captures, including an en-passant, and a promotion to a queen
+    ASSERT_TRUE(FPGN::setGame("1.e4 d5 2.e5 f5 3.exf6 Nc6 4.fxg7 Nf6 5.gxh8=Q *", game));
+    ASSERT_EQ(boardFor(FFEN::getFEN(game.board)).getMaterialKey(), game.board.getMaterialKey());
+    ASSERT_EQ(2, (int)MATERIAL_COUNT(game.board.getMaterialKey(), WHITE, QUEEN));
+    ASSERT_EQ(1, (int)MATERIAL_COUNT(game.board.getMaterialKey(), BLACK, ROOK));
+    ASSERT_EQ(6, (int)MATERIAL_COUNT(game.board.getMaterialKey(), BLACK, PAWN));
+
+    // The order of the pieces doesn't matter, only their color
+    ASSERT_EQ(Endgames::materialKey("KBNK"), boardFor("8/8/8/3k4/8/8/8/KBN5 w - - 0 1").getMaterialKey());
+    ASSERT_EQ(Endgames::materialKey("KNBK"), Endgames::materialKey("KBNK"));
+    ASSERT_NE(Endgames::materialKey("KKBN"), Endgames::materialKey("KBNK"));
+
+    ASSERT_EQ(0, Endgames::materialKey("KBN"));
+    ASSERT_EQ(0, Endgames::materialKey("BKNK"));
+    ASSERT_EQ(0, Endgames::materialKey("KXK"));
+}
+
+TEST_F(EndgamesTests, KnownDraws) {
+    for (auto fen : { "8/8/8/3k4/8/8/8/KN6 w - - 0 1", "8/8/8/3k4/8/8/8/KNN5 w - - 0 1", "8/8/3b4/3k4/8/8/8/KB6 b - - 0 1" }) {
+        ASSERT_TRUE(Endgames::isDraw(boardFor(fen))) << fen;
+        ASSERT_EQ(0, evaluate(fen)) << fen;
+    }
+
+    ASSERT_FALSE(Endgames::isDraw(boardFor("8/8/8/3k4/8/8/P7/K7 w - - 0 1")));
+    ASSERT_FALSE(Endgames::isDraw(boardFor("8/8/8/3k4/8/8/8/KBN5 w - - 0 1")));
+    ASSERT_EQ(nullptr, Endgames::probe(boardFor("8/8/8/3k4/8/8/P7/K7 w - - 0 1").getMaterialKey()));
+
+    // The search doesn't need to explore these positions
+    ChessMinMaxSearch search;
+    search.config.maxDepth = 4;
+    TranspositionTable table;
+    ChessMinMaxSearch::Variation pv;
+    ChessMinMaxSearch::Variation bv;
+    auto board = boardFor("8/8/8/3k4/8/8/8/KNN5 w - - 0 1");
+    ASSERT_EQ(0, search.alphabeta(board, NEW_HISTORY, table, 0, true, pv, bv));
+    ASSERT_LT(search.visitedNodes, 100);
+    
+    // But a mate is still found when the other side helped it (Ne5-g6 mate)
+    int matValue = ChessEvaluater::MAT_VALUE;
+    for (auto fen : { "7k/5K2/5N2/4N3/8/8/8/8 w - - 0 1", "6bk/8/7K/4N3/8/8/8/8 w - - 0 1" }) {
+        ASSERT_TRUE(Endgames::isDraw(boardFor(fen))) << fen;
+        ChessMinMaxSearch mateSearch;
+        mateSearch.config.maxDepth = 2;
+        TranspositionTable mateTable;
+        ChessMinMaxSearch::Variation matePV;
+        ASSERT_EQ(matValue, mateSearch.alphabeta(boardFor(fen), NEW_HISTORY, mateTable, 0, true, matePV, bv)) << fen;
+        ASSERT_EQ("Ne5g6", matePV.moves.decode(boardFor(fen)).description()) << fen;
+    }
+}
+
+TEST_F(EndgamesTests, KBNK) {
+    int knownWinValue = ChessEvaluater::KNOWN_WIN_VALUE;
+
+    // The king must be driven to a corner of the color of the bishop
+    auto rightCorner = evaluate("k7/8/2K5/8/8/8/8/3BN3 w - - 0 1");
+    auto wrongCorner = evaluate("7k/8/5K2/8/8/8/8/3BN3 w - - 0 1");
+    auto center = evaluate("8/8/8/3k4/8/8/8/K2BN3 w - - 0 1");
+    ASSERT_GT(center, knownWinValue);
+    ASSERT_GT(rightCorner, center);
+    ASSERT_GT(rightCorner, wrongCorner);
+
+    // Same positions with the colors swapped
+    ASSERT_EQ(-rightCorner, evaluate("3bn3/8/8/8/8/2k5/8/K7 b - - 0 1"));
+    ASSERT_EQ(-wrongCorner, evaluate("3bn3/8/8/8/8/5k2/8/7K b - - 0 1"));
+}
+
+TEST_F(EndgamesTests, KRKP) {
+    int rookValue = ChessEvaluater::getWeights().pieceValue[ChessEvaluater::ENDGAME][ROOK];
+
+    // The king in front of the pawn wins
+    ASSERT_EQ(rookValue - 2, evaluate("8/8/8/8/8/3p3k/3K4/R7 w - - 0 1"));
+
+    // The pawn without the support of its king is lost, even with the other king outside of its square
+    ASSERT_EQ(rookValue - 4, evaluate("k7/8/8/8/8/8/2p5/K6R w - - 0 1"));
+
+    // The pawn about to promote with its king, the other king being too far, is a draw
+    auto draw = evaluate("7K/8/8/8/8/8/1kp5/7R w - - 0 1");
+    ASSERT_GT(draw, 0);
+    ASSERT_LT(draw, rookValue / 4);
+
+    // Same positions with the colors swapped
+    ASSERT_EQ(-(rookValue - 2), evaluate("r7/3k4/3P3K/8/8/8/8/8 b - - 0 1"));
+    ASSERT_EQ(-(rookValue - 4), evaluate("k6r/2P5/8/8/8/8/8/K7 b - - 0 1"));
+    ASSERT_EQ(-draw, evaluate("7r/1KP5/8/8/8/8/8/7k b - - 0 1"));
+}
+
+TEST_F(EndgamesTests, OppositeBishops) {
+    // Two pawns more but opposite-colored bishops: the evaluation is halved
+    auto board = boardFor("8/4k3/4b3/8/3P4/3KB3/5P2/8 w - - 0 1");
+    AttackInfo info(board);
+    ASSERT_EQ(ChessEvaluater::evaluatePosition(info) / 2, ChessEvaluater::evaluate(board, NEW_HISTORY));
+
+    // The bishops of the same color don't change the evaluation
+    board = boardFor("8/4k3/4b3/8/3P4/3K1B2/5P2/8 w - - 0 1");
+    AttackInfo sameColorInfo(board);
+    ASSERT_EQ(ChessEvaluater::evaluatePosition(sameColorInfo), ChessEvaluater::evaluate(board, NEW_HISTORY));
+}
@@ -33,6 +33,37 @@ public:
 
         return moveList;
     }
+    
+    // Mobility computed from the legal moves of each color, as it was before the attack bitboards:
+    // each move or capture counts one point and castling counts double.
+    // Note: the moves of each color are generated with that color to move, otherwise
+    // the legality of the moves of the other color is checked against the wrong attacks.
+    int moveListMobility(ChessBoard board) {
+        int mobility = 0;
+        for (unsigned color=0; color<COUNT; color++) {
+            auto colorSign = (color == WHITE) ? 1 : -1;
+            ChessBoard colorBoard = board;
+            if (colorBoard.color != (Color)color) {
+                colorBoard.color = (Color)color;
+                colorBoard.enPassantSquare = 0;
+            }
+            auto moveList = ChessMoveGenerator::generateMoves(colorBoard, (Color)color, ChessMoveGenerator::Mode::moveCaptureAndDefenseMoves);
+            for (int index=0; index<moveList.count; index++) {
+                auto move = moveList[index];
+                if (MOVE_IS_CAPTURE(move)) {
+                    if (MOVE_CAPTURED_PIECE_COLOR(move) != (Color)color) {
+                        mobility += colorSign;
+                    }
+                } else {
+                    mobility += colorSign;
+                    if (MOVE_IS_CASTLING(move)) {
+                        mobility += colorSign;
+                    }
+                }
+            }
+        }
+        return mobility;
+    }
 };
 
 TEST_F(EvaluationTests, BonusPosition) {
@@ -46,6 +77,36 @@ TEST_F(EvaluationTests, BonusPosition) {
     ASSERT_EQ(ChessEvaluater::getBonus(KNIGHT, Color::WHITE, e7), 0);
 }
 
+TEST_F(EvaluationTests, EndgameBonusPosition) {
+    // The king stays in its shelter in the middlegame but goes to the center in the endgame
+    ASSERT_EQ(ChessEvaluater::getBonus(KING, Color::WHITE, g1), 30);
+    ASSERT_EQ(ChessEvaluater::getBonus(KING, Color::WHITE, g1, ChessEvaluater::ENDGAME), -30);
+    ASSERT_EQ(ChessEvaluater::getBonus(KING, Color::BLACK, e5, ChessEvaluater::ENDGAME), 40);
+    
+    ASSERT_EQ(ChessEvaluater::getBonus(PAWN, Color::WHITE, d4, ChessEvaluater::ENDGAME), 15);
+    ASSERT_EQ(ChessEvaluater::getBonus(PAWN, Color::BLACK, d2, ChessEvaluater::ENDGAME), 80);
+}
+
+TEST_F(EvaluationTests, GamePhase) {
+    ChessGame game;
+    ASSERT_EQ(TotalPhase, game.board.phase);
+    
+    // A rook is captured and a pawn promotes to a queen
+    ASSERT_TRUE(FPGN::setGame("1.e4 d5 2.e5 f5 3.exf6 Nc6 4.fxg7 Nf6 5.gxh8=Q *", game));
+    ASSERT_EQ(TotalPhase - 2 + 4, game.board.phase);
+    ASSERT_EQ(boardFor(FFEN::getFEN(game.board)).phase, game.board.phase);
+    
+    ASSERT_EQ(0, boardFor("8/5k2/8/8/8/8/1P6/1K6 w - - 0 1").phase);
+    ASSERT_EQ(1 + 2, boardFor("8/5k2/8/8/8/8/1P6/1KNR4 w - - 0 1").phase);
+}
+
+TEST_F(EvaluationTests, TaperedEvaluation) {
+    // Only pawns and kings: the evaluation is the one of the endgame, where
+    // the king in the center is better than the king in the corner.
+    auto value = ChessEvaluater::evaluate(boardFor("8/8/8/3k4/8/8/1P6/K7 w - - 0 1"), NEW_HISTORY);
+    ASSERT_EQ(120 + 0 + (-50) - 40, value); // pawn, pawn on b2, king on a1, king on d5
+}
+
 TEST_F(EvaluationTests, InvalidMove) {
     MoveList moveList;
     ASSERT_EQ(INVALID_MOVE, moveList.bestMove());
@@ -86,3 +147,89 @@ TEST_F(EvaluationTests, HangingWhitePiece) {
     int value = ChessEvaluater::evaluateAction(board);
     ASSERT_EQ(-12, value);
 }
+
+TEST_F(EvaluationTests, StartPositionMobility) {
+    ChessBoard board;
+    int value = ChessEvaluater::evaluateMobility(board);
+    ASSERT_EQ(0, value); // 20 moves for each side
+}
+
+TEST_F(EvaluationTests, PromotionMobility) {
+    auto board = boardFor("1n6/P7/8/8/8/8/8/8 w - - 0 1");
+    int value = ChessEvaluater::evaluateMobility(board);
+    ASSERT_EQ(8 - 3, value); // 2 moves promoting to 4 pieces for white, 3 moves for the knight
+}
+
+TEST_F(EvaluationTests, MobilityMatchesMoveList) {
+    std::vector<std::string> fens = {
+        StartFEN,
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3",
+        "r1bqk2r/pppp1ppp/2n2n2/2b1p3/2B1P3/5N2/PPPP1PPP/RNBQ1RK1 w kq - 6 5",
+        "rnbqkbnr/ppp2ppp/8/3pp3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq d6 0 3",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "4k3/8/8/8/8/8/4P3/4K3 w - - 0 1",
+        "8/P7/8/8/8/8/7p/K6k w - - 0 1",
+        "2r3k1/5ppp/8/8/8/8/5PPP/2R3K1 b - - 0 1",
+        "r3k2r/8/8/8/8/8/8/R3K2R b KQkq - 0 1",
+    };
+    for (auto fen : fens) {
+        auto board = boardFor(fen);
+        ASSERT_EQ(moveListMobility(board), ChessEvaluater::evaluateMobility(board)) << fen;
+    }
+}
+
+TEST_F(EvaluationTests, MobilityOfPinnedPieces) {
+    // The attack bitboards count the pseudo-legal moves where the move list only has the legal
+    // ones, so the moves of a pinned piece are counted too: up to ten points for a pinned knight,
+    // bishop or rook. Note: the positions in check are not compared because all the pseudo-legal
+    // moves count instead of the evasions only (the search never stands pat when in check).
+    const int tolerance = 10;
+    std::vector<std::string> fens = {
+        "1k6/8/8/8/3q4/8/3R4/3K4 w - - 0 1",
+        "4k3/8/8/1b6/8/3N4/8/5K2 w - - 0 1",
+        "4r1k1/8/8/8/8/8/4B3/4K3 w - - 0 1",
+        "r1bqkbnr/ppp2ppp/2np4/1B2p3/4P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 0 4",
+    };
+    for (auto fen : fens) {
+        auto board = boardFor(fen);
+        ASSERT_NEAR(moveListMobility(board), ChessEvaluater::evaluateMobility(board), tolerance) << fen;
+    }
+}
+
+TEST_F(EvaluationTests, PawnStructure) {
+    // White: doubled and isolated pawns on the c-file. Black: a passed pawn on a3 (6th rank for black)
+    auto board = boardFor("4k3/8/8/8/2P5/p1P5/8/4K3 w - - 0 1");
+    auto entry = ChessEvaluater::evaluatePawns(board);
+    ASSERT_EQ(1UL << a3, entry.passed[BLACK]);
+    ASSERT_EQ(1UL << c4, entry.passed[WHITE]); // c3 is behind c4
+    // White: 1 doubled, 2 isolated pawns and c4 passed. Black: isolated passed pawn
+    ASSERT_EQ(-10 - 2*10 + 20 - (60 - 10), entry.score);
+    
+    // Backward pawn on d3: d4 is attacked by the pawn on e5 and cannot be defended by c4.
+    // The pawn on e5 is isolated, backward as well (e4 is attacked by d3) and not passed.
+    board = boardFor("4k3/8/8/4p3/2P5/3P4/8/4K3 w - - 0 1");
+    entry = ChessEvaluater::evaluatePawns(board);
+    ASSERT_EQ(1UL << c4, entry.passed[WHITE]);
+    ASSERT_EQ(0, entry.passed[BLACK]);
+    ASSERT_EQ(20 - 8 - (-10 - 8), entry.score);
+}
+
+TEST_F(EvaluationTests, PawnHashTable) {
+    auto board = boardFor("4k3/8/8/4p3/2P5/3P4/8/4K3 w - - 0 1");
+    ChessEvaluater::pawnTable().clear();
+    
+    auto entry = ChessEvaluater::evaluatePawns(board);
+    ASSERT_EQ(1, ChessEvaluater::pawnTable().probeCount);
+    ASSERT_EQ(0, ChessEvaluater::pawnTable().hitCount);
+    
+    // Moving the king doesn't change the pawn structure
+    board.move(createMove(e1, e2, WHITE, KING));
+    auto cached = ChessEvaluater::evaluatePawns(board);
+    ASSERT_EQ(2, ChessEvaluater::pawnTable().probeCount);
+    ASSERT_EQ(1, ChessEvaluater::pawnTable().hitCount);
+    ASSERT_EQ(50, ChessEvaluater::pawnTable().hitRate());
+    ASSERT_EQ(entry.score, cached.score);
+    ASSERT_EQ(entry.attackSpans[WHITE], cached.attackSpans[WHITE]);
+}
@@ -54,17 +54,27 @@ static NSString * const GeneratedClassPrefix = @"";
 static NSDictionary *GoogleTestFilterMap;
 
 /**
- * A Google Test listener that reports failures to XCTest.
+ * A Google Test listener that reports failures to XCTest and remembers
+ * the message of a test skipped with GTEST_SKIP().
  */
 class XCTestListener : public testing::EmptyTestEventListener {
 public:
     XCTestListener(XCTestCase *testCase) :
         _testCase(testCase) {}
 
+    NSString *skipMessage() const {
+        return _skipMessage;
+    }
+
     void OnTestPartResult(const TestPartResult& test_part_result) {
         if (test_part_result.passed())
             return;
 
+        if (test_part_result.skipped()) {
+            _skipMessage = @(test_part_result.message());
+            return;
+        }
+
         int lineNumber = test_part_result.line_number();
         const char *fileName = test_part_result.file_name();
         NSString *path = fileName ? [@(fileName) stringByStandardizingPath] : nil;
@@ -82,6 +92,7 @@ public:
 
 private:
     XCTestCase *_testCase;
+    NSString *_skipMessage = nil;
 };
 
 /**
@@ -159,10 +170,15 @@ static void RunTest(id self, SEL _cmd) {
 
     (void)RUN_ALL_TESTS();
 
+    NSString *skipMessage = listener->skipMessage();
     delete googleTest->listeners().Release(listener);
 
-    int totalTestsRun = googleTest->successful_test_count() + googleTest->failed_test_count();
+    int totalTestsRun = googleTest->successful_test_count() + googleTest->failed_test_count() + googleTest->skipped_test_count();
     XCTAssertEqual(totalTestsRun, 1, @"Expected to run a single test for filter \"%@\"", testFilter);
+
+    if (googleTest->skipped_test_count() > 0) {
+        XCTSkip(@"%@", skipMessage ?: @"Skipped");
+    }
 }
 
 @implementation GoogleTestLoader
@@ -93,3 +93,16 @@ TEST(Move, MoveSetPromotion) {
     SET_MOVE_PROMOTION_PIECE(m, KNIGHT);
     ASSERT_EQ(MOVE_PROMOTION_PIECE(m), KNIGHT);
 }
+
+TEST(Move, CompactMove) {
+    Move m = createPromotion(e7, f8, WHITE, PAWN, KNIGHT);
+    auto compact = COMPACT_MOVE(m);
+    ASSERT_EQ(COMPACT_MOVE_FROM(compact), e7);
+    ASSERT_EQ(COMPACT_MOVE_TO(compact), f8);
+    ASSERT_EQ(COMPACT_MOVE_FLAG(compact), COMPACT_PROMOTION);
+    ASSERT_EQ(COMPACT_MOVE_PROMOTION_PIECE(compact), KNIGHT);
+    
+    ASSERT_EQ(COMPACT_MOVE_FLAG(COMPACT_MOVE(createEnPassant(e5, d6, WHITE, PAWN))), COMPACT_ENPASSANT);
+    ASSERT_EQ(COMPACT_MOVE_FLAG(COMPACT_MOVE(createCastling(e1, g1, WHITE, KING))), COMPACT_CASTLING);
+    ASSERT_EQ(COMPACT_MOVE_FLAG(COMPACT_MOVE(createCapture(e1, g1, WHITE, ROOK, BLACK, QUEEN))), COMPACT_NORMAL);
+}
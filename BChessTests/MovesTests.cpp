@@ -10,6 +10,7 @@
 
 #include "ChessEngine.hpp"
 #include "FFEN.hpp"
+#include "FPGN.hpp"
 
 class MovesTests: public ::testing::Test {
 public:
@@ -276,3 +277,187 @@ TEST_F(MovesTests, BlackPawnPromotionByCapture) {
         "4k3/8/8/8/8/8/8/6Kn w - - 0 2",
     }, "g2");
 }
+
+static void assertMailbox(ChessBoard &board) {
+    for (Square square=0; square<64; square++) {
+        SquareContent expected = EMPTY_SQUARE;
+        for (unsigned color=0; color<COUNT; color++) {
+            for (unsigned piece=0; piece<PCOUNT; piece++) {
+                if (bb_test(board.pieces[color][piece], square)) {
+                    expected = SQUARE_CONTENT(Color(color), Piece(piece));
+                }
+            }
+        }
+        ASSERT_EQ(expected, board.mailbox[square]) << SquareNames[square];
+    }
+    
+    // The occupancy is also updated incrementally
+    for (unsigned color=0; color<COUNT; color++) {
+        Bitboard occupancy = 0;
+        for (unsigned piece=0; piece<PCOUNT; piece++) {
+            occupancy |= board.pieces[color][piece];
+        }
+        ASSERT_EQ(occupancy, board.allPieces(Color(color)));
+    }
+    ASSERT_EQ(board.allPieces(WHITE) | board.allPieces(BLACK), board.getOccupancy());
+}
+
+TEST_F(MovesTests, MailboxFollowsMoves) {
+    // Play every move (including castling, en-passant and promotions) of a few positions
+    // and make sure the mailbox and the occupancy always match the bitboards.
+    std::vector<std::string> fens = {
+        StartFEN,
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/8/8/3pP3/8/8/8/4K2k w - d6 0 1",
+        "4k3/8/8/8/8/8/6p1/6KQ b - - 0 1"
+    };
+    for (auto fen : fens) {
+        ChessBoard board;
+        FFEN::setFEN(fen, board);
+        assertMailbox(board);
+        
+        ChessMoveGenerator generator;
+        auto moves = generator.generateMoves(board);
+        ASSERT_TRUE(moves.count > 0);
+        for (int index=0; index<moves.count; index++) {
+            ChessBoard newBoard = board;
+            newBoard.move(moves.moves[index]);
+            assertMailbox(newBoard);
+        }
+    }
+}
+
+static uint64_t perft(ChessBoard &board, int depth) {
+    ChessMoveGenerator generator;
+    auto moves = generator.generateMoves(board);
+    if (depth == 1) {
+        return moves.count;
+    }
+    uint64_t nodes = 0;
+    for (int index=0; index<moves.count; index++) {
+        ChessBoard newBoard = board;
+        newBoard.move(moves.moves[index]);
+        nodes += perft(newBoard, depth - 1);
+    }
+    return nodes;
+}
+
+TEST_F(MovesTests, Perft) {
+    // https://www.chessprogramming.org/Perft_Results
+    ChessBoard board;
+    FFEN::setFEN(StartFEN, board);
+    ASSERT_EQ(20, perft(board, 1));
+    ASSERT_EQ(400, perft(board, 2));
+    ASSERT_EQ(8902, perft(board, 3));
+    ASSERT_EQ(197281, perft(board, 4));
+    
+    // "Kiwipete" which exercises castling, en-passant and promotions
+    FFEN::setFEN("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", board);
+    ASSERT_EQ(48, perft(board, 1));
+    ASSERT_EQ(2039, perft(board, 2));
+    ASSERT_EQ(97862, perft(board, 3));
+}
+
+TEST_F(MovesTests, CapturesInMVVLVAOrder) {
+    // The queen first, by the pawn then by the knight, then the rook, the en-passant last
+    ChessBoard board;
+    FFEN::setFEN("4k3/8/2r5/3q1pP1/1NP5/8/8/4K3 w - f6 0 1", board);
+    AttackInfo info(board);
+    auto captures = ChessMoveGenerator::generateCaptures(info, board.color);
+    ASSERT_EQ("c4xd5 Nb4xd5 Nb4xc6 g5xf6", captures.description());
+    
+    // The same captures as the quiescence moves of the generation of all the moves
+    auto moves = ChessMoveGenerator::generateMoves(board, board.color, ChessMoveGenerator::Mode::quiescenceMoveOnly);
+    std::set<Move> capturesSet(captures.moves, captures.moves + captures.count);
+    std::set<Move> movesSet(moves.moves, moves.moves + moves.count);
+    ASSERT_EQ(movesSet, capturesSet);
+}
+
+TEST_F(MovesTests, QuietChecks) {
+    // The direct checks of the rook and the pawn, the discovered checks of the knight
+    // leaving the line of the bishop, but not the captures nor the promotions
+    ChessBoard board;
+    FFEN::setFEN("7k/1P1n4/6P1/4N3/8/8/1B6/R5K1 w - - 0 1", board);
+    AttackInfo info(board);
+    auto checks = ChessMoveGenerator::generateQuietChecks(info, board.color);
+    std::set<std::string> moves;
+    for (int index=0; index<checks.count; index++) {
+        moves.insert(FPGN::to_string(checks.moves[index]));
+    }
+    ASSERT_EQ(std::set<std::string>({ "Ra1a8", "g6g7", "Ne5c4", "Ne5c6", "Ne5d3", "Ne5f3", "Ne5f7", "Ne5g4" }), moves);
+}
+
+TEST_F(MovesTests, QuietChecksOfBlockers) {
+    // The pieces between a rook or a bishop and the king (the king, a bishop, a rook, the pawns): the quiet checks
+    // generated are exactly the quiet moves, without the promotions, after which the other side is in check.
+    for (auto fen : { "7k/1P1n4/6P1/4N3/8/8/1B6/R5K1 w - - 0 1", "4k3/8/8/8/8/8/4K3/4R3 w - - 0 1",
+                      "4k3/8/8/4B3/8/8/8/4R1K1 w - - 0 1", "7k/8/5R2/8/3B4/8/8/6K1 w - - 0 1",
+                      "8/8/8/R2P3k/8/8/8/6K1 w - - 0 1", "6k1/8/8/3P4/8/1B6/8/6K1 w - - 0 1" }) {
+        ChessBoard board;
+        FFEN::setFEN(fen, board);
+        AttackInfo info(board);
+        auto checks = ChessMoveGenerator::generateQuietChecks(info, board.color);
+        std::set<Move> generated(checks.moves, checks.moves + checks.count);
+        
+        std::set<Move> expected;
+        auto moves = ChessMoveGenerator::generateMoves(board);
+        for (int index=0; index<moves.count; index++) {
+            auto move = moves.moves[index];
+            if (MOVE_IS_CAPTURE(move) || MOVE_PROMOTION_PIECE(move) || MOVE_IS_CASTLING(move)) {
+                continue;
+            }
+            auto newBoard = board;
+            newBoard.move(move);
+            if (newBoard.isCheck(newBoard.color)) {
+                expected.insert(move);
+            }
+        }
+        ASSERT_FALSE(expected.empty()) << fen;
+        ASSERT_EQ(expected.size(), generated.size()) << fen;
+        for (auto move : expected) {
+            ASSERT_EQ(1, generated.count(move)) << fen << " " << FPGN::to_string(move);
+        }
+    }
+    
+    // A queen between the rook and the king: moving along the line, it gives a direct check. The position
+    // cannot be reached in a game (the queen already gives check) but all the checks must still be found.
+    ChessBoard board;
+    FFEN::setFEN("4k3/8/8/8/4Q3/8/8/4R1K1 w - - 0 1", board);
+    AttackInfo info(board);
+    auto checks = ChessMoveGenerator::generateQuietChecks(info, board.color);
+    std::set<std::string> moves;
+    for (int index=0; index<checks.count; index++) {
+        moves.insert(FPGN::to_string(checks.moves[index]));
+    }
+    for (auto move : { "Qe4e2", "Qe4e3", "Qe4e5", "Qe4e6", "Qe4e7", "Qe4a4", "Qe4b7" }) {
+        ASSERT_EQ(1, moves.count(move)) << move;
+    }
+}
+
+TEST_F(MovesTests, DecodeCompactMoves) {
+    // Every move, including castling, en-passant and promotions, is found again from its compact form
+    for (auto fen : { "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+                      "8/8/8/3pP3/8/8/8/4K2k w - d6 0 1", "4k3/8/8/8/8/8/6p1/5QK1 b - - 0 1" }) {
+        ChessBoard board;
+        FFEN::setFEN(fen, board);
+        auto moves = ChessMoveGenerator::generateMoves(board);
+        ASSERT_TRUE(moves.count > 0);
+        for (int index=0; index<moves.count; index++) {
+            auto move = moves.moves[index];
+            ASSERT_EQ(move, board.decodeMove(COMPACT_MOVE(move))) << fen << " " << FPGN::to_string(move);
+        }
+    }
+    
+    // No piece of the side to move on the origin square or one on the destination square
+    ChessBoard board;
+    FFEN::setFEN(StartFEN, board);
+    ASSERT_EQ(INVALID_MOVE, board.decodeMove(INVALID_COMPACT_MOVE));
+    ASSERT_EQ(INVALID_MOVE, board.decodeMove(COMPACT_MOVE(createMove(e7, e5, BLACK, PAWN))));
+    ASSERT_EQ(INVALID_MOVE, board.decodeMove(COMPACT_MOVE(createMove(e1, e2, WHITE, KING))));
+}
+
+// The leaper tables are computed at compile time
+static_assert(KnightMoves[a1] == ((1ULL << b3) | (1ULL << c2)), "Knight moves from a1");
+static_assert(KingMoves[h8] == ((1ULL << g8) | (1ULL << g7) | (1ULL << h7)), "King moves from h8");
+static_assert(PawnAttacks[WHITE][e4] == ((1ULL << d5) | (1ULL << f5)), "White pawn attacks from e4");
+static_assert(PawnAttacks[BLACK][a5] == (1ULL << b4), "Black pawn attacks from a5");
@@ -0,0 +1,169 @@
+//
+//  NeuralNetworkTests.cpp
+//  BChessTests
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+
+#include "ChessEngine.hpp"
+#include "NeuralNetwork.hpp"
+#include "FFEN.hpp"
+#include "FPGN.hpp"
+
+#include <stdio.h>
+#include <unistd.h>
+
+class NeuralNetworkTests: public ::testing::Test {
+public:
+    NeuralNetwork network;
+
+    void SetUp() {
+        ChessEngine::initialize();
+        network.randomize(2026);
+    }
+
+    ChessBoard boardFor(std::string fen) {
+        ChessBoard board;
+        assert(FFEN::setFEN(fen, board));
+        return board;
+    }
+
+    std::string temporaryPath() {
+        return std::string(P_tmpdir) + "/bchess-network.nnue";
+    }
+
+    // Asserts that the accumulators computed incrementally by the stack, for all the positions reachable
+    // in the specified number of moves, are identical to the ones computed from scratch.
+    void assertIncremental(ChessBoard board, NeuralAccumulatorStack &stack, int depth) {
+        NeuralAccumulator expected;
+        network.refresh(board, WHITE, expected);
+        network.refresh(board, BLACK, expected);
+
+        auto &accumulator = stack.accumulator(network, board);
+        ASSERT_EQ(0, memcmp(expected.values, accumulator.values, sizeof(expected.values))) << FFEN::getFEN(board);
+        ASSERT_EQ(network.evaluate(board), network.evaluate(board, accumulator));
+
+        if (depth == 0) {
+            return;
+        }
+
+        auto moves = ChessMoveGenerator::generateMoves(board);
+        for (int index=0; index<moves.count; index++) {
+            auto move = moves.moves[index];
+            auto newBoard = board;
+            newBoard.move(move);
+
+            stack.push(move);
+            assertIncremental(newBoard, stack, depth - 1);
+            stack.pop();
+        }
+    }
+};
+
+TEST_F(NeuralNetworkTests, SaveAndLoad) {
+    auto path = temporaryPath();
+    ASSERT_TRUE(network.save(path));
+
+    NeuralNetwork loadedNetwork;
+    ASSERT_FALSE(loadedNetwork.isReady());
+    ASSERT_TRUE(loadedNetwork.load(path));
+    ASSERT_TRUE(loadedNetwork.isReady());
+
+    for (auto fen : { StartFEN, "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", "8/2k5/3p4/p2P1p2/P4P2/1K6/8/8 b - - 0 1" }) {
+        auto board = boardFor(fen);
+        ASSERT_EQ(network.evaluate(board), loadedNetwork.evaluate(board));
+    }
+
+    remove(path.c_str());
+}
+
+TEST_F(NeuralNetworkTests, LoadInvalidFile) {
+    auto path = temporaryPath();
+    ASSERT_TRUE(network.save(path));
+
+    // Truncate the file, which must be rejected without changing the network
+    FILE *file = fopen(path.c_str(), "r+b");
+    ASSERT_TRUE(file != nullptr);
+    fseek(file, 0, SEEK_END);
+    auto size = ftell(file);
+    fclose(file);
+    ASSERT_EQ(0, truncate(path.c_str(), size - 1));
+
+    auto board = boardFor(StartFEN);
+    auto value = network.evaluate(board);
+    auto version = network.getVersion();
+    ASSERT_FALSE(network.load(path));
+    ASSERT_FALSE(network.load(path + ".missing"));
+    ASSERT_EQ(value, network.evaluate(board));
+    ASSERT_EQ(version, network.getVersion());
+
+    NeuralNetwork emptyNetwork;
+    ASSERT_FALSE(emptyNetwork.load(path));
+    ASSERT_FALSE(emptyNetwork.isReady());
+
+    remove(path.c_str());
+}
+
+TEST_F(NeuralNetworkTests, ColorSymmetry) {
+    // The same position with the colors swapped and the board flipped has the opposite evaluation
+    auto board = boardFor("r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP3PPP/R2QKB1R w KQ - 0 8");
+    auto flippedBoard = boardFor("r2qkb1r/pp3ppp/2n1pn2/2pp4/3P4/2N1PN2/PP2BPPP/R1BQ1RK1 b kq - 0 8");
+    ASSERT_EQ(network.evaluate(board), -network.evaluate(flippedBoard));
+}
+
+TEST_F(NeuralNetworkTests, IncrementalUpdate) {
+    // Each position is chosen for the moves that change several features: castling,
+    // en-passant, promotions (with or without a capture) and king moves.
+    for (auto fen : { "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+                      "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+                      "r3k2r/1P4P1/8/8/8/8/1p4p1/R3K2R w KQkq - 0 1",
+                      "r3k2r/1P4P1/8/8/8/8/1p4p1/R3K2R b KQkq - 0 1" }) {
+        NeuralAccumulatorStack stack;
+        stack.reset();
+        assertIncremental(boardFor(fen), stack, 2);
+    }
+}
+
+TEST_F(NeuralNetworkTests, LazyUpdate) {
+    // Only the position evaluated at the end of the line is computed,
+    // from the root position, by applying the moves in-between.
+    ChessGame game;
+    ASSERT_TRUE(FPGN::setGame("1. e4 d5 2. exd5 Qxd5 3. Nc3 Qa5 4. d4 c6 5. Nf3 Bg4 6. Bf4 e6 7. h3 Bxf3 8. Qxf3 Bb4 9. Be2 Nd7 10. a3 O-O-O *", game));
+
+    ChessBoard board;
+    FFEN::setFEN(StartFEN, board);
+
+    NeuralAccumulatorStack stack;
+    stack.reset();
+    stack.accumulator(network, board);
+    for (auto move : game.allMoves()) {
+        board.move(move);
+        stack.push(move);
+    }
+    ASSERT_EQ(network.evaluate(board), network.evaluate(board, stack.accumulator(network, board)));
+}
+
+TEST_F(NeuralNetworkTests, Search) {
+    ChessEvaluater::network = network;
+    ChessEvaluater::neuralEvaluation = true;
+    ASSERT_TRUE(ChessEvaluater::useNeuralNetwork());
+
+    // Any network finds a mate because it is detected before the position is evaluated
+    auto board = boardFor("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1");
+
+    ChessMinMaxSearch search;
+    search.config.maxDepth = 3;
+
+    TranspositionTable table;
+    ChessMinMaxSearch::Variation pv;
+    ChessMinMaxSearch::Variation bv;
+    int score = search.alphabeta(board, NEW_HISTORY, table, 0, true, pv, bv);
+
+    ChessEvaluater::neuralEvaluation = false;
+    ChessEvaluater::network = NeuralNetwork();
+
+    ASSERT_EQ("Ra1a8", FPGN::to_string(pv.moves.decode(board).bestMove()));
+    ASSERT_EQ(int(ChessEvaluater::MAT_VALUE), score);
+}
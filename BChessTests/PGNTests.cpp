@@ -204,6 +204,34 @@ TEST_F(PGN, GameWithBlackPromotion) {
     ASSERT_EQ(pgn, "1. e4 Nf6 2. Nc3 Nxe4 3. Nxe4 d5 4. Nc3 Qd6 5. Nf3 h5 6. d4 Qd8 7. Bb5+ c6 8. Ba4 b5 9. Bb3 a5 10. a4 b4 11. Na2 Bg4 12. Qd3 Bxf3 13. Qxf3 h4 14. h3 Qd6 15. Bf4 Qe6+ 16. Be3 Qd6 17. O-O g6 18. c4 bxc3 19. bxc3 Nd7 20. c4 dxc4 21. Bxc4 Qf6 22. Qg4 e5 23. Rfe1 Qg7 24. dxe5 Nc5 25. Bxc5 Bxc5 26. e6 Bd4 27. exf7+ Kf8 28. Qe6 Qf6 29. Rad1 Qxe6 30. Bxe6 c5 31. Bd5 Rb8 32. Nc1 Rh5 33. Bc4 Rf5 34. Re2 Rf4 35. Rde1 Bxf2+ 36. Rxf2 Rxc4 37. Nd3 Kg7 38. Re7 Kf8 39. Re6 Rxa4 40. Nxc5 Ra1+ 41. Kh2 Rd1 42. Ne4 Kg7 43. Ng5 Rf8 44. Rfe2 Rxf7 45. Nxf7 Kxf7 46. Re6e4 Ra1 47. Rxh4 Kg8 48. Rf2 Kg7 49. Rhf4 a4 50. Rf7+ Kh6 51. Rf2f4 a3 52. Rg4 a2 53. Rf6 Rh1+ 54. Kxh1 a1=Q+ *");
 }
 
+TEST_F(PGN, GameMovesDecoded) {
+    ChessGame game;
+    ASSERT_TRUE(FPGN::setGame("1. e4 d5 2. exd5 c5 3. dxc6 Nf6 4. cxb7 e6 5. bxa8=Q Bc5 6. Nf3 O-O 7. Bc4 *", game));
+    
+    // The game stores the compact moves, which are decoded with the board on which they are played
+    ASSERT_EQ(sizeof(CompactMove), sizeof(game.getRoot().move));
+    
+    auto moves = game.allMoves();
+    ASSERT_EQ(13, moves.size());
+    
+    ChessBoard board;
+    ASSERT_TRUE(FFEN::setFEN(StartFEN, board));
+    for (int index=0; index<moves.size(); index++) {
+        ASSERT_EQ(moves[index], game.getMoveAtIndex(index));
+        
+        ChessMoveGenerator generator;
+        auto generatedMoves = generator.generateMoves(board);
+        bool found = false;
+        for (int moveIndex=0; moveIndex<generatedMoves.count; moveIndex++) {
+            found |= generatedMoves.moves[moveIndex] == moves[index];
+        }
+        ASSERT_TRUE(found) << FPGN::to_string(moves[index]);
+        board.move(moves[index]);
+    }
+    ASSERT_EQ(INVALID_MOVE, game.getMoveAtIndex(13));
+    ASSERT_EQ(FFEN::getFEN(board), FFEN::getFEN(game.board));
+}
+
 TEST_F(PGN, OutputFromInitialPosition) {
     ChessGame game;
     ASSERT_EQ(StartFEN, game.initialFEN);
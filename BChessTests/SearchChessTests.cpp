@@ -15,6 +15,8 @@
 
 #include <vector>
 #include <map>
+#include <thread>
+#include <atomic>
 
 class SearchChessTests: public ::testing::Test {
 public:
@@ -45,10 +47,10 @@ TEST_F(SearchChessTests, ChessTree) {
     config.quiescenceSearch = false;
 
     config.alphaBetaPrunning = true;
-    assertChessSearch(23201, 50, config); // with alpha-beta prunning
+    assertChessSearch(3722, 0, config); // with alpha-beta prunning
     
     config.alphaBetaPrunning = false;
-    assertChessSearch(142400, 50, config); // without alpha-beta
+    assertChessSearch(142400, 0, config); // without alpha-beta
 }
 
 TEST_F(SearchChessTests, OrderedMove) {
@@ -58,9 +60,187 @@ TEST_F(SearchChessTests, OrderedMove) {
 
     Configuration config;
 
+    // The order of the moves changes the number of nodes visited. Note: the entries of the
+    // transposition table also depend on that order, which could change the score slightly.
+    // The captures of the quiescence search are always generated in MVV/LVA order.
     config.sortMoves = true;
-    assertChessSearch(23822, 105, config, board);
+    assertChessSearch(17957, 43, config, board);
     
     config.sortMoves = false;
-    assertChessSearch(136202, 105, config, board);
+    assertChessSearch(562296, 43, config, board);
+}
+
+TEST_F(SearchChessTests, ProbCut) {
+    auto fen = "r1bqkbnr/pppp1ppp/2n5/3P4/8/8/PPP2PPP/RNBQKBNR b KQkq - 0 5";
+    ChessBoard board;
+    ASSERT_TRUE(FFEN::setFEN(fen, board));
+
+    Configuration config;
+    config.maxDepth = 5;
+    config.probCutMinDepth = 3;
+    config.probCutReduction = 2;
+
+    config.probCut = false;
+    assertChessSearch(90935, 20, config, board);
+
+    // Same score but fewer nodes visited
+    config.probCut = true;
+    assertChessSearch(87446, 20, config, board);
+    
+    // The reduced searches lower the horizon temporarily
+    ChessMinMaxSearch search;
+    search.config = config;
+    ChessMinMaxSearch::Variation pv;
+    ChessMinMaxSearch::Variation bv;
+    TranspositionTable table;
+    ASSERT_EQ(20, search.alphabeta(board, NEW_HISTORY, table, 0, board.color == WHITE, pv, bv));
+    ASSERT_EQ(5, search.config.maxDepth);
+}
+
+TEST_F(SearchChessTests, QuiescenceChecks) {
+    // The mate with a quiet move is found by the quiescence search alone
+    auto fen = "6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1";
+    ChessBoard board;
+    ASSERT_TRUE(FFEN::setFEN(fen, board));
+    
+    Configuration config;
+    config.maxDepth = 0;
+    int matValue = ChessEvaluater::MAT_VALUE;
+    
+    ChessMinMaxSearch search;
+    search.config = config;
+    ChessMinMaxSearch::Variation pv;
+    ChessMinMaxSearch::Variation bv;
+    TranspositionTable table;
+    ASSERT_EQ(matValue, search.alphabeta(board, NEW_HISTORY, table, 0, true, pv, bv));
+    ASSERT_EQ("Ra1a8", pv.moves.decode(board).description());
+    
+    search.config.quiescenceChecks = false;
+    pv = ChessMinMaxSearch::Variation();
+    table.clear();
+    ASSERT_LT(search.alphabeta(board, NEW_HISTORY, table, 0, true, pv, bv), matValue);
+}
+
+static void assertMultiPV(int multiPV, int threads) {
+    auto fen = "r1bqkbnr/pppp1ppp/2n5/3P4/8/8/PPP2PPP/RNBQKBNR b KQkq - 0 5";
+    ChessBoard board;
+    ASSERT_TRUE(FFEN::setFEN(fen, board));
+
+    IterativeDeepening search;
+    search.multiPV = multiPV;
+    search.threads = threads;
+    auto evaluation = search.search(board, NEW_HISTORY, 4, nullptr);
+    
+    ASSERT_EQ(multiPV, evaluation.variations.size());
+    
+    // The best variation is the same as the one found with a single line
+    ASSERT_EQ("Nc6e5 Ng1f3 Qd8e7 Nf3xe5 Qe7xe5 Bf1e2", evaluation.line.description());
+    ASSERT_EQ(43, evaluation.value);
+    ASSERT_EQ(evaluation.line.description(), evaluation.variations[0].line.description());
+    ASSERT_EQ(evaluation.value, evaluation.variations[0].value);
+    
+    // Black is playing, so the values are increasing (from white's point of view)
+    for (int index=1; index<multiPV; index++) {
+        ASSERT_LE(evaluation.variations[index-1].value, evaluation.variations[index].value);
+        ASSERT_NE(evaluation.variations[index-1].line.bestMove(), evaluation.variations[index].line.bestMove());
+    }
+}
+
+TEST_F(SearchChessTests, MultiPV) {
+    assertMultiPV(3, 1);
+}
+
+TEST_F(SearchChessTests, MultiPVWithThreads) {
+    assertMultiPV(3, 4);
+}
+
+TEST_F(SearchChessTests, EvalCache) {
+    auto fen = "r1bqkbnr/pppp1ppp/2n5/3P4/8/8/PPP2PPP/RNBQKBNR b KQkq - 0 5";
+    ChessBoard board;
+    ASSERT_TRUE(FFEN::setFEN(fen, board));
+    
+    IterativeDeepening uncached;
+    uncached.minMaxSearch.config.evalCacheSize = 0;
+    auto expected = uncached.search(board, NEW_HISTORY, 4, nullptr);
+    ASSERT_EQ(0, expected.evalCacheHits);
+    ASSERT_EQ(0, expected.evalCacheMisses);
+    
+    // The cache doesn't change the result of the search
+    IterativeDeepening search;
+    search.minMaxSearch.config.evalCacheSize = 1024*1024;
+    auto evaluation = search.search(board, NEW_HISTORY, 4, nullptr);
+    ASSERT_EQ(expected.line.description(), evaluation.line.description());
+    ASSERT_EQ(expected.value, evaluation.value);
+    ASSERT_EQ(expected.nodes, evaluation.nodes);
+    ASSERT_GT(evaluation.evalCacheHits, 0);
+    ASSERT_GT(evaluation.evalCacheMisses, 0);
+    
+    // The evaluations are kept for the next search, the few misses
+    // left are the evaluations replaced by another one at the same index.
+    search.table.clear();
+    auto again = search.search(board, NEW_HISTORY, 4, nullptr);
+    ASSERT_EQ(expected.value, again.value);
+    ASSERT_LT(again.evalCacheMisses * 20, evaluation.evalCacheMisses);
+}
+
+TEST_F(SearchChessTests, Ponder) {
+    ChessBoard board;
+    
+    IterativeDeepening search;
+    search.pondering = true;
+
+    std::atomic<bool> completed(false);
+    ChessEvaluation evaluation;
+    std::thread thread([&]() {
+        evaluation = search.search(board, NEW_HISTORY, 2, nullptr);
+        completed = true;
+    });
+    
+    // The maximum depth is reached quickly but the search
+    // doesn't complete until ponderhit is received.
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    ASSERT_FALSE(completed);
+    ASSERT_TRUE(search.running());
+    
+    search.ponderhit();
+    thread.join();
+    
+    ASSERT_TRUE(completed);
+    ASSERT_FALSE(search.running());
+    ASSERT_EQ(2, evaluation.line.count);
+}
+
+TEST_F(SearchChessTests, Stop) {
+    auto fen = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+    ChessBoard board;
+    ASSERT_TRUE(FFEN::setFEN(fen, board));
+
+    // The search is stopped in the middle of an iteration, at various times, and the nodes whose moves
+    // were not all searched must not store their value in the table (which is kept for the next search).
+    int matValue = ChessEvaluater::MAT_VALUE;
+    IterativeDeepening search;
+    for (int milliseconds=1; milliseconds<=100; milliseconds+=3) {
+        bool cancel = milliseconds % 2 == 0;
+        ChessEvaluation evaluation;
+        std::thread thread([&]() {
+            evaluation = search.search(board, NEW_HISTORY, 12, nullptr);
+        });
+        while (!search.running()) {
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+        if (cancel) {
+            search.cancel();
+        } else {
+            search.stop();
+        }
+        thread.join();
+        ASSERT_FALSE(search.running());
+        ASSERT_LT(abs(evaluation.value), matValue);
+    }
+    
+    // The table is still consistent for a complete search
+    auto evaluation = search.search(board, NEW_HISTORY, 4, nullptr);
+    ASSERT_GT(evaluation.line.count, 0);
+    ASSERT_LT(abs(evaluation.value), matValue);
 }
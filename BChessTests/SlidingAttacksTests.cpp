@@ -0,0 +1,66 @@
+//
+//  SlidingAttacksTests.cpp
+//  BChessTests
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+
+#include "ChessEngine.hpp"
+#include "SlidingAttacks.hpp"
+
+class SlidingAttacksTests: public ::testing::Test {
+public:
+    void SetUp() {
+        ChessEngine::initialize();
+    }
+    
+    void TearDown() {
+        SlidingAttacks::setBackend(SlidingAttacks::isPEXTAvailable() ? SlidingAttacks::Backend::pext : SlidingAttacks::Backend::magic);
+    }
+};
+
+TEST_F(SlidingAttacksTests, PEXTMatchesMagic) {
+    // The PEXT tables must give the same attacks as the magic bitboards for any occupancy
+    Bitboard seed = 1070372;
+    for (int iteration = 0; iteration < 100000; iteration++) {
+        seed ^= seed >> 12;
+        seed ^= seed << 25;
+        seed ^= seed >> 27;
+        Bitboard occupancy = seed * 2685821657736338717ULL;
+        Square square = iteration & 63;
+        ASSERT_EQ(Rmagic(square, occupancy), SlidingAttacks::rookAttacksPEXT(square, occupancy));
+        ASSERT_EQ(Bmagic(square, occupancy), SlidingAttacks::bishopAttacksPEXT(square, occupancy));
+    }
+}
+
+TEST_F(SlidingAttacksTests, Backend) {
+    ASSERT_TRUE(SlidingAttacks::setBackend(SlidingAttacks::Backend::magic));
+    ASSERT_EQ(SlidingAttacks::Backend::magic, SlidingAttacks::getBackend());
+    
+    ASSERT_EQ(SlidingAttacks::isPEXTAvailable(), SlidingAttacks::setBackend(SlidingAttacks::Backend::pext));
+    if (SlidingAttacks::isPEXTAvailable()) {
+        ASSERT_EQ(SlidingAttacks::Backend::pext, SlidingAttacks::getBackend());
+    }
+    
+    // Rook on d4 with a blocker on d6 and on f4
+    Bitboard occupancy = 0;
+    bb_set(occupancy, d6);
+    bb_set(occupancy, f4);
+    auto attacks = RookAttacks(d4, occupancy);
+    ASSERT_TRUE(bb_test(attacks, d6));
+    ASSERT_FALSE(bb_test(attacks, d7));
+    ASSERT_TRUE(bb_test(attacks, f4));
+    ASSERT_FALSE(bb_test(attacks, g4));
+    ASSERT_TRUE(bb_test(attacks, a4));
+    ASSERT_TRUE(bb_test(attacks, d1));
+}
+
+// Disabled because it only measures the lookups, run it with --gtest_also_run_disabled_tests
+TEST_F(SlidingAttacksTests, DISABLED_Benchmark) {
+    ASSERT_GT(SlidingAttacks::benchmark(SlidingAttacks::Backend::magic), 0);
+    if (SlidingAttacks::isPEXTAvailable()) {
+        ASSERT_GT(SlidingAttacks::benchmark(SlidingAttacks::Backend::pext), 0);
+    }
+}
@@ -0,0 +1,496 @@
+//
+//  TablebasesTests.cpp
+//  BChessTests
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+
+#include "ChessEngine.hpp"
+#include "Tablebases.hpp"
+#include "Bitbases.hpp"
+#include "FFEN.hpp"
+#include "FPGN.hpp"
+#include "UnitTestHelper.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <fstream>
+#include <random>
+#include <sys/stat.h>
+
+// Most of the tables used by these tests are written by the tests themselves: the KQvK tables
+// in the format of the Syzygy tables, with the same value for all the positions
+// (WDL and DTZ) or with pseudo-random values compressed with a 1-bit code (WDL).
+// The RealTables tests use the actual Syzygy tables (see loadRealTables()).
+class TablebasesTests: public ::testing::Test {
+public:
+    std::string directory = std::string(P_tmpdir) + "/bchess-tablebases";
+
+    // Values of the KQvK tables with a single value
+    static const int WhiteToMoveValue = 4; // Win
+    static const int BlackToMoveValue = 0; // Loss
+    static const int WhiteToMoveDTZ = 5; // Stored in moves: 11 plies
+
+    void SetUp() {
+        ChessEngine::initialize();
+        mkdir(directory.c_str(), 0755);
+    }
+
+    void TearDown() {
+        Tablebases::load("");
+        for (auto name : { "KQvK.rtbw", "KQvK.rtbz", "README.txt" }) {
+            remove((directory + "/" + name).c_str());
+        }
+        rmdir(directory.c_str());
+    }
+
+    ChessBoard boardFor(std::string fen) {
+        ChessBoard board;
+        assert(FFEN::setFEN(fen, board));
+        return board;
+    }
+
+    void write(std::string name, std::vector<uint8_t> bytes) {
+        // The size of a table is always a multiple of 64 bytes plus 16 bytes
+        while (bytes.size() % 64 != 16) {
+            bytes.push_back(0);
+        }
+        std::ofstream file(directory + "/" + name, std::ios::binary);
+        file.write((const char *)bytes.data(), bytes.size());
+    }
+
+    // Header of the KQvK tables: the magic, the flags (split because the colors have different pieces), the order
+    // of the groups and the pieces (white king, white queen, black king) for each side to move, aligned on 16 bits.
+    std::vector<uint8_t> header(bool wdl) {
+        std::vector<uint8_t> bytes;
+        if (wdl) {
+            bytes = { 0x71, 0xE8, 0x23, 0x5D };
+        } else {
+            bytes = { 0xD7, 0x66, 0x0C, 0xA5 };
+        }
+        bytes.insert(bytes.end(), { 0x01, 0x00, 0x66, 0x55, 0xEE, 0x00 });
+        return bytes;
+    }
+
+    void writeSingleValueTables() {
+        auto wdl = header(true);
+        wdl.insert(wdl.end(), { 0x80, WhiteToMoveValue, 0x80, BlackToMoveValue });
+        write("KQvK.rtbw", wdl);
+
+        // Only the positions with white to move are in the DTZ table
+        auto dtz = header(false);
+        dtz.insert(dtz.end(), { 0x80, WhiteToMoveDTZ });
+        write("KQvK.rtbz", dtz);
+    }
+
+    // Writes a WDL table where each value is a pseudo-random draw or win, stored with one bit per value:
+    // the symbol 0 is a draw and the symbol 1 is a win.
+    void writeRandomTable() {
+        const uint64_t size = 31332; // Placements of the three unique pieces
+        const int blockSizeBits = 10;
+        const int spanBits = 10;
+        const uint64_t valuesPerBlock = (1 << blockSizeBits) * 8;
+        const uint32_t blockCount = uint32_t((size + valuesPerBlock - 1) / valuesPerBlock);
+        const uint64_t sparseCount = (size + (1 << spanBits) - 1) >> spanBits;
+
+        auto bytes = header(true);
+        for (int side=0; side<2; side++) {
+            bytes.insert(bytes.end(), { 0x00, blockSizeBits, spanBits, 0x00 });
+            for (int index=0; index<4; index++) {
+                bytes.push_back(uint8_t(blockCount >> (8 * index)));
+            }
+            // One symbol length, the lowest symbol being 0, then the two symbols and their value
+            bytes.insert(bytes.end(), { 1, 1, 0, 0, 2, 0 });
+            bytes.insert(bytes.end(), { 0x02, 0xF0, 0xFF, 0x04, 0xF0, 0xFF });
+        }
+
+        // Sparse index: block and offset of the value in the middle of each span
+        for (int side=0; side<2; side++) {
+            for (uint64_t k=0; k<sparseCount; k++) {
+                uint64_t index = (k << spanBits) + (1 << (spanBits - 1));
+                uint32_t block = uint32_t(index / valuesPerBlock);
+                uint16_t offset = uint16_t(index % valuesPerBlock);
+                for (int byte=0; byte<4; byte++) {
+                    bytes.push_back(uint8_t(block >> (8 * byte)));
+                }
+                bytes.push_back(uint8_t(offset));
+                bytes.push_back(uint8_t(offset >> 8));
+            }
+        }
+
+        // Number of values (minus one) of each block
+        for (int side=0; side<2; side++) {
+            for (uint32_t block=0; block<blockCount; block++) {
+                uint64_t count = std::min(valuesPerBlock, size - block * valuesPerBlock);
+                bytes.push_back(uint8_t(count - 1));
+                bytes.push_back(uint8_t((count - 1) >> 8));
+            }
+        }
+
+        // The values, aligned on 64 bytes, the first value being the most significant bit
+        std::mt19937 random(2026);
+        for (int side=0; side<2; side++) {
+            while (bytes.size() % 64 != 0) {
+                bytes.push_back(0);
+            }
+            for (uint64_t index=0; index<blockCount * valuesPerBlock / 8; index++) {
+                bytes.push_back(uint8_t(random()));
+            }
+        }
+
+        write("KQvK.rtbw", bytes);
+    }
+
+    Tablebases::WDL probe(std::string fen) {
+        auto board = boardFor(fen);
+        Tablebases::WDL wdl;
+        EXPECT_TRUE(Tablebases::canProbe(board)) << fen;
+        EXPECT_TRUE(Tablebases::probeWDL(board, wdl)) << fen;
+        return wdl;
+    }
+
+    // Loads the real tables KQvK, KRvK and KPvK (WDL and DTZ) from the directory of the environment variable
+    // SYZYGY_PATH, or from the Tablebases directory of the resources. Returns false if one of them is missing
+    // (they are not part of the repository) and the test is then reported as skipped.
+    bool loadRealTables() {
+        auto path = getenv("SYZYGY_PATH");
+        std::string directory = path ? path : UnitTestHelper::pathToResources + "/Tablebases";
+        for (auto name : { "KQvK", "KRvK", "KPvK" }) {
+            for (auto extension : { ".rtbw", ".rtbz" }) {
+                if (!std::ifstream(directory + "/" + name + extension).good()) {
+                    return false;
+                }
+            }
+        }
+        return Tablebases::load(directory) >= 3;
+    }
+
+    int probeDTZ(std::string fen) {
+        auto board = boardFor(fen);
+        int dtz = INT_MAX;
+        EXPECT_TRUE(Tablebases::probeDTZ(board, dtz)) << fen;
+        return dtz;
+    }
+
+    static bool contains(MoveList &moves, std::string move) {
+        for (int index=0; index<moves.count; index++) {
+            if (FPGN::to_string(moves[index]) == move) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+TEST_F(TablebasesTests, Load) {
+    writeSingleValueTables();
+    std::ofstream(directory + "/README.txt") << "Not a table";
+
+    ASSERT_EQ(0, Tablebases::load(directory + "/missing"));
+    ASSERT_EQ(0, Tablebases::maxPieces());
+
+    ASSERT_EQ(1, Tablebases::load(directory + "/missing:" + directory));
+    ASSERT_EQ(3, Tablebases::maxPieces());
+
+    // Too many pieces or castling rights
+    auto board = boardFor("8/8/2k5/8/8/8/8/KQ5R w - - 0 1");
+    ASSERT_FALSE(Tablebases::canProbe(board));
+    board = boardFor("4k3/8/8/8/8/8/8/4K2Q w k - 0 1");
+    ASSERT_FALSE(Tablebases::canProbe(board));
+
+    // The tables that are missing cannot be probed
+    board = boardFor("8/8/2k5/8/8/8/8/KR6 w - - 0 1");
+    Tablebases::WDL wdl;
+    ASSERT_FALSE(Tablebases::probeWDL(board, wdl));
+    int dtz;
+    ASSERT_FALSE(Tablebases::probeDTZ(board, dtz));
+
+    ASSERT_EQ(0, Tablebases::load(""));
+    ASSERT_EQ(0, Tablebases::maxPieces());
+}
+
+TEST_F(TablebasesTests, InvalidTable) {
+    // A table with the magic of a DTZ table is rejected when probed
+    auto bytes = header(false);
+    bytes.insert(bytes.end(), { 0x80, WhiteToMoveValue, 0x80, BlackToMoveValue });
+    write("KQvK.rtbw", bytes);
+    ASSERT_EQ(1, Tablebases::load(directory));
+
+    auto board = boardFor("8/8/2k5/8/8/8/8/KQ6 w - - 0 1");
+    Tablebases::WDL wdl;
+    ASSERT_FALSE(Tablebases::probeWDL(board, wdl));
+}
+
+TEST_F(TablebasesTests, ProbeWDL) {
+    writeSingleValueTables();
+    ASSERT_EQ(1, Tablebases::load(directory));
+
+    ASSERT_EQ(Tablebases::WIN, probe("8/8/2k5/8/8/8/8/KQ6 w - - 0 1"));
+    ASSERT_EQ(Tablebases::LOSS, probe("8/8/2k5/8/8/8/8/KQ6 b - - 0 1"));
+
+    // The colors are swapped when black has the queen
+    ASSERT_EQ(Tablebases::WIN, probe("kq6/8/8/8/8/8/2K5/8 b - - 0 1"));
+    ASSERT_EQ(Tablebases::LOSS, probe("kq6/8/8/8/8/8/2K5/8 w - - 0 1"));
+
+    // The captures are searched before probing the table: the queen can be taken
+    ASSERT_EQ(Tablebases::DRAW, probe("8/8/2k5/1Q6/8/8/8/K7 b - - 0 1"));
+
+    // Only the kings
+    ASSERT_EQ(Tablebases::DRAW, probe("8/8/2k5/8/8/8/8/K7 w - - 0 1"));
+}
+
+TEST_F(TablebasesTests, ProbeDTZ) {
+    writeSingleValueTables();
+    ASSERT_EQ(1, Tablebases::load(directory));
+
+    auto board = boardFor("8/8/2k5/8/8/8/8/KQ6 w - - 0 1");
+    int dtz;
+    ASSERT_TRUE(Tablebases::probeDTZ(board, dtz));
+    ASSERT_EQ(2 * WhiteToMoveDTZ + 1, dtz);
+
+    // The table doesn't store black to move: each move of black reaches a position with
+    // white to move, one ply further from the zeroing move.
+    board = boardFor("8/8/2k5/8/8/8/8/KQ6 b - - 0 1");
+    ASSERT_TRUE(Tablebases::probeDTZ(board, dtz));
+    ASSERT_EQ(-(2 * WhiteToMoveDTZ + 2), dtz);
+
+    // The capture of the queen is a draw
+    board = boardFor("8/8/2k5/1Q6/8/8/8/K7 b - - 0 1");
+    ASSERT_TRUE(Tablebases::probeDTZ(board, dtz));
+    ASSERT_EQ(0, dtz);
+}
+
+TEST_F(TablebasesTests, FilterRootMoves) {
+    writeSingleValueTables();
+    ASSERT_EQ(1, Tablebases::load(directory));
+
+    // The moves giving away the queen are removed
+    auto board = boardFor("8/8/2k5/8/8/8/8/KQ6 w - - 0 1");
+    auto moves = ChessMoveGenerator::generateMoves(board);
+    auto count = moves.count;
+    ASSERT_TRUE(contains(moves, "Qb1b5"));
+    ASSERT_TRUE(Tablebases::filterRootMoves(board, moves));
+    ASSERT_EQ(count - 3, moves.count);
+    ASSERT_FALSE(contains(moves, "Qb1b5"));
+    ASSERT_FALSE(contains(moves, "Qb1b6"));
+    ASSERT_FALSE(contains(moves, "Qb1b7"));
+    ASSERT_TRUE(contains(moves, "Qb1b4"));
+
+    // When drawing, only the moves that keep the draw are kept
+    board = boardFor("8/8/2k5/1Q6/8/8/8/K7 b - - 0 1");
+    moves = ChessMoveGenerator::generateMoves(board);
+    ASSERT_TRUE(Tablebases::filterRootMoves(board, moves));
+    ASSERT_EQ(1, moves.count);
+    ASSERT_EQ("Kc6xb5", FPGN::to_string(moves[0]));
+}
+
+TEST_F(TablebasesTests, Symmetries) {
+    // The positions that are the same up to a symmetry of the board, or to the colors being swapped,
+    // have the same index in the table and thus the same (pseudo-random) value.
+    writeRandomTable();
+    ASSERT_EQ(1, Tablebases::load(directory));
+
+    std::mt19937 random(1);
+    int wins = 0;
+    int positions = 0;
+    while (positions < 500) {
+        int whiteKing = random() % 64;
+        int queen = random() % 64;
+        int blackKing = random() % 64;
+        if (whiteKing == queen || whiteKing == blackKing || queen == blackKing || bb_test(KingMoves[whiteKing], blackKing)) {
+            continue;
+        }
+
+        Tablebases::WDL values[5];
+        for (int symmetry=0; symmetry<5; symmetry++) {
+            auto transform = [&](int square) {
+                switch (symmetry) {
+                    case 1: return square ^ 7; // Horizontal
+                    case 2: return square ^ 56; // Vertical
+                    case 3: return ((square >> 3) | (square << 3)) & 63; // Diagonal
+                    default: return square;
+                }
+            };
+            Color strong = symmetry == 4 ? BLACK : WHITE;
+            ChessBoard board;
+            board.clear();
+            board.castling = 0;
+            board.color = strong;
+            board.set({ false, strong, KING }, FileFrom(transform(whiteKing) ^ (symmetry == 4 ? 56 : 0)), RankFrom(transform(whiteKing) ^ (symmetry == 4 ? 56 : 0)));
+            board.set({ false, strong, QUEEN }, FileFrom(transform(queen) ^ (symmetry == 4 ? 56 : 0)), RankFrom(transform(queen) ^ (symmetry == 4 ? 56 : 0)));
+            board.set({ false, INVERSE(strong), KING }, FileFrom(transform(blackKing) ^ (symmetry == 4 ? 56 : 0)), RankFrom(transform(blackKing) ^ (symmetry == 4 ? 56 : 0)));
+            if (board.isCheck(INVERSE(strong))) {
+                break; // The side not to move cannot be in check
+            }
+            ASSERT_TRUE(Tablebases::probeWDL(board, values[symmetry])) << FFEN::getFEN(board);
+            ASSERT_TRUE(values[symmetry] == Tablebases::DRAW || values[symmetry] == Tablebases::WIN);
+            ASSERT_EQ(values[0], values[symmetry]) << FFEN::getFEN(board) << " symmetry " << symmetry;
+            if (symmetry == 4) {
+                positions++;
+                wins += values[0] == Tablebases::WIN;
+            }
+        }
+    }
+
+    // Both values are stored
+    ASSERT_GT(wins, 100);
+    ASSERT_LT(wins, 400);
+}
+
+TEST_F(TablebasesTests, Search) {
+    writeSingleValueTables();
+    ASSERT_EQ(1, Tablebases::load(directory));
+
+    // The capture of the rook reaches a position of the tables, which stops the search right away
+    auto board = boardFor("8/8/8/3k4/8/8/3r4/K2Q4 w - - 0 1");
+
+    ChessMinMaxSearch search;
+    search.config.maxDepth = 3;
+    search.config.tablebases = true;
+
+    TranspositionTable table;
+    ChessMinMaxSearch::Variation pv;
+    ChessMinMaxSearch::Variation bv;
+    int score = search.alphabeta(board, NEW_HISTORY, table, 0, true, pv, bv);
+
+    ASSERT_EQ("Qd1xd2", FPGN::to_string(pv.moves.decode(board).bestMove()));
+    ASSERT_EQ(ChessEvaluater::TABLEBASE_WIN_VALUE - 1, score);
+    ASSERT_GT(search.tablebaseHits, 0);
+
+    // Without the tables, the capture is found by the evaluation, KQK being a known win (see Endgames)
+    search.config.tablebases = false;
+    search.reset();
+    table.clear();
+    pv = ChessMinMaxSearch::Variation();
+    score = search.alphabeta(board, NEW_HISTORY, table, 0, true, pv, bv);
+    ASSERT_EQ(0, search.tablebaseHits);
+    int knownWinValue = ChessEvaluater::KNOWN_WIN_VALUE;
+    ASSERT_GT(score, knownWinValue);
+    ASSERT_LT(score, knownWinValue * 2);
+}
+
+TEST_F(TablebasesTests, RootMoves) {
+    writeSingleValueTables();
+    ASSERT_EQ(1, Tablebases::load(directory));
+
+    // The engine keeps the queen, whatever the depth of the search
+    ChessEngine engine;
+    engine.transpositionTable = false;
+    engine.tablebases = true;
+    ASSERT_TRUE(engine.setFEN("8/8/2k5/8/8/8/8/KQ6 w - - 0 1"));
+    ChessEvaluation evaluation;
+    engine.searchBestMove(1, [&](ChessEvaluation info, bool completed) {
+        evaluation = info;
+    });
+    auto move = FPGN::to_string(evaluation.line.bestMove());
+    ASSERT_NE("Qb1b5", move);
+    ASSERT_NE("Qb1b6", move);
+    ASSERT_NE("Qb1b7", move);
+    ASSERT_GT(evaluation.tablebaseHits, 0);
+}
+
+TEST_F(TablebasesTests, RealTablesWDL) {
+    if (!loadRealTables()) {
+        GTEST_SKIP() << "KQvK, KRvK or KPvK missing, set SYZYGY_PATH to a directory of the Syzygy tables";
+    }
+
+    ASSERT_EQ(Tablebases::WIN, probe("8/8/2k5/8/8/8/8/KQ6 w - - 0 1"));
+    ASSERT_EQ(Tablebases::LOSS, probe("8/8/2k5/8/8/8/8/KQ6 b - - 0 1"));
+    ASSERT_EQ(Tablebases::DRAW, probe("k7/2Q5/1K6/8/8/8/8/8 b - - 0 1")); // Stalemate
+
+    ASSERT_EQ(Tablebases::WIN, probe("8/8/2k5/8/8/8/8/KR6 w - - 0 1"));
+    ASSERT_EQ(Tablebases::DRAW, probe("8/8/8/8/8/8/2kR4/K7 b - - 0 1")); // The rook is taken
+
+    // The king in front of its pawn wins whoever is to move, except with a rook pawn
+    ASSERT_EQ(Tablebases::WIN, probe("4k3/8/4K3/4P3/8/8/8/8 w - - 0 1"));
+    ASSERT_EQ(Tablebases::LOSS, probe("4k3/8/4K3/4P3/8/8/8/8 b - - 0 1"));
+    ASSERT_EQ(Tablebases::DRAW, probe("k7/8/K7/P7/8/8/8/8 w - - 0 1"));
+
+    // Same positions with the colors swapped
+    ASSERT_EQ(Tablebases::WIN, probe("8/8/8/8/4p3/4k3/8/4K3 b - - 0 1"));
+    ASSERT_EQ(Tablebases::LOSS, probe("8/8/8/8/4p3/4k3/8/4K3 w - - 0 1"));
+    ASSERT_EQ(Tablebases::DRAW, probe("8/8/8/8/p7/k7/8/K7 b - - 0 1"));
+}
+
+TEST_F(TablebasesTests, RealTablesDTZ) {
+    if (!loadRealTables()) {
+        GTEST_SKIP() << "KQvK, KRvK or KPvK missing, set SYZYGY_PATH to a directory of the Syzygy tables";
+    }
+
+    // Mate in one
+    ASSERT_EQ(1, probeDTZ("k7/8/1K6/8/8/8/8/7Q w - - 0 1"));
+    ASSERT_EQ(1, probeDTZ("k7/8/1K6/8/8/8/8/7R w - - 0 1"));
+
+    // The pawn runs: its first move wins, one ply later for black
+    ASSERT_EQ(1, probeDTZ("7k/8/8/8/8/8/P7/K7 w - - 0 1"));
+    int dtz = probeDTZ("7k/8/8/8/8/8/P7/K7 b - - 0 1");
+    ASSERT_LE(dtz, -2);
+    ASSERT_GE(dtz, -3); // A DTZ stored in moves can be one ply longer
+
+    // Longer wins
+    dtz = probeDTZ("8/8/2k5/8/8/8/8/KQ6 w - - 0 1");
+    ASSERT_GT(dtz, 1);
+    ASSERT_LE(dtz, 21); // KQK is mated in at most 10 moves
+    ASSERT_LT(probeDTZ("8/8/2k5/8/8/8/8/KR6 b - - 0 1"), -1);
+
+    ASSERT_EQ(0, probeDTZ("8/8/8/8/8/8/2kR4/K7 b - - 0 1"));
+    ASSERT_EQ(0, probeDTZ("k7/8/K7/P7/8/8/8/8 w - - 0 1"));
+
+    // The moves kept at the root all win
+    auto board = boardFor("8/8/2k5/8/8/8/8/KR6 w - - 0 1");
+    auto moves = ChessMoveGenerator::generateMoves(board);
+    ASSERT_TRUE(Tablebases::filterRootMoves(board, moves));
+    ASSERT_GT(moves.count, 0);
+    for (int index=0; index<moves.count; index++) {
+        auto newBoard = board;
+        newBoard.move(moves[index]);
+        Tablebases::WDL wdl;
+        ASSERT_TRUE(Tablebases::probeWDL(newBoard, wdl));
+        ASSERT_EQ(Tablebases::LOSS, wdl) << FPGN::to_string(moves[index]);
+    }
+}
+
+TEST_F(TablebasesTests, RealTablesMatchBitbases) {
+    if (!loadRealTables()) {
+        GTEST_SKIP() << "KQvK, KRvK or KPvK missing, set SYZYGY_PATH to a directory of the Syzygy tables";
+    }
+
+    // The bitbases are generated by the engine: both must agree on the outcome of every position
+    Bitbases bitbases;
+    ASSERT_TRUE(bitbases.generate({ "KQK", "KRK", "KPK" }));
+
+    std::mt19937 random(2026);
+    for (auto piece : { QUEEN, ROOK, PAWN }) {
+        int positions = 0;
+        while (positions < 10000) {
+            Square squares[3];
+            for (auto &square : squares) {
+                square = Square(random() % 64);
+            }
+            if (squares[0] == squares[1] || squares[0] == squares[2] || squares[1] == squares[2] ||
+                bb_test(KingMoves[squares[0]], squares[2]) || (piece == PAWN && (RankFrom(squares[1]) == 0 || RankFrom(squares[1]) == 7))) {
+                continue;
+            }
+            ChessBoard board;
+            board.clear();
+            board.castling = 0;
+            board.color = Color(random() % 2);
+            board.set({ false, WHITE, KING }, FileFrom(squares[0]), RankFrom(squares[0]));
+            board.set({ false, WHITE, piece }, FileFrom(squares[1]), RankFrom(squares[1]));
+            board.set({ false, BLACK, KING }, FileFrom(squares[2]), RankFrom(squares[2]));
+            if (board.isCheck(INVERSE(board.color))) {
+                continue;
+            }
+            positions++;
+
+            int outcome;
+            ASSERT_TRUE(bitbases.probe(board, outcome)) << FFEN::getFEN(board);
+            Tablebases::WDL wdl;
+            ASSERT_TRUE(Tablebases::probeWDL(board, wdl)) << FFEN::getFEN(board);
+            int whiteOutcome = (wdl > Tablebases::DRAW) - (wdl < Tablebases::DRAW);
+            ASSERT_EQ(outcome, board.color == WHITE ? whiteOutcome : -whiteOutcome) << FFEN::getFEN(board);
+        }
+    }
+}
@@ -0,0 +1,149 @@
+//
+//  TexelTunerTests.cpp
+//  BChessTests
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+
+#include "ChessEngine.hpp"
+#include "TexelTuner.hpp"
+#include "FFEN.hpp"
+
+#include <stdio.h>
+#include <fstream>
+
+class TexelTunerTests: public ::testing::Test {
+public:
+    void SetUp() {
+        ChessEngine::initialize();
+    }
+
+    void TearDown() {
+        ChessEvaluater::positionalAnalysis = false;
+        ChessEvaluater::setWeights(ChessEvaluater::DefaultWeights);
+    }
+
+    std::vector<double> currentWeights() {
+        auto values = (const int *)&ChessEvaluater::getWeights();
+        return std::vector<double>(values, values + ChessEvaluater::WeightCount);
+    }
+
+    int evaluate(std::string fen) {
+        ChessBoard board;
+        assert(FFEN::setFEN(fen, board));
+        AttackInfo info(board);
+        return ChessEvaluater::evaluatePosition(info);
+    }
+
+    std::string temporaryPath(std::string name) {
+        return std::string(P_tmpdir) + "/" + name;
+    }
+};
+
+static const char *Positions[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP3PPP/R2QKB1R w KQ - 0 8",
+    "8/2k5/3p4/p2P1p2/P4P2/1K6/8/8 w - - 0 1",
+    "4k3/8/8/3PP3/8/8/8/4K2R b K - 0 1",
+};
+
+TEST_F(TexelTunerTests, ParseResults) {
+    TexelTuner tuner;
+    ASSERT_TRUE(tuner.addPosition("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1 [1.0]"));
+    ASSERT_TRUE(tuner.addPosition("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - c9 \"1/2-1/2\";"));
+    ASSERT_TRUE(tuner.addPosition("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0-1"));
+    ASSERT_FALSE(tuner.addPosition("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq -"));
+    ASSERT_FALSE(tuner.addPosition("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - [2.0]"));
+    ASSERT_FALSE(tuner.addPosition(""));
+    ASSERT_EQ(3, tuner.count());
+}
+
+TEST_F(TexelTunerTests, TraceMatchesEvaluation) {
+    // The evaluation computed from the coefficients of the weights is the one of the evaluater,
+    // except for the rounding of the interpolation between the middlegame and the endgame.
+    for (bool positional : { false, true }) {
+        ChessEvaluater::positionalAnalysis = positional;
+
+        TexelTuner tuner;
+        for (auto fen : Positions) {
+            ASSERT_TRUE(tuner.addPosition(std::string(fen) + " [0.5]"));
+        }
+
+        auto weights = currentWeights();
+        for (size_t index=0; index<tuner.count(); index++) {
+            ASSERT_NEAR(evaluate(Positions[index]), tuner.evaluate(index, weights), 1.0) << Positions[index];
+        }
+    }
+}
+
+TEST_F(TexelTunerTests, SaveAndLoadWeights) {
+    auto path = temporaryPath("bchess-weights.txt");
+
+    auto weights = ChessEvaluater::DefaultWeights;
+    weights.pieceValue[ChessEvaluater::MIDDLEGAME][KNIGHT] = 333;
+    weights.positionBonus[ChessEvaluater::ENDGAME][KING][e4] = 42;
+    weights.passedPawn[6] = 123;
+    ASSERT_TRUE(weights.save(path));
+
+    auto loadedWeights = ChessEvaluater::DefaultWeights;
+    ASSERT_TRUE(loadedWeights.load(path));
+    ASSERT_EQ(0, memcmp(&weights, &loadedWeights, sizeof(weights)));
+
+    // The evaluation uses the new weights, which are flipped for black
+    ChessEvaluater::setWeights(loadedWeights);
+    ASSERT_EQ(42, ChessEvaluater::getBonus(KING, WHITE, e4, ChessEvaluater::ENDGAME));
+    ASSERT_EQ(42, ChessEvaluater::getBonus(KING, BLACK, e5, ChessEvaluater::ENDGAME));
+
+    // A file with a missing table is rejected
+    std::ifstream file(path);
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::ofstream truncatedFile(path);
+    truncatedFile << content.substr(0, content.find("PassedPawn"));
+    truncatedFile.close();
+
+    auto unchangedWeights = ChessEvaluater::DefaultWeights;
+    ASSERT_FALSE(unchangedWeights.load(path));
+    ASSERT_EQ(0, memcmp(&ChessEvaluater::DefaultWeights, &unchangedWeights, sizeof(unchangedWeights)));
+
+    remove(path.c_str());
+}
+
+TEST_F(TexelTunerTests, Tune) {
+    // White wins the positions where it has an extra knight, which is worth
+    // much more than the default weights say: the tuning must increase its value.
+    auto path = temporaryPath("bchess-positions.epd");
+    std::ofstream file(path);
+    for (int square=a3; square<=h6; square++) {
+        if (square == e4 || square == e5) {
+            continue;
+        }
+        ChessBoard board;
+        FFEN::setFEN("4k3/pppppppp/8/8/8/8/PPPPPPPP/4K3 w - - 0 1", board);
+        board.set({ false, WHITE, KNIGHT }, FileFrom(square), RankFrom(square));
+        file << FFEN::getFEN(board) << " [1.0]" << std::endl;
+        file << "4k3/pppppppp/8/8/8/8/PPPPPPPP/4K3 w - - 0 1 [0.5]" << std::endl;
+    }
+    file.close();
+
+    TexelTuner tuner;
+    tuner.threads = 2;
+    ASSERT_EQ(60, tuner.load(path));
+
+    auto initialError = tuner.error(currentWeights());
+    std::vector<double> errors;
+    auto weights = tuner.tune(50, [&](int epoch, double error, double positionsPerSecond) {
+        errors.push_back(error);
+    });
+    ASSERT_EQ(50, errors.size());
+    ASSERT_EQ(initialError, errors.front());
+    ASSERT_LT(errors.back(), errors.front());
+    ASSERT_GT(weights.pieceValue[ChessEvaluater::MIDDLEGAME][KNIGHT], ChessEvaluater::DefaultWeights.pieceValue[ChessEvaluater::MIDDLEGAME][KNIGHT]);
+
+    // The king is not tuned
+    ASSERT_EQ(ChessEvaluater::DefaultWeights.pieceValue[ChessEvaluater::MIDDLEGAME][KING], weights.pieceValue[ChessEvaluater::MIDDLEGAME][KING]);
+
+    remove(path.c_str());
+}
@@ -0,0 +1,229 @@
+//
+//  TranspositionTableTests.cpp
+//  BChessTests
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+
+#include "TranspositionTable.hpp"
+#include "EvalCache.hpp"
+
+// Two hashes that are stored at the same index in the table
+static const BoardHash hash1 = 123456789;
+static const BoardHash hash2 = hash1 + TRANSPO_SIZE;
+
+static const Move move1 = createMove(e2, e4, WHITE, PAWN);
+static const Move move2 = createMove(d2, d4, WHITE, PAWN);
+
+TEST(TranspositionTable, StoreAndLookup) {
+    TranspositionTable table;
+    table.store(4, hash1, -150, move1, TranspositionEntryType::BETA);
+    
+    TranspositionEntry entry;
+    ASSERT_TRUE(table.lookup(hash1, entry));
+    ASSERT_EQ(4, entry.depth);
+    ASSERT_EQ(-150, entry.value);
+    ASSERT_EQ(COMPACT_MOVE(move1), entry.bestMove);
+    ASSERT_EQ(TranspositionEntryType::BETA, entry.type);
+    
+    ASSERT_FALSE(table.lookup(hash2, entry));
+}
+
+TEST(TranspositionTable, SameSearchKeepsDeeperEntry) {
+    TranspositionTable table;
+    table.newSearch();
+    table.store(6, hash1, 10, move1, TranspositionEntryType::EXACT);
+    table.store(2, hash2, 20, move2, TranspositionEntryType::EXACT);
+    
+    TranspositionEntry entry;
+    ASSERT_TRUE(table.lookup(hash1, entry));
+    ASSERT_FALSE(table.lookup(hash2, entry));
+}
+
+TEST(TranspositionTable, NewSearchReplacesStaleEntry) {
+    TranspositionTable table;
+    table.newSearch();
+    table.store(6, hash1, 10, move1, TranspositionEntryType::EXACT);
+    
+    // The deeper entry of the previous search doesn't block the new one
+    table.newSearch();
+    table.store(2, hash2, 20, move2, TranspositionEntryType::EXACT);
+    
+    TranspositionEntry entry;
+    ASSERT_FALSE(table.lookup(hash1, entry));
+    ASSERT_TRUE(table.lookup(hash2, entry));
+    ASSERT_EQ(2, entry.depth);
+    ASSERT_EQ(20, entry.value);
+}
+
+TEST(TranspositionTable, LookupDoesNotRefreshEntry) {
+    TranspositionTable table;
+    table.newSearch();
+    table.store(6, hash1, 10, move1, TranspositionEntryType::EXACT);
+    
+    // The entry of the previous search is still available
+    // but reading it doesn't move it to the new search.
+    table.newSearch();
+    TranspositionEntry entry;
+    ASSERT_TRUE(table.lookup(hash1, entry));
+    ASSERT_EQ(6, entry.depth);
+    ASSERT_EQ(COMPACT_MOVE(move1), entry.bestMove);
+
+    table.store(2, hash2, 20, move2, TranspositionEntryType::EXACT);
+    ASSERT_FALSE(table.lookup(hash1, entry));
+    ASSERT_TRUE(table.lookup(hash2, entry));
+}
+
+TEST(TranspositionTable, StoreRefreshesEntry) {
+    TranspositionTable table;
+    table.newSearch();
+    table.store(6, hash1, 10, move1, TranspositionEntryType::EXACT);
+    
+    // Storing the entry again makes it belong to the new search
+    table.newSearch();
+    table.store(6, hash1, 10, move1, TranspositionEntryType::EXACT);
+    table.store(2, hash2, 20, move2, TranspositionEntryType::EXACT);
+    
+    TranspositionEntry entry;
+    ASSERT_TRUE(table.lookup(hash1, entry));
+    ASSERT_FALSE(table.lookup(hash2, entry));
+}
+
+TEST(TranspositionTable, GenerationWrapsAround) {
+    TranspositionTable table;
+    for (int index=0; index<20; index++) {
+        table.newSearch();
+    }
+    table.store(6, hash1, 10, move1, TranspositionEntryType::EXACT);
+    
+    // The generation of the table wraps around and becomes numerically smaller
+    // than the one of the entry, which is still older and so replaced.
+    for (int index=0; index<20; index++) {
+        table.newSearch();
+    }
+    table.store(2, hash2, 20, move2, TranspositionEntryType::EXACT);
+    
+    TranspositionEntry entry;
+    ASSERT_FALSE(table.lookup(hash1, entry));
+    ASSERT_TRUE(table.lookup(hash2, entry));
+}
+
+TEST(TranspositionTable, Clear) {
+    TranspositionTable table;
+    table.store(6, hash1, 10, move1, TranspositionEntryType::EXACT);
+    table.clear();
+    
+    TranspositionEntry entry;
+    ASSERT_FALSE(table.lookup(hash1, entry));
+}
+
+TEST(TranspositionTable, ResizeClears) {
+    TranspositionTable table(1000);
+    table.store(6, hash1, 10, move1, TranspositionEntryType::EXACT);
+    table.resize(500);
+    ASSERT_EQ(500, table.getSize());
+    
+    TranspositionEntry entry;
+    ASSERT_FALSE(table.lookup(hash1, entry));
+    
+    table.store(6, hash1, 10, move1, TranspositionEntryType::EXACT);
+    ASSERT_TRUE(table.lookup(hash1, entry));
+    ASSERT_EQ(10, entry.value);
+}
+
+TEST(TranspositionTable, ResizeGrows) {
+    TranspositionTable table(1000);
+    table.resize(2000);
+    ASSERT_EQ(2000, table.getSize());
+    
+    // The entries are spread over the whole table
+    table.store(6, 1999, 10, move1, TranspositionEntryType::EXACT);
+    table.store(6, 999, 20, move1, TranspositionEntryType::EXACT);
+    
+    TranspositionEntry entry;
+    ASSERT_TRUE(table.lookup(1999, entry));
+    ASSERT_EQ(10, entry.value);
+    ASSERT_TRUE(table.lookup(999, entry));
+    ASSERT_EQ(20, entry.value);
+}
+
+TEST(TranspositionTable, ResizeFailureKeepsTable) {
+    TranspositionTable table(1000);
+    table.store(6, hash1, 10, move1, TranspositionEntryType::EXACT);
+    
+    // Too large to be allocated: the current table is kept (and cleared)
+    table.resize(SIZE_MAX / sizeof(TranspositionSlot));
+    ASSERT_EQ(1000, table.getSize());
+    
+    // Same when the size in bytes overflows
+    table.resize(SIZE_MAX);
+    ASSERT_EQ(1000, table.getSize());
+    table.resizeMB(SIZE_MAX);
+    ASSERT_EQ(1000, table.getSize());
+    
+    TranspositionEntry entry;
+    ASSERT_FALSE(table.lookup(hash1, entry));
+    table.store(6, hash1, 10, move1, TranspositionEntryType::EXACT);
+    ASSERT_TRUE(table.lookup(hash1, entry));
+}
+
+TEST(TranspositionTable, AllocationFailure) {
+    // The table is empty but can still be used
+    TranspositionTable table(SIZE_MAX / sizeof(TranspositionSlot));
+    ASSERT_EQ(0, table.getSize());
+    
+    table.store(6, hash1, 10, move1, TranspositionEntryType::EXACT);
+    TranspositionEntry entry;
+    ASSERT_FALSE(table.lookup(hash1, entry));
+    table.clear();
+    
+    table.resize(1000);
+    ASSERT_EQ(1000, table.getSize());
+    table.store(6, hash1, 10, move1, TranspositionEntryType::EXACT);
+    ASSERT_TRUE(table.lookup(hash1, entry));
+}
+
+TEST(TranspositionTable, ParallelClear) {
+    TranspositionTable table;
+    table.store(6, hash1, 10, move1, TranspositionEntryType::EXACT);
+    table.store(6, TRANSPO_SIZE - 1, 10, move1, TranspositionEntryType::EXACT);
+    ASSERT_GE(table.clear(), 0);
+    
+    TranspositionEntry entry;
+    ASSERT_FALSE(table.lookup(hash1, entry));
+    ASSERT_FALSE(table.lookup(TRANSPO_SIZE - 1, entry));
+}
+
+TEST(EvalCache, StoreAndLookup) {
+    EvalCache cache(1000);
+    cache.store(hash1, -150);
+    
+    int value;
+    ASSERT_TRUE(cache.lookup(hash1, value));
+    ASSERT_EQ(-150, value);
+    ASSERT_FALSE(cache.lookup(hash1 + 1000, value));
+    
+    // The most recent evaluation replaces the one stored at the same index
+    cache.store(hash1 + 1000, 100000);
+    ASSERT_FALSE(cache.lookup(hash1, value));
+    ASSERT_TRUE(cache.lookup(hash1 + 1000, value));
+    ASSERT_EQ(100000, value);
+    
+    cache.clear();
+    ASSERT_FALSE(cache.lookup(hash1 + 1000, value));
+}
+
+TEST(EvalCache, Disabled) {
+    EvalCache cache;
+    ASSERT_EQ(0, cache.getSize());
+    cache.store(hash1, 10);
+    
+    int value;
+    ASSERT_FALSE(cache.lookup(hash1, value));
+    
+    cache.resize(10);
+    cache.store(hash1, 10);
+    ASSERT_TRUE(cache.lookup(hash1, value));
+}
@@ -29,7 +29,13 @@ typedef NS_ENUM(NSInteger, Direction){
 @property (nonatomic, assign) BOOL async;
 @property (nonatomic, assign) BOOL useOpeningBook;
 @property (nonatomic, assign) BOOL positionalAnalysis;
+@property (nonatomic, assign) BOOL neuralEvaluation;
 @property (nonatomic, assign) BOOL ttEnabled;
+@property (nonatomic, assign) BOOL probCut;
+@property (nonatomic, assign) BOOL tablebases;
+@property (nonatomic, assign) NSUInteger multiPV;
+@property (nonatomic, assign) NSUInteger threads;
+@property (nonatomic, assign) NSUInteger tablebaseProbeDepth;
 @property (nonatomic, assign) NSUInteger searchDepth;
 @property (nonatomic, assign) NSTimeInterval thinkingTime;
 
@@ -48,6 +54,39 @@ typedef NS_ENUM(NSInteger, Direction){
 - (BOOL)isValidOpeningMoves;
 - (NSString* _Nullable)openingName;
 
+// Prepares the engine for a new game by clearing the analysis of the previous game.
+// Returns the time it took to clear the transposition table.
+- (NSTimeInterval)newGame;
+
+// Changes the size of the transposition table, in megabytes.
+// Returns the time it took to resize the table.
+- (NSTimeInterval)setHashSize:(NSUInteger)megabytes;
+
+// Loads the weights of the neural network used for the evaluation when neuralEvaluation is set.
+// Returns NO if the file cannot be read or is not a valid network.
+- (BOOL)loadNeuralNetwork:(NSString* _Nonnull)path;
+
+// Loads the Syzygy endgame tablebases found in the directories of the path, separated by ':'.
+// Returns the number of WDL tables found.
+- (NSUInteger)loadTablebases:(NSString* _Nonnull)path;
+
+// Loads the bitbases of a file created by generateBitbases.
+- (BOOL)loadBitbases:(NSString* _Nonnull)path;
+
+// Generates the bitbases of the signatures, like KPK or KBNK, and saves them to a file,
+// the progress being reported to the callback. This method is synchronous.
+- (BOOL)generateBitbases:(NSArray<NSString*>* _Nonnull)signatures path:(NSString* _Nonnull)path progress:(void(^ _Nonnull)(NSString* _Nonnull))progress;
+
+// Loads the weights of the hand-crafted evaluation from a file created by tuneEvaluation.
+- (BOOL)loadEvaluationWeights:(NSString* _Nonnull)path;
+
+// Tunes the weights of the hand-crafted evaluation with a file of positions labelled with the result of their game
+// and saves them in a file, the progress being reported to the callback. This method is synchronous.
+- (BOOL)tuneEvaluation:(NSString* _Nonnull)positionsPath weightsPath:(NSString* _Nonnull)weightsPath epochs:(NSUInteger)epochs progress:(void(^ _Nonnull)(NSString* _Nonnull))progress;
+
+// Measures the number of evaluations per second of the hand-crafted evaluation and of the neural network.
+- (NSString* _Nonnull)benchmarkEvaluation;
+
 - (BOOL)setFEN:(NSString* _Nonnull)FEN;
 - (NSString* _Nonnull)FEN;
 
@@ -82,6 +121,13 @@ typedef NS_ENUM(NSInteger, Direction){
 
 - (BOOL)isAnalyzing;
 
+// Returns YES if the engine is searching on the opponent's time
+- (BOOL)isPondering;
+
+// The opponent played the expected move: the search started with ponder
+// continues as a regular search limited by the time specified when it started.
+- (void)ponderhit;
+
 - (BOOL)isWhite;
 
 - (BOOL)canPlay;
@@ -92,4 +138,8 @@ typedef NS_ENUM(NSInteger, Direction){
 - (void)evaluate:(NSInteger)depth callback:(FEngineSearchCallback _Nonnull)callback;
 - (void)evaluate:(NSInteger)depth time:(NSTimeInterval)time callback:(FEngineSearchCallback _Nonnull)callback;
 
+// When ponder is YES, the current position already contains the expected move of the opponent and the
+// search doesn't complete until ponderhit or stop is called. The time only starts counting after ponderhit.
+- (void)evaluate:(NSInteger)depth time:(NSTimeInterval)time ponder:(BOOL)ponder callback:(FEngineSearchCallback _Nonnull)callback;
+
 @end
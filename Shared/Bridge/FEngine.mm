@@ -31,6 +31,9 @@
 // avoid firing an update if the engine has been cancelled.
 @property (nonatomic, assign) NSUInteger stateIndex;
 
+// The time allotted to think once the opponent played the expected move (ponderhit).
+@property (nonatomic, assign) NSTimeInterval ponderTime;
+
 @end
 
 @implementation FEngine
@@ -49,6 +52,12 @@
     if (self = [super init]) {
         _async = YES;
         _ttEnabled = NO;
+        _probCut = NO;
+        _tablebases = NO;
+        _neuralEvaluation = NO;
+        _multiPV = 1;
+        _threads = 1;
+        _tablebaseProbeDepth = 1;
         _searchDepth = INT_MAX;
         _thinkingTime = 5;
         _stateIndex = 0;
@@ -86,6 +95,53 @@
 
 #pragma mark -
 
+- (NSTimeInterval)newGame {
+    self.stateIndex += 1;
+    return engine.newGame() / 1000.0;
+}
+
+- (NSTimeInterval)setHashSize:(NSUInteger)megabytes {
+    return engine.setHashSize(megabytes) / 1000.0;
+}
+
+- (BOOL)loadNeuralNetwork:(NSString *)path {
+    return engine.loadNeuralNetwork(StringFromNSString(path));
+}
+
+- (NSUInteger)loadTablebases:(NSString *)path {
+    return engine.loadTablebases(StringFromNSString(path));
+}
+
+- (BOOL)loadBitbases:(NSString *)path {
+    return engine.loadBitbases(StringFromNSString(path));
+}
+
+- (BOOL)generateBitbases:(NSArray<NSString *> *)signatures path:(NSString *)path progress:(void (^)(NSString *))progress {
+    std::vector<std::string> strings;
+    for (NSString *signature in signatures) {
+        strings.push_back(StringFromNSString(signature));
+    }
+    return engine.generateBitbases(strings, StringFromNSString(path), [progress](std::string message) {
+        progress(NSStringFromString(message));
+    });
+}
+
+- (BOOL)loadEvaluationWeights:(NSString *)path {
+    return engine.loadEvaluationWeights(StringFromNSString(path));
+}
+
+- (BOOL)tuneEvaluation:(NSString *)positionsPath weightsPath:(NSString *)weightsPath epochs:(NSUInteger)epochs progress:(void (^)(NSString *))progress {
+    return engine.tuneEvaluation(StringFromNSString(positionsPath), StringFromNSString(weightsPath), (int)epochs, [progress](std::string message) {
+        progress(NSStringFromString(message));
+    });
+}
+
+- (NSString*)benchmarkEvaluation {
+    auto benchmark = engine.benchmarkEvaluation();
+    return [NSString stringWithFormat:@"hand-crafted %.0f evals/s, nnue refresh %.0f evals/s, nnue incremental %.0f evals/s",
+            benchmark.handCrafted, benchmark.neuralRefresh, benchmark.neuralIncremental];
+}
+
 - (BOOL)setFEN:(NSString *)FEN {
     return engine.setFEN(StringFromNSString(FEN));
 }
@@ -137,27 +193,35 @@
     return NSStringFromString(engine.getPGNForDisplay());
 }
 
+// board: the board on which the moves of the variations of the node are played
 - (void)moveNodesFromNode:(ChessGame::MoveNode)node
+                    board:(ChessBoard)board
                  mainLine:(FEngineMoveNode*)mainLine {
     FEngineMoveNode *mainLineNodeWithVariants = nil;
     for (int index=0; index<node.variations.size(); index++) {
         auto child = node.variations[index];
-        auto childNode = [[FEngineMoveNode alloc] initWithNode:child];
+        auto move = board.decodeMove(child.move);
+        auto childNode = [[FEngineMoveNode alloc] initWithNode:child move:move];
+        auto childBoard = board;
+        childBoard.move(move);
         if (index == 0) {
             mainLineNodeWithVariants = childNode;
             [mainLine addVariation:childNode];
-            [self moveNodesFromNode:child mainLine:mainLine];
+            [self moveNodesFromNode:child board:childBoard mainLine:mainLine];
         } else {
             [mainLineNodeWithVariants addVariation:childNode];
-            [self moveNodesFromNode:child mainLine:childNode];
+            [self moveNodesFromNode:child board:childBoard mainLine:childNode];
         }
     }
 }
 
 - (NSArray<FEngineMoveNode*>*)moveNodesTree {
+    ChessBoard board;
+    FFEN::setFEN(engine.game().initialFEN, board);
+    
     auto root = engine.getRootMoveNode();
-    FEngineMoveNode *rootNode = [[FEngineMoveNode alloc] initWithNode:root];
-    [self moveNodesFromNode:root mainLine:rootNode];
+    FEngineMoveNode *rootNode = [[FEngineMoveNode alloc] initWithNode:root move:INVALID_MOVE];
+    [self moveNodesFromNode:root board:board mainLine:rootNode];
     return rootNode.variations;
 }
 
@@ -283,11 +347,17 @@
 }
 
 - (void)evaluate:(NSInteger)depth time:(NSTimeInterval)time callback:(FEngineSearchCallback)callback {
+    [self evaluate:depth time:time ponder:NO callback:callback];
+}
+
+- (void)evaluate:(NSInteger)depth time:(NSTimeInterval)time ponder:(BOOL)ponder callback:(FEngineSearchCallback)callback {
     [self cancel];
     
     NSUInteger localStateIndex = self.stateIndex;
     
-    if (self.useOpeningBook) {
+    // Note: the opening book is not used when pondering because the best move
+    // must not be returned before the opponent actually plays the expected move.
+    if (self.useOpeningBook && !ponder) {
         FEngineInfo *info = [self lookupOpeningMove];
         if (info) {
             callback(info, YES);
@@ -296,10 +366,11 @@
         }
     }
     
-    if (time > 0) {
-        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(time * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
-            [self stop];
-        });
+    // When pondering, the time allotted to think only starts after ponderhit
+    engine.setPondering(ponder);
+    self.ponderTime = ponder ? time : 0;
+    if (time > 0 && !ponder) {
+        [self stopAfter:time];
     }
 
     if (self.async) {
@@ -317,6 +388,23 @@
     }
 }
 
+- (void)stopAfter:(NSTimeInterval)time {
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(time * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        [self stop];
+    });
+}
+
+- (void)ponderhit {
+    engine.ponderhit();
+    if (self.ponderTime > 0) {
+        [self stopAfter:self.ponderTime];
+    }
+}
+
+- (BOOL)isPondering {
+    return engine.pondering();
+}
+
 - (FEngineInfo*)lookupOpeningMove {
     ChessEvaluation evaluation;
     if (engine.lookupOpeningMove(evaluation)) {
@@ -329,7 +417,13 @@
 - (void)searchBestMove:(NSInteger)maxDepth callback:(FEngineSearchCallback)callback {
     // TODO ??
     ChessEvaluater::positionalAnalysis = self.positionalAnalysis;
+    ChessEvaluater::neuralEvaluation = self.neuralEvaluation;
     engine.transpositionTable = self.ttEnabled;
+    engine.probCut = self.probCut;
+    engine.multiPV = (int)self.multiPV;
+    engine.threads = (int)self.threads;
+    engine.tablebases = self.tablebases;
+    engine.tablebaseProbeDepth = (int)self.tablebaseProbeDepth;
     
     engine.searchBestMove((int)maxDepth, [self, callback](ChessEvaluation evaluation, bool done) {
         callback([self infoFor:evaluation], done);
@@ -26,9 +26,28 @@
 @property (nonatomic, assign, readonly) NSInteger nodeEvaluated;
 @property (nonatomic, assign, readonly) NSInteger movesPerSecond;
 
+// Percentage of the pawn hash table lookups that were hits during the search
+@property (nonatomic, assign, readonly) NSInteger pawnTableHitRate;
+
+// Number of evaluations found or not in the evaluation cache during the last iteration
+@property (nonatomic, assign, readonly) NSInteger evalCacheHits;
+@property (nonatomic, assign, readonly) NSInteger evalCacheMisses;
+
+// Number of positions found in the endgame tablebases during the last iteration
+@property (nonatomic, assign, readonly) NSInteger tablebaseHits;
+
 @property (nonatomic, assign, readonly) NSInteger value;
 
+// Number of best lines available (more than one when searching with MultiPV)
+@property (nonatomic, assign, readonly) NSUInteger variationCount;
+
 - (NSString* _Nullable)bestMove:(BOOL)uci;
 - (NSString* _Nonnull)bestLine:(BOOL)uci;
 
+// The expected reply of the opponent, that is, the second move of the best line
+- (NSString* _Nullable)ponderMove:(BOOL)uci;
+
+- (NSInteger)variationValue:(NSUInteger)index;
+- (NSString* _Nonnull)variationLine:(NSUInteger)index uci:(BOOL)uci;
+
 @end
@@ -37,6 +37,22 @@
     return self.info.movesPerSecond;
 }
 
+- (NSInteger)pawnTableHitRate {
+    return self.info.pawnTableHitRate;
+}
+
+- (NSInteger)evalCacheHits {
+    return self.info.evalCacheHits;
+}
+
+- (NSInteger)evalCacheMisses {
+    return self.info.evalCacheMisses;
+}
+
+- (NSInteger)tablebaseHits {
+    return self.info.tablebaseHits;
+}
+
 - (NSInteger)value {
     return self.info.value;
 }
@@ -84,11 +100,35 @@
     return NSStringFromString(FPGN::to_string((Move)self.bestMove, type));
 }
 
+- (NSString*)ponderMove:(BOOL)uci {
+    if (self.info.line.count < 2) {
+        return nil;
+    }
+    FPGN::SANType type = uci ? FPGN::SANType::uci : FPGN::SANType::full;
+    return NSStringFromString(FPGN::to_string(self.info.line[1], type));
+}
+
 - (NSString*)bestLine:(BOOL)uci {
+    return [self line:self.info.line uci:uci];
+}
+
+- (NSUInteger)variationCount {
+    return self.info.variations.size();
+}
+
+- (NSInteger)variationValue:(NSUInteger)index {
+    return self.info.variations[index].value;
+}
+
+- (NSString*)variationLine:(NSUInteger)index uci:(BOOL)uci {
+    return [self line:self.info.variations[index].line uci:uci];
+}
+
+- (NSString*)line:(MoveList)moves uci:(BOOL)uci {
     if (uci) {
         NSMutableString *line = [NSMutableString string];
-        for (int index=0; index<self.info.line.count; index++) {
-            Move move = self.info.line[index];
+        for (int index=0; index<moves.count; index++) {
+            Move move = moves[index];
             if (line.length > 0) {
                 [line appendString:@" "];
             }
@@ -103,8 +143,8 @@
         // Copy the current game and play the best line.
         ChessGame lineGame = self.game;
         lineGame.history = NEW_HISTORY; // TODO hack to avoid coping the history from self.game and got it overwritten here
-        for (int index=0; index<self.info.line.count; index++) {
-            Move move = self.info.line[index];
+        for (int index=0; index<moves.count; index++) {
+            Move move = moves[index];
             lineGame.move(move, "", false);
         }
 
@@ -24,7 +24,7 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, strong, readwrite) NSString * _Nonnull comment;
 @property (nonatomic, strong, readwrite) NSMutableArray<FEngineMoveNode*> * _Nonnull variations;
 
-- (instancetype)initWithNode:(ChessGame::MoveNode)node;
+- (instancetype)initWithNode:(ChessGame::MoveNode)node move:(Move)move;
 
 - (void)addVariation:(FEngineMoveNode*)node;
 
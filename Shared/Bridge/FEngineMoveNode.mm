@@ -15,16 +15,17 @@
 
 @implementation FEngineMoveNode
 
-- (instancetype)initWithNode:(ChessGame::MoveNode)node {
+// move: the full move of the node, decoded with the board on which it is played
+- (instancetype)initWithNode:(ChessGame::MoveNode)node move:(Move)move {
     if (self = [super init]) {
         self.moveNumber = node.moveNumber;
-        self.whiteMove = MOVE_COLOR(node.move) == WHITE;
-        self.fromFile = FileFrom(MOVE_FROM(node.move));
-        self.fromRank = RankFrom(MOVE_FROM(node.move));
-        self.toFile = FileFrom(MOVE_TO(node.move));
-        self.toRank = RankFrom(MOVE_TO(node.move));
+        self.whiteMove = MOVE_COLOR(move) == WHITE;
+        self.fromFile = FileFrom(MOVE_FROM(move));
+        self.fromRank = RankFrom(MOVE_FROM(move));
+        self.toFile = FileFrom(MOVE_TO(move));
+        self.toRank = RankFrom(MOVE_TO(move));
         self.uuid = node.uuid;
-        self.name = NSStringFromString(FPGN::to_string(node.move, FPGN::SANType::tight));
+        self.name = NSStringFromString(FPGN::to_string(move, FPGN::SANType::tight));
         self.comment = NSStringFromString(node.comment);
         self.variations = [NSMutableArray array];
     }
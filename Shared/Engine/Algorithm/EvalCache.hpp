@@ -0,0 +1,86 @@
+//
+//  EvalCache.hpp
+//  BChess
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#pragma once
+
+#include "Types.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+// Cache of the static evaluations, indexed by the Zobrist key of the board. The same
+// positions are evaluated again at each iteration of the iterative deepening and through
+// the transpositions of the quiescence search, this cache avoids evaluating them from scratch.
+// https://www.chessprogramming.org/Evaluation_Hash_Table
+// Note: like the transposition table, the key is stored xor'ed with the value so
+// the cache can be shared by several threads without any lock: a slot written
+// concurrently by another thread doesn't match the hash anymore and is a miss.
+class EvalCache {
+    struct EvalSlot {
+        BoardHash key;
+        uint64_t data;
+    };
+
+    EvalSlot *table = nullptr;
+    size_t size = 0;
+
+public:
+    EvalCache(size_t size = 0) {
+        resize(size);
+    }
+
+    ~EvalCache() {
+        free(table);
+    }
+
+    EvalCache(const EvalCache&) = delete;
+    EvalCache& operator=(const EvalCache&) = delete;
+
+    size_t getSize() {
+        return size;
+    }
+
+    // Changes the number of entries of the cache, which also clears it.
+    // A size of zero disables the cache.
+    void resize(size_t newSize) {
+        free(table);
+        table = newSize > 0 ? (EvalSlot*)calloc(newSize, sizeof(EvalSlot)) : nullptr;
+        size = newSize;
+    }
+
+    void clear() {
+        if (table) {
+            memset(table, 0, size * sizeof(EvalSlot));
+        }
+    }
+
+    // Returns true if the evaluation of the position is in the cache
+    bool lookup(BoardHash hash, int &value) {
+        if (size == 0) {
+            return false;
+        }
+        EvalSlot slot = table[hash % size];
+        if (slot.key != 0 && (slot.key ^ slot.data) == hash) {
+            value = (int)(int32_t)(uint32_t)slot.data;
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    // The slot is always replaced because the most recent evaluations are the most likely to be reused
+    void store(BoardHash hash, int value) {
+        if (size == 0) {
+            return;
+        }
+        uint64_t data = (uint32_t)value;
+        auto &slot = table[hash % size];
+        slot.key = hash ^ data;
+        slot.data = data;
+    }
+};
@@ -11,8 +11,14 @@
 #include "ChessEvaluation.hpp"
 #include "ChessEvaluater.hpp"
 #include "TranspositionTable.hpp"
+#include "EvalCache.hpp"
+#include "MinMaxSearch.hpp"
 
 #include <chrono>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
 using namespace std::chrono;
 
 class TimeManagement {
@@ -45,23 +51,67 @@ public:
 
     TranspositionTable table;
 
+    // Cache of the static evaluations shared by all the searches, sized by minMaxSearch.config
+    EvalCache evalCache;
+    
     enum class Status {
         running,
         stopped,
         cancelled
     };
     
-    Status status = Status::stopped;
+    // Written by stop() and cancel(), usually from another thread than the one searching
+    std::atomic<Status> status { Status::stopped };
+    
+    // Number of best lines to search for (MultiPV). When greater than one,
+    // each root move is searched separately to get its own score.
+    int multiPV = 1;
+    
+    // Number of threads used to search the root moves in parallel. Any value greater
+    // than one searches the root moves separately, like when multiPV is greater than one.
+    int threads = 1;
+    
+    // When pondering (searching on the opponent's time), the search does not complete,
+    // even if the maximum depth is reached, until ponderhit() or stop() is called.
+    std::atomic<bool> pondering { false };
     
     ChessEvaluation search(ChessBoard board, HistoryPtr history, int maxDepth, SearchCallback callback) {
         if (maxDepth == -1) {
             maxDepth = INT_MAX; // infinite depth
         }
         
+        // Only one search at a time can use the transposition table
+        std::lock_guard<std::mutex> lock(searchMutex);
+        
+        // The entries of the previous searches are kept but
+        // are going to be replaced first by the new search.
+        table.newSearch();
+        minMaxSearch.ordering.clear();
+        ChessEvaluater::pawnTable().resetStats();
+        prepareEvalCache();
+        
+        // In a position of the endgame tablebases, only the moves that preserve the
+        // outcome are searched, the search deciding which one of these to play.
+        auto moves = ChessMoveGenerator::generateMoves(board);
+        bool filtered = false;
+        rootTablebaseHits = 0;
+        if (minMaxSearch.config.tablebases && moves.count > 0 && Tablebases::canProbe(board)) {
+            int count = moves.count;
+            if (Tablebases::filterRootMoves(board, moves)) {
+                rootTablebaseHits = count;
+                filtered = moves.count < count;
+            }
+        }
+        
+        if ((multiPV > 1 || threads > 1 || filtered) && moves.count > 0) {
+            return searchRootMoves(board, history, moves, maxDepth, callback);
+        }
+        
         ChessEvaluation evaluation;
         MinMaxSearch::Variation bestVariation;
 
         status = Status::running;
+        minMaxSearch.start();
         
         for (int curMaxDepth=1; curMaxDepth<=maxDepth && running(); curMaxDepth++) {
             TimeManagement moveClock;
@@ -78,6 +128,7 @@ public:
             
 //            int percentCollision = (float)table.collisionCount / table.storeCount * 100;
 //            std::cout << "Entry count = " << table.storeCount << ", collision = " << table.collisionCount << " (" << percentCollision << "%)" << ", new = " << table.newStoreCount << std::endl;
+//            std::cout << "Eval cache hits = " << minMaxSearch.evalCacheHits << ", misses = " << minMaxSearch.evalCacheMisses << std::endl;
 
             double movesPerSingleMs = minMaxSearch.visitedNodes / moveClock.elapsedMilli();
             int movesPerSecond = int(movesPerSingleMs * 1e3);
@@ -96,12 +147,21 @@ public:
                 evaluation.depth = pv.depth;
                 evaluation.quiescenceDepth = pv.qsDepth;
 
-                evaluation.line.push(pv.moves);
+                evaluation.line = pv.moves.decode(board);
+                
+                ChessEvaluation::Variation variation;
+                variation.line = evaluation.line;
+                variation.value = score;
+                evaluation.variations.push_back(variation);
                 
                 evaluation.nodes = minMaxSearch.visitedNodes;
                 evaluation.time = int(moveClock.elapsedMilli()/1e3);
                 evaluation.engineColor = board.color;
                 evaluation.movesPerSecond = movesPerSecond;
+                evaluation.pawnTableHitRate = ChessEvaluater::pawnTable().hitRate();
+                evaluation.evalCacheHits = minMaxSearch.evalCacheHits;
+                evaluation.evalCacheMisses = minMaxSearch.evalCacheMisses;
+                evaluation.tablebaseHits = rootTablebaseHits + minMaxSearch.tablebaseHits;
             }
             
             if (callback) {
@@ -115,6 +175,8 @@ public:
             }
         }
         
+        waitForPonderhit();
+        
         if (running()) {
             status = Status::stopped;
         }
@@ -130,14 +192,274 @@ public:
         return status == Status::cancelled;
     }
 
+    // Removes all the entries of the transposition table. Any search running
+    // must have been stopped or cancelled: this method waits for it to return.
+    // Returns the time in milliseconds it took to clear the table.
+    double clear() {
+        std::lock_guard<std::mutex> lock(searchMutex);
+        evalCache.clear();
+        return table.clear();
+    }
+    
+    // Resizes the transposition table to the specified amount of memory in megabytes,
+    // which also clears it. Returns the time in milliseconds it took.
+    double resizeTable(size_t megabytes) {
+        std::lock_guard<std::mutex> lock(searchMutex);
+        return table.resizeMB(megabytes);
+    }
+    
+    // The opponent played the expected move: the search continues as a regular search
+    // (the caller is responsible to stop it when the time allotted is over).
+    void ponderhit() {
+        pondering = false;
+    }
+    
     void stop() {
         status = Status::stopped;
         minMaxSearch.cancel();
+        cancelWorkers();
     }
     
     void cancel() {
         status = Status::cancelled;
         minMaxSearch.cancel();
+        cancelWorkers();
+    }
+
+private:
+    
+    struct RootMove {
+        Move move = INVALID_MOVE;
+        
+        // Score from the point of view of the side to move at the root.
+        int score = -INT_MAX;
+        
+        // False when the score is only an upper bound, which happens when the move
+        // cannot be part of the best lines.
+        bool exact = false;
+        
+        MinMaxSearch::Variation pv;
+    };
+    
+    // Locked for the whole duration of a search
+    std::mutex searchMutex;
+    
+    // Version of the evaluation (see ChessEvaluater::evaluationVersion()) when the evaluation cache was filled
+    int evalCacheVersion = 0;
+    
+    // Number of root moves probed in the endgame tablebases
+    int rootTablebaseHits = 0;
+    
+    // One search per worker thread, each one with its own visited nodes count.
+    // Note: the searches are not movable (because of their atomic analyzing flag).
+    std::vector<std::unique_ptr<MinMaxSearch>> workers;
+    std::mutex workersMutex;
+    
+    // Resizes the evaluation cache if its size has been changed in the configuration. The cache
+    // is kept from one search to another but it is cleared when the evaluation function changes.
+    void prepareEvalCache() {
+        if (evalCache.getSize() != minMaxSearch.config.evalCacheSize) {
+            evalCache.resize(minMaxSearch.config.evalCacheSize);
+        } else if (evalCacheVersion != ChessEvaluater::evaluationVersion()) {
+            evalCache.clear();
+        }
+        evalCacheVersion = ChessEvaluater::evaluationVersion();
+        minMaxSearch.evalCache = evalCache.getSize() > 0 ? &evalCache : nullptr;
+    }
+    
+    void waitForPonderhit() {
+        while (pondering && running()) {
+            std::this_thread::sleep_for(milliseconds(1));
+        }
+    }
+    
+    void cancelWorkers() {
+        std::lock_guard<std::mutex> lock(workersMutex);
+        for (auto &worker : workers) {
+            worker->cancel();
+        }
+    }
+    
+    // Returns the score a move must exceed to be part of the best lines,
+    // or -INT_MAX if there are not yet enough moves with an exact score.
+    static int lineThreshold(std::vector<RootMove> &rootMoves, int lineCount) {
+        std::vector<int> scores;
+        for (auto &rootMove : rootMoves) {
+            if (rootMove.exact) {
+                scores.push_back(rootMove.score);
+            }
+        }
+        if ((int)scores.size() < lineCount) {
+            return -INT_MAX;
+        }
+        std::nth_element(scores.begin(), scores.begin() + lineCount - 1, scores.end(), std::greater<int>());
+        return scores[lineCount - 1];
+    }
+    
+    // Search each root move separately, optionally splitting them across worker threads, in order
+    // to return the multiPV best lines, each one with its own score. The moves that cannot be part
+    // of the best lines are searched with a window raised to the worst of the best lines found so far.
+    // https://www.chessprogramming.org/Multi-PV
+    ChessEvaluation searchRootMoves(ChessBoard board, HistoryPtr history, MoveList moves, int maxDepth, SearchCallback callback) {
+        ChessEvaluation evaluation;
+        
+        ChessMoveGenerator::sortMoves(board, moves);
+        
+        std::vector<RootMove> rootMoves;
+        for (int index=0; index<moves.count; index++) {
+            RootMove rootMove;
+            rootMove.move = moves[index];
+            rootMoves.push_back(rootMove);
+        }
+        
+        int lineCount = std::min(std::max(multiPV, 1), (int)rootMoves.size());
+        int workerCount = std::min(std::max(threads, 1), (int)rootMoves.size());
+        int color = board.color == WHITE ? 1 : -1;
+
+        {
+            std::lock_guard<std::mutex> lock(workersMutex);
+            workers.clear();
+            for (int index=0; index<workerCount; index++) {
+                workers.push_back(std::unique_ptr<MinMaxSearch>(new MinMaxSearch()));
+            }
+        }
+        
+        status = Status::running;
+        {
+            std::lock_guard<std::mutex> lock(workersMutex);
+            for (auto &worker : workers) {
+                worker->start();
+            }
+        }
+        
+        for (int curMaxDepth=1; curMaxDepth<=maxDepth && running(); curMaxDepth++) {
+            TimeManagement moveClock;
+            moveClock.start();
+            
+            {
+                std::lock_guard<std::mutex> lock(workersMutex);
+                for (auto &worker : workers) {
+                    worker->config = minMaxSearch.config;
+                    worker->config.maxDepth = curMaxDepth;
+                    worker->evalCache = minMaxSearch.evalCache;
+                    worker->reset();
+                }
+            }
+            
+            // The scores are re-computed at each depth but the principal variation
+            // of the previous depth is kept to be searched first.
+            std::vector<RootMove> results = rootMoves;
+            for (auto &rootMove : results) {
+                rootMove.score = -INT_MAX;
+                rootMove.exact = false;
+            }
+            
+            std::atomic<int> nextIndex(0);
+            std::mutex resultsMutex;
+            int threshold = -INT_MAX;
+            
+            auto work = [&](MinMaxSearch &worker) {
+                // Each worker needs its own history because it is modified during the search
+                HistoryPtr workerHistory = std::make_shared<std::vector<BoardHash>>(*history);
+                
+                int index;
+                while (running() && (index = nextIndex++) < (int)results.size()) {
+                    int alpha;
+                    MinMaxSearch::Variation bv;
+                    {
+                        std::lock_guard<std::mutex> lock(resultsMutex);
+                        alpha = threshold;
+                        bv = results[index].pv;
+                    }
+                    
+                    MinMaxSearch::Variation pv;
+                    int score = worker.searchRootMove(board, workerHistory, table, results[index].move, alpha, pv, bv);
+                    
+                    std::lock_guard<std::mutex> lock(resultsMutex);
+                    results[index].score = score;
+                    results[index].exact = score > alpha;
+                    results[index].pv = pv;
+                    threshold = lineThreshold(results, lineCount);
+                }
+            };
+            
+            std::vector<std::thread> workerThreads;
+            for (int index=1; index<workerCount; index++) {
+                workerThreads.push_back(std::thread(work, std::ref(*workers[index])));
+            }
+            work(*workers[0]);
+            for (auto &thread : workerThreads) {
+                thread.join();
+            }
+            
+            moveClock.stop();
+            
+            if (status == Status::cancelled) {
+                break;
+            }
+            
+            if (running()) {
+                // Rank the moves by score, the exact scores first in case of equality
+                std::stable_sort(results.begin(), results.end(), [](const RootMove &a, const RootMove &b) {
+                    if (a.score != b.score) {
+                        return a.score > b.score;
+                    }
+                    return a.exact && !b.exact;
+                });
+                rootMoves = results;
+                
+                int visitedNodes = 0;
+                int evalCacheHits = 0;
+                int evalCacheMisses = 0;
+                int tablebaseHits = rootTablebaseHits;
+                for (auto &worker : workers) {
+                    visitedNodes += worker->visitedNodes;
+                    evalCacheHits += worker->evalCacheHits;
+                    evalCacheMisses += worker->evalCacheMisses;
+                    tablebaseHits += worker->tablebaseHits;
+                }
+                
+                double movesPerSingleMs = visitedNodes / moveClock.elapsedMilli();
+                
+                evaluation.clear();
+                
+                auto &best = rootMoves[0];
+                
+                // Note: the evaluation is always from white's point of view
+                evaluation.value = best.score * color;
+                evaluation.depth = best.pv.depth;
+                evaluation.quiescenceDepth = best.pv.qsDepth;
+                evaluation.line = best.pv.moves.decode(board);
+                
+                for (int index=0; index<lineCount; index++) {
+                    ChessEvaluation::Variation variation;
+                    variation.line = rootMoves[index].pv.moves.decode(board);
+                    variation.value = rootMoves[index].score * color;
+                    evaluation.variations.push_back(variation);
+                }
+                
+                evaluation.nodes = visitedNodes;
+                evaluation.time = int(moveClock.elapsedMilli()/1e3);
+                evaluation.engineColor = board.color;
+                evaluation.movesPerSecond = int(movesPerSingleMs * 1e3);
+                evaluation.pawnTableHitRate = ChessEvaluater::pawnTable().hitRate();
+                evaluation.evalCacheHits = evalCacheHits;
+                evaluation.evalCacheMisses = evalCacheMisses;
+                evaluation.tablebaseHits = tablebaseHits;
+            }
+            
+            if (callback) {
+                callback(evaluation);
+            }
+        }
+        
+        waitForPonderhit();
+        
+        if (running()) {
+            status = Status::stopped;
+        }
+        
+        return evaluation;
     }
 
 };
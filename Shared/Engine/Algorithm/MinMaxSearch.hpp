@@ -12,13 +12,17 @@
 #include <climits>
 #include <algorithm>
 #include <iostream>
+#include <atomic>
 
 #include "MoveList.hpp"
 #include "TranspositionTable.hpp"
+#include "EvalCache.hpp"
 
-#include "MoveList.hpp"
 #include "ChessEvaluater.hpp"
 #include "ChessMoveGenerator.hpp"
+#include "ChessBoardHash.hpp"
+#include "Tablebases.hpp"
+#include "Endgames.hpp"
 
 #ifdef ASSERT_TT_KEY_COLLISION
 #include "FFEN.hpp"
@@ -29,12 +33,37 @@ struct Configuration {
     bool debugLog = false;
     bool alphaBetaPrunning = true;
     bool quiescenceSearch = true;
+    
+    // The first ply of the quiescence search also tries the quiet moves giving check,
+    // which finds the mates one ply earlier (the side in check searching all its evasions)
+    bool quiescenceChecks = true;
     bool sortMoves = true;
     bool transpositionTable = true;
+    
+    // ProbCut: at nodes with at least probCutMinDepth plies left, good captures are
+    // searched with a reduced depth (probCutReduction plies less) against a beta raised
+    // by probCutMargin. If one of them still fails high, the node is cut right away.
+    // Off by default: the margin, depth and reduction below have not been tuned yet.
+    bool probCut = false;
+    int probCutMinDepth = 5;
+    int probCutReduction = 3;
+    int probCutMargin = 200;
+    
+    // Number of entries of the evaluation cache (16 bytes each), zero to disable it
+    size_t evalCacheSize = 256*1024;
+    
+    // Endgame tablebases (see Tablebases): the positions with few enough pieces are probed at the nodes
+    // with at least tablebaseProbeDepth plies left, or at any node when they have fewer pieces than the
+    // largest tables loaded (these positions being cheaper to probe).
+    // Note: off by default until the prober has been checked against the real tables (see TablebasesTests).
+    bool tablebases = false;
+    int tablebaseProbeDepth = 1;
 };
 
 struct MinMaxVariation {
-    MoveList moves;
+    // The moves of the line in their compact form: the variations are copied at every node,
+    // the full moves are decoded with the board on which the line starts.
+    CompactMoveList moves;
     
     int depth = 0;
     int qsDepth = 0;
@@ -55,15 +84,39 @@ struct MinMaxVariation {
 };
 
 class MinMaxSearch {
-    bool analyzing = false;
+    // Cleared by cancel() from another thread while the search is running and set again by start()
+    // (only once per search, so a cancel() received between two iterations is not lost)
+    std::atomic<bool> analyzing { true };
     
 public:
     Configuration config;
     
     int visitedNodes = 0;
     
+    // Cache of the static evaluations, usually shared by all the searches (none when null)
+    EvalCache *evalCache = nullptr;
+    
+    int evalCacheHits = 0;
+    int evalCacheMisses = 0;
+    
+    // Number of positions found in the endgame tablebases
+    int tablebaseHits = 0;
+    
+    // Accumulators of the neural network for the line being searched
+    NeuralAccumulatorStack accumulators;
+    
+    // Killer moves and history of the quiet moves, kept from one iteration to the next
+    MoveOrdering ordering;
+    
     void reset() {
         visitedNodes = 0;
+        evalCacheHits = 0;
+        evalCacheMisses = 0;
+        tablebaseHits = 0;
+    }
+
+    void start() {
+        analyzing = true;
     }
 
     void cancel() {
@@ -74,14 +127,45 @@ public:
     
     // pv: Principal Variation that will be available when this method returns.
     // bv: Best Variation that is provided from an earlier search (typically by the iterative deepening algorithm).
+    // Note: like searchRootMove(), this method doesn't re-start a cancelled search (see start()).
     int alphabeta(ChessBoard node, HistoryPtr history, TranspositionTable &table, int depth, bool maximizingPlayer, Variation &pv, Variation &bv) {
-        analyzing = true;
+        accumulators.reset();
         Variation currentLine;
         int color = maximizingPlayer ? 1 : -1;
         int score = alphabeta(node, history, table, depth, -INT_MAX, INT_MAX, color, pv, currentLine, bv);
         return score * color;
     }
     
+    // Search a single move of the root node and returns its score from the point of view
+    // of the side playing that move. The move is searched with a window starting at alpha,
+    // which means a score lower or equal to alpha is only an upper bound.
+    // Note: start() must be called before, this method doesn't re-start a cancelled search.
+    // pv: Principal Variation, starting with the root move, available when this method returns.
+    // bv: Best Variation, starting with the root move, from an earlier search (if available).
+    int searchRootMove(ChessBoard node, HistoryPtr history, TranspositionTable &table, Move move, int alpha, Variation &pv, Variation &bv) {
+        int color = node.color == WHITE ? 1 : -1;
+        
+        visitedNodes++;
+        
+        auto newNode = node;
+        newNode.move(move);
+        
+        Variation currentLine;
+        currentLine.moves.push(move);
+        history->push_back(newNode.getHash());
+        accumulators.reset();
+        accumulators.push(move);
+        
+        Variation line;
+        int score = -alphabeta(newNode, history, table, 1, -INT_MAX, -alpha, -color, line, currentLine, bv);
+        
+        accumulators.pop();
+        history->pop_back();
+        
+        pv.push(score, move, line);
+        return score;
+    }
+    
 private:
     
     // pv: Principal Variation - the best line found so far.
@@ -95,35 +179,35 @@ private:
         int evalDepth = config.maxDepth - depth;
         
         // Check if we have the same node already in our transposition table.
+        TranspositionEntry entry;
         if (config.transpositionTable &&
-            table.exists(node.getHash()
+            table.lookup(node.getHash(), entry
 #ifdef ASSERT_TT_KEY_COLLISION
                          , FFEN::getFEN(node, true)
 #endif
                          )) {
-            auto entry = table.get(node.getHash());
-            
             // Make sure the entry exists and that its depth is at least what we are at right now
             if (entry.depth >= evalDepth) {
+                auto bestMove = node.decodeMove(entry.bestMove);
                 switch (entry.type) {
                     case TranspositionEntryType::EXACT:
                         // Exact value: use it right away
-                        assert(ChessMoveGenerator::isValid(entry.bestMove));
-                        pv.push(entry.value, entry.bestMove, Variation());
+                        assert(ChessMoveGenerator::isValid(bestMove));
+                        pv.push(entry.value, bestMove, Variation());
                         return entry.value;
                         
                     case TranspositionEntryType::ALPHA:
                         if (entry.value <= alpha) {
-                            assert(ChessMoveGenerator::isValid(entry.bestMove));
-                            pv.push(entry.value, entry.bestMove, Variation());
+                            assert(ChessMoveGenerator::isValid(bestMove));
+                            pv.push(entry.value, bestMove, Variation());
                             return entry.value;
                         }
                         break;
                         
                     case TranspositionEntryType::BETA:
                         if (entry.value >= beta) {
-                            assert(ChessMoveGenerator::isValid(entry.bestMove));
-                            pv.push(entry.value, entry.bestMove, Variation());
+                            assert(ChessMoveGenerator::isValid(bestMove));
+                            pv.push(entry.value, bestMove, Variation());
                             return entry.value;
                         }
                         break;
@@ -134,29 +218,62 @@ private:
         if (ChessEvaluater::isDraw(node, history)) {
             return 0;
         }
+        
+        // Neither side can force a mate in the known draws (like KNK or KNNK): no need to search them,
+        // unless the side to move is in check, which can still be a mate (if the other side helped it)
+        if (depth > 0 && Endgames::isDraw(node) && !node.isCheck(node.color)) {
+            return 0;
+        }
+        
+        // The tables ignore the fifty-move counter, so they are only probed after a capture or a pawn move:
+        // the outcome is then exact and the search doesn't need to go any deeper.
+        // Note: the halfMoveClock == 0 restriction is intentional, not a missed case. Deeper in a line without
+        // any capture, a win of the tables could already be lost to the fifty-move rule; and the material only
+        // changes with a capture or a promotion, so a line reaches the tables at a position with a clock of 0.
+        if (config.tablebases && depth > 0 && node.halfMoveClock == 0 && Tablebases::canProbe(node) &&
+            (evalDepth >= config.tablebaseProbeDepth || bb_count(node.getOccupancy()) < Tablebases::maxPieces())) {
+            Tablebases::WDL wdl;
+            if (Tablebases::probeWDL(node, wdl)) {
+                tablebaseHits++;
+                return tablebaseValue(wdl, depth);
+            }
+        }
 
         if (depth == config.maxDepth) {
             if (config.quiescenceSearch) {
                 int score = quiescence(node, history, depth, alpha, beta, color, pv, cv);
                 return score;
             } else {
-                int score = ChessEvaluater::evaluate(node, history) * color;
+                AttackInfo info(node);
+                int score = evaluate(info, history) * color;
                 return score;
             }
         }
         
-        auto moves = ChessMoveGenerator::generateMoves(node);
+        // The attacks of this node, shared by ProbCut, the move generation and the evaluation
+        AttackInfo info(node);
+        
+        // Lookup the best move if available in the best variation
+        auto bestMovePV = node.decodeMove(bv.moves.lookup(depth));
+
+        // ProbCut is never applied to the root node or to the nodes of the best variation
+        // because these are the ones that need an exact value and a principal variation.
+        if (config.probCut && depth > 0 && !ChessMoveGenerator::isValid(bestMovePV)) {
+            int probCutScore;
+            if (probCut(node, info, history, table, depth, beta, color, cv, probCutScore)) {
+                return probCutScore;
+            }
+        }
+
+        auto moves = ChessMoveGenerator::generateMoves(info);
         if (moves.count == 0) {
-            int score = ChessEvaluater::evaluate(node, history, moves) * color;
+            int score = ChessEvaluater::evaluate(info, history, moves) * color;
             return score;
         }
         
         if (config.sortMoves) {
-            ChessMoveGenerator::sortMoves(moves);
+            ChessMoveGenerator::scoreMoves(node, moves, &ordering, depth);
         }
-        
-        // Lookup the best move if available in the best variation
-        auto bestMovePV = bv.moves.lookup(depth);
 
         int bestValue = -INT_MAX;
         TranspositionEntryType entryType = TranspositionEntryType::ALPHA;
@@ -175,8 +292,8 @@ private:
                     continue;
                 }
             } else {
-                // Above index -1, we analyze the generated moves
-                move = moves.moves[index];
+                // Above index -1, we analyze the generated moves, the best ones first
+                move = config.sortMoves ? moves.selectBest(index) : moves.moves[index];
                 
                 // Skip this move if it is the best move (which has been analyzed first)
                 if (move == bestMovePV) {
@@ -191,12 +308,14 @@ private:
             
             cv.moves.push(move);
             history->push_back(newNode.getHash());
+            accumulators.push(move);
             
             Variation line;
             Variation bestLine = (move == bestMovePV) ? bv : Variation();
             int score = -alphabeta(newNode, history, table, depth + 1, -beta, -alpha, -color, line, cv, bestLine);
             
             cv.moves.pop();
+            accumulators.pop();
             history->pop_back();
             
             if (score > bestValue) {
@@ -212,11 +331,20 @@ private:
                 
                 if (config.alphaBetaPrunning && beta <= alpha) {
                     entryType = TranspositionEntryType::BETA;
+                    if (!MOVE_IS_CAPTURE(move) && MOVE_PROMOTION_PIECE(move) == 0) {
+                        ordering.update(move, depth, evalDepth);
+                    }
                     break; // Beta cut-off
                 }
             }
         }
 
+        // The search has been stopped before all the moves have been searched: the value is not
+        // reliable (a child without any move searched returns -INT_MAX) and must not be stored.
+        if (!analyzing) {
+            return bestValue;
+        }
+        
         if (ChessMoveGenerator::isValid(bestMove)) {
             table.store(evalDepth, node.getHash(), bestValue, bestMove, entryType
 #ifdef ASSERT_TT_KEY_COLLISION
@@ -228,6 +356,106 @@ private:
         return bestValue;
     }
     
+    // https://www.chessprogramming.org/ProbCut
+    // Returns true if a good capture, searched with a reduced depth, fails high against
+    // beta raised by the ProbCut margin. In that case the node can be cut because a full
+    // depth search is very likely to fail high against beta as well.
+    bool probCut(ChessBoard &node, AttackInfo &info, HistoryPtr history, TranspositionTable &table, int depth, int beta, int color, Variation &cv, int &score) {
+        int evalDepth = config.maxDepth - depth;
+        if (evalDepth < config.probCutMinDepth) {
+            return false;
+        }
+        
+        // Do not raise beta when it is a mat value (or the initial infinite window)
+        if (beta <= -ChessEvaluater::MAT_VALUE || beta >= ChessEvaluater::MAT_VALUE) {
+            return false;
+        }
+        
+        int probCutBeta = beta + config.probCutMargin;
+        
+        // The reduced search brings the horizon (config.maxDepth) closer by probCutReduction plies:
+        // the depth stays the ply from the root, which indexes the killers and the best variation
+        // and gives the distance of the tablebase wins.
+        int maxDepth = config.maxDepth;
+        int reducedMaxDepth = std::max(depth + 1, maxDepth - config.probCutReduction);
+        
+        // The captures are generated in MVV/LVA order
+        auto captures = ChessMoveGenerator::generateQuiescenceMoves(info);
+        
+        for (int index=0; index<captures.count && analyzing; index++) {
+            auto move = captures.moves[index];
+            
+            // Only try the good captures, that is, the ones where the captured piece
+            // is worth at least the capturing piece (pieces are ordered by value).
+            if (!MOVE_IS_CAPTURE(move) || MOVE_CAPTURED_PIECE(move) < MOVE_PIECE(move)) {
+                continue;
+            }
+            
+            visitedNodes++;
+            
+            auto newNode = node;
+            newNode.move(move);
+            
+            cv.moves.push(move);
+            history->push_back(newNode.getHash());
+            accumulators.push(move);
+            
+            Variation line;
+            Variation bestLine;
+            config.maxDepth = reducedMaxDepth;
+            int value = -alphabeta(newNode, history, table, depth + 1, -probCutBeta, -probCutBeta + 1, -color, line, cv, bestLine);
+            config.maxDepth = maxDepth;
+            
+            cv.moves.pop();
+            accumulators.pop();
+            history->pop_back();
+            
+            if (value >= probCutBeta) {
+                score = value;
+                return true;
+            }
+        }
+        
+        return false;
+    }
+    
+    // Returns the value of an outcome of the tablebases from the point of view of the side to move: a win is
+    // worth less than a mat but more than any evaluation, the fastest one first. A win that would be a draw
+    // because of the fifty-move rule is only worth a little more than a draw.
+    static int tablebaseValue(Tablebases::WDL wdl, int depth) {
+        switch (wdl) {
+            case Tablebases::WIN:
+                return ChessEvaluater::TABLEBASE_WIN_VALUE - depth;
+            case Tablebases::LOSS:
+                return -ChessEvaluater::TABLEBASE_WIN_VALUE + depth;
+            default:
+                return 2 * wdl;
+        }
+    }
+    
+    // Returns the evaluation of the node, from white's point of view, looking it up first in the
+    // evaluation cache. Note: the repetitions are not part of the cached evaluation, which only
+    // depends on the position, the caller must have already checked the node is not a draw.
+    int evaluate(AttackInfo &info, HistoryPtr history) {
+        auto hash = ChessBoardHash::exactHash(info.board);
+        int value;
+        if (evalCache && evalCache->lookup(hash, value)) {
+            evalCacheHits++;
+            return value;
+        }
+        
+        if (ChessEvaluater::useNeuralNetwork()) {
+            value = ChessEvaluater::evaluate(info, history, &accumulators.accumulator(ChessEvaluater::network, info.board));
+        } else {
+            value = ChessEvaluater::evaluate(info, history);
+        }
+        if (evalCache) {
+            evalCacheMisses++;
+            evalCache->store(hash, value);
+        }
+        return value;
+    }
+    
     // https://chessprogramming.wikispaces.com/Quiescence+Search
     // Note: the search described in the link above returns alpha which doesn't work
     // with the positions I've been analyzing (returning alpha will never return the
@@ -242,7 +470,21 @@ private:
             return 0;
         }
 
-        auto stand_pat = ChessEvaluater::evaluate(node, history) * color;
+        AttackInfo info(node);
+        
+        // The side in check cannot stand pat, whatever the evaluation: all the evasions are searched
+        if (info.isCheck(node.color)) {
+            auto moves = ChessMoveGenerator::generateMoves(info);
+            if (moves.count == 0) {
+                return ChessEvaluater::evaluate(info, history, moves) * color;
+            }
+            if (config.sortMoves) {
+                ChessMoveGenerator::scoreMoves(node, moves);
+            }
+            return searchQuiescenceMoves(node, history, depth, alpha, beta, color, pv, cv, moves, config.sortMoves, -INT_MAX);
+        }
+        
+        auto stand_pat = evaluate(info, history) * color;
         if (stand_pat >= beta) {
             return stand_pat;
         }
@@ -251,19 +493,31 @@ private:
             alpha = stand_pat;
         }
 
-        auto moves = ChessMoveGenerator::generateQuiescenceMoves(node);
+        // The captures are generated in MVV/LVA order and don't need to be sorted, the quiet checks
+        // of the first ply are searched after them, except the ones losing the piece giving check.
+        auto moves = ChessMoveGenerator::generateQuiescenceMoves(info);
+        if (config.quiescenceChecks && depth == config.maxDepth) {
+            auto checks = ChessMoveGenerator::generateQuietChecks(info, node.color);
+            for (int index=0; index<checks.count; index++) {
+                if (node.staticExchange(checks.moves[index]) >= 0) {
+                    moves.push(checks.moves[index]);
+                }
+            }
+        }
         if (moves.count == 0) {
             return stand_pat;
         }
         
-        if (config.sortMoves) {
-            ChessMoveGenerator::sortMoves(moves);
-        }
-        
-        int score = stand_pat;
+        return searchQuiescenceMoves(node, history, depth, alpha, beta, color, pv, cv, moves, false, stand_pat);
+    }
+
+    // Searches the moves of a node of the quiescence search, in the order of the list unless they have been
+    // scored, and returns the best score, starting from the specified one.
+    // Note: the best score (and not the score of the last move searched) doesn't depend on the order of the moves.
+    int searchQuiescenceMoves(ChessBoard &node, HistoryPtr history, int depth, int alpha, int beta, int color, Variation &pv, Variation &cv, MoveList &moves, bool scored, int bestScore) {
         for (int index=0; index<moves.count && analyzing; index++) {
-            auto move = moves.moves[index];
-            
+            auto move = scored ? moves.selectBest(index) : moves.moves[index];
+
             visitedNodes++;
             
             auto newNode = node;
@@ -271,13 +525,16 @@ private:
 
             cv.moves.push(move);
             history->push_back(newNode.getHash());
+            accumulators.push(move);
 
             Variation line;
-            score = -quiescence(newNode, history, depth+1, -beta, -alpha, -color, line, cv);
+            int score = -quiescence(newNode, history, depth+1, -beta, -alpha, -color, line, cv);
             
             cv.moves.pop();
+            accumulators.pop();
             history->pop_back();
 
+            bestScore = std::max(bestScore, score);
             if (score >= alpha) {
                 alpha = score;
                 pv.push(score, move, line);
@@ -286,7 +543,7 @@ private:
             }
         }
                 
-        return score;
+        return bestScore;
     }
     
 };
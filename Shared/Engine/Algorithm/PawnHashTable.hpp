@@ -0,0 +1,78 @@
+//
+//  PawnHashTable.hpp
+//  BChess
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#pragma once
+
+#include "ChessBoard.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+// Evaluation of a pawn structure, which only depends on the pawns of both colors
+struct PawnEntry {
+    // Score of the pawn structure, always from white's point of view
+    int score = 0;
+
+    Bitboard passed[COUNT] = { };
+
+    // Squares the pawns of each color can attack now or by advancing
+    Bitboard attackSpans[COUNT] = { };
+};
+
+// Table of the pawn structures already evaluated, indexed by the pawn Zobrist key of the board.
+// The pawns change rarely during the search so most lookups are hits.
+// https://www.chessprogramming.org/Pawn_Hash_Table
+// Note: a table is not thread-safe, each search thread uses its own (see ChessEvaluater::pawnTable()).
+class PawnHashTable {
+    struct PawnSlot {
+        BoardHash key;
+        PawnEntry entry;
+    };
+
+    static const size_t SIZE = 16*1024;
+
+    PawnSlot table[SIZE] = { };
+
+public:
+    uint64_t probeCount = 0;
+    uint64_t hitCount = 0;
+
+    // Returns true if the pawn structure has already been evaluated, in which case its entry is returned.
+    // Note: an empty slot matches the key 0 of a board without any pawn, which is correct
+    // because the entry of an empty pawn structure is all zeros as well.
+    bool lookup(BoardHash pawnHash, PawnEntry &entry) {
+        probeCount++;
+        auto &slot = table[pawnHash % SIZE];
+        if (slot.key == pawnHash) {
+            hitCount++;
+            entry = slot.entry;
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    void store(BoardHash pawnHash, const PawnEntry &entry) {
+        auto &slot = table[pawnHash % SIZE];
+        slot.key = pawnHash;
+        slot.entry = entry;
+    }
+
+    void clear() {
+        std::fill(std::begin(table), std::end(table), PawnSlot());
+        resetStats();
+    }
+
+    void resetStats() {
+        probeCount = hitCount = 0;
+    }
+
+    // Percentage of the lookups that found the pawn structure in the table
+    int hitRate() {
+        return probeCount > 0 ? int(hitCount * 100 / probeCount) : 0;
+    }
+};
@@ -11,6 +11,15 @@
 #include "Types.hpp"
 #include "Move.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
 #define TRANSPO_SIZE (size_t)(18*1000*1000)
 
 enum TranspositionEntryType {
@@ -34,76 +43,252 @@ struct TranspositionEntry {
     int depth;
     BoardHash hash;
     int value;
-    Move bestMove;
+    
+    // The best move, to decode with the board of the entry (see ChessBoard::decodeMove())
+    CompactMove bestMove;
     TranspositionEntryType type;
 #ifdef ASSERT_TT_KEY_COLLISION
     std::string shortFEN;
 #endif
 };
 
+// The entry is stored packed into a 64-bit data word and the key is the
+// hash XOR'ed with that data word. That way, when several threads share
+// the table (see MultiPV), an entry that is partially overwritten by
+// another thread won't match the hash anymore and is simply ignored.
+// https://www.chessprogramming.org/Shared_Hash_Table#Lockless
+// Note: the two 64-bit words of a slot are copied with plain, non-atomic accesses
+// and a reader can see the key of one store with the data of another. This is
+// only safe because lookup() checks key ^ data against the hash before using
+// the data, so such a torn slot is discarded as if it were a miss.
+// bit 0-19: value (signed)
+// bit 20-21: type
+// bit 22-29: depth
+// bit 32-47: best move (see CompactMove)
+// bit 59-63: generation of the search that stored the entry
+struct TranspositionSlot {
+    BoardHash key;
+    uint64_t data;
+#ifdef ASSERT_TT_KEY_COLLISION
+    std::string shortFEN;
+#endif
+};
+
 class TranspositionTable {
-    TranspositionEntry *table = nullptr;
+    TranspositionSlot *table = nullptr;
+    
+    // Number of slots allocated and number of slots in use (which can be smaller
+    // when the table has been resized down without re-allocating it).
+    size_t capacity = 0;
+    size_t size = 0;
+    
+    // Below this size, the table is cleared by the calling thread only
+    // because starting the threads would cost more than the memset itself.
+    static const size_t PARALLEL_CLEAR_MIN_BYTES = 16*1024*1024;
+    
+    // Largest number of slots that can be allocated: beyond it, the size in bytes
+    // doesn't fit in a ptrdiff_t (or overflows a size_t) and the allocation is not even tried.
+    static const size_t MAX_SIZE = PTRDIFF_MAX / sizeof(TranspositionSlot);
+    
+    // Generation of the current search, incremented by newSearch() and
+    // wrapping around after GENERATION_COUNT searches.
+    static const int GENERATION_COUNT = 32;
+    uint8_t generation = 0;
+    
+    static uint64_t pack(int depth, int value, Move bestMove, TranspositionEntryType type, uint8_t generation) {
+        assert(value >= -(1 << 19) && value < (1 << 19));
+        depth = std::max(0, std::min(depth, 255));
+        return (uint64_t)(value & 0xFFFFF) | (uint64_t)type << 20 | (uint64_t)depth << 22 | (uint64_t)COMPACT_MOVE(bestMove) << 32 | (uint64_t)generation << 59;
+    }
+    
+    static TranspositionEntry unpack(BoardHash hash, uint64_t data) {
+        TranspositionEntry entry;
+        entry.hash = hash;
+        entry.value = (int)((int32_t)((data & 0xFFFFF) << 12) >> 12); // sign extend the 20 bits value
+        entry.type = TranspositionEntryType((data >> 20) & 3);
+        entry.depth = (data >> 22) & 0xFF;
+        entry.bestMove = (CompactMove)((data >> 32) & 0xFFFF);
+        return entry;
+    }
+    
+    static uint8_t generationOf(uint64_t data) {
+        return (data >> 59) & (GENERATION_COUNT - 1);
+    }
+    
+    // Number of searches since the entry was stored, modulo GENERATION_COUNT
+    // so the age stays correct when the generation wraps around.
+    int ageOf(uint64_t data) const {
+        return (GENERATION_COUNT + generation - generationOf(data)) % GENERATION_COUNT;
+    }
     
 public:
     
     bool enabled = true;
 
-    int storeCount = 0;
-    int collisionCount = 0;
-    int newStoreCount = 0;
+    // Statistics, incremented by all the threads sharing the table
+    // (relaxed because they are only read once the search is over)
+    std::atomic<int> storeCount { 0 };
+    std::atomic<int> collisionCount { 0 };
+    std::atomic<int> newStoreCount { 0 };
+    
+    // Time in milliseconds taken by the last clear() or resize()
+    double clearTime = 0;
     
-    TranspositionTable() {
-        table = (TranspositionEntry*)calloc(TRANSPO_SIZE+1, sizeof(TranspositionEntry));
+    TranspositionTable(size_t size = TRANSPO_SIZE) {
+        // Note: the pages of a large zeroed allocation are zeroed lazily by the system,
+        // so constructing the table doesn't stall the engine.
+        // If the allocation fails, the table stays empty: nothing is stored and
+        // every lookup misses until a later resize() succeeds.
+        table = size <= MAX_SIZE ? (TranspositionSlot*)calloc(size, sizeof(TranspositionSlot)) : nullptr;
+        capacity = this->size = table ? size : 0;
     }
     
     ~TranspositionTable() {
         free(table);
     }
     
+    size_t getSize() {
+        return size;
+    }
+    
+    // Must be called before each new search (that is, before each move to play
+    // and not before each iteration of the iterative deepening). The entries stored
+    // by previous searches can still be used but they are the first ones replaced.
+    void newSearch() {
+        generation = (generation + 1) % GENERATION_COUNT;
+    }
+    
+    // Removes all the entries, typically when starting a new game.
+    // The table is split in chunks zeroed in parallel by one thread per core,
+    // which also means the pages are first touched (and so placed in memory)
+    // by several threads instead of a single one.
+    // Returns the time in milliseconds it took to clear the table.
+    double clear() {
+        auto start = std::chrono::steady_clock::now();
+        
+        generation = 0;
+        storeCount.store(0, std::memory_order_relaxed);
+        collisionCount.store(0, std::memory_order_relaxed);
+        newStoreCount.store(0, std::memory_order_relaxed);
+        
+        if (size == 0) {
+            clearTime = 0;
+            return clearTime;
+        }
+        
+        size_t threadCount = 1;
+        if (size * sizeof(TranspositionSlot) >= PARALLEL_CLEAR_MIN_BYTES) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        size_t chunk = (size + threadCount - 1) / threadCount;
+        std::vector<std::thread> threads;
+        for (size_t index = 1; index < threadCount && index * chunk < size; index++) {
+            size_t begin = index * chunk;
+            size_t count = std::min(chunk, size - begin);
+            threads.push_back(std::thread([this, begin, count] {
+                memset(table + begin, 0, count * sizeof(TranspositionSlot));
+            }));
+        }
+        // The calling thread takes care of the first chunk
+        memset(table, 0, std::min(chunk, size) * sizeof(TranspositionSlot));
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        
+        clearTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return clearTime;
+    }
+    
+    // Changes the number of entries of the table and clears it. The existing allocation
+    // is re-used when it is large enough so resizing back and forth doesn't hit the allocator.
+    // If the new table cannot be allocated (or is larger than MAX_SIZE), the current one is kept
+    // (see getSize()) and cleared. Returns the time in milliseconds it took to resize the table.
+    double resize(size_t newSize) {
+        newSize = std::max(newSize, (size_t)1);
+        if (newSize > MAX_SIZE) {
+            return clear();
+        }
+        if (newSize > capacity) {
+            auto start = std::chrono::steady_clock::now();
+            // Note: malloc and not calloc because the pages are going to be
+            // touched anyway by clear() with the proper thread placement.
+            auto newTable = (TranspositionSlot*)malloc(newSize * sizeof(TranspositionSlot));
+            if (newTable == nullptr) {
+                return clear();
+            }
+            free(table);
+            table = newTable;
+            capacity = newSize;
+            size = newSize;
+            double allocationTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            clearTime = allocationTime + clear();
+            return clearTime;
+        } else {
+            size = newSize;
+            return clear();
+        }
+    }
+    
+    // Resizes the table to use the specified amount of memory in megabytes
+    // (which is how the size of the table is specified by the UCI Hash option).
+    double resizeMB(size_t megabytes) {
+        if (megabytes > MAX_SIZE / (1024 * 1024 / sizeof(TranspositionSlot))) {
+            return resize(SIZE_MAX);
+        }
+        return resize(megabytes * 1024 * 1024 / sizeof(TranspositionSlot));
+    }
+    
+    // An entry stored by a previous search is always replaced, otherwise
+    // the entry is only replaced by an entry of equal or greater depth.
     void store(int depth, BoardHash hash, int value, Move bestMove, TranspositionEntryType type
 #ifdef ASSERT_TT_KEY_COLLISION
                , std::string shortFEN
 #endif
                ) {
-        unsigned long index = hash % TRANSPO_SIZE;
-        storeCount++;
-        if (depth >= table[index].depth) {
-            if (table[index].hash != 0) {
+        if (size == 0) {
+            return;
+        }
+        unsigned long index = hash % size;
+        storeCount.fetch_add(1, std::memory_order_relaxed);
+        TranspositionSlot slot = table[index];
+        if (ageOf(slot.data) > 0 || depth >= unpack(0, slot.data).depth) {
+            if (slot.key != 0) {
                 // Collision?
-                if (table[index].hash != hash) {
-                    collisionCount++;
+                if ((slot.key ^ slot.data) != hash) {
+                    collisionCount.fetch_add(1, std::memory_order_relaxed);
                 } else {
                     // Replacement
                 }
             } else {
-                newStoreCount++;
+                newStoreCount.fetch_add(1, std::memory_order_relaxed);
             }
-            table[index].depth = depth;
-            table[index].hash = hash;
-            table[index].value = value;
-            table[index].bestMove = bestMove;
-            table[index].type = type;
+            uint64_t data = pack(depth, value, bestMove, type, generation);
+            table[index].key = hash ^ data;
+            table[index].data = data;
 #ifdef ASSERT_TT_KEY_COLLISION
             table[index].shortFEN = shortFEN;
 #endif
         }
     }
     
-    TranspositionEntry get(BoardHash hash) {
-        int index = hash % TRANSPO_SIZE;
-        return table[index];
-    }
-    
-    bool exists(BoardHash hash
+    // Returns true if an entry exists for the specified hash, in which case
+    // the entry is returned in the entry parameter. The table is only read here:
+    // an entry is moved to the current generation when it is stored again.
+    bool lookup(BoardHash hash, TranspositionEntry &entry
 #ifdef ASSERT_TT_KEY_COLLISION
                 , std::string shortFEN
 #endif
                 ) {
-        int index = hash % TRANSPO_SIZE;
-        if (table[index].hash == hash) {
+        if (size == 0) {
+            return false;
+        }
+        unsigned long index = hash % size;
+        TranspositionSlot slot = table[index];
+        if (slot.key != 0 && (slot.key ^ slot.data) == hash) {
 #ifdef ASSERT_TT_KEY_COLLISION
-            assert(table[index].shortFEN == shortFEN);
+            assert(slot.shortFEN == shortFEN);
 #endif
+            entry = unpack(hash, slot.data);
             return true;
         } else {
             return false;
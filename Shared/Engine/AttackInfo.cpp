@@ -0,0 +1,128 @@
+//
+//  AttackInfo.cpp
+//  BChess
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#include "AttackInfo.hpp"
+#include "SlidingAttacks.hpp"
+
+void AttackInfo::buildAttacks(Color color) {
+    auto occupancy = board.getOccupancy();
+    allAttacks[color] = 0;
+    for (unsigned piece = PAWN; piece < PCOUNT; piece++) {
+        Bitboard typeAttacks = 0;
+        Bitboard pieces = board.pieces[color][piece];
+        while (pieces > 0) {
+            Square square = lsb(pieces);
+            bb_clear(pieces, square);
+
+            Bitboard pieceAttacks = 0;
+            switch (piece) {
+                case PAWN:
+                    pieceAttacks = PawnAttacks[color][square];
+                    break;
+                case KNIGHT:
+                    pieceAttacks = KnightMoves[square];
+                    break;
+                case BISHOP:
+                    pieceAttacks = BishopAttacks(square, occupancy);
+                    break;
+                case ROOK:
+                    pieceAttacks = RookAttacks(square, occupancy);
+                    break;
+                case QUEEN:
+                    pieceAttacks = BishopAttacks(square, occupancy) | RookAttacks(square, occupancy);
+                    break;
+                case KING:
+                    pieceAttacks = KingMoves[square];
+                    break;
+            }
+            squareAttacks[square] = pieceAttacks;
+            typeAttacks |= pieceAttacks;
+        }
+        attacks[color][piece] = typeAttacks;
+        allAttacks[color] |= typeAttacks;
+    }
+}
+
+void AttackInfo::buildKingSafety(Color color) {
+    kingCheckers[color] = 0;
+    pinnedPieces[color] = 0;
+
+    auto kings = board.pieces[color][KING];
+    singleKing[color] = bb_count(kings) == 1;
+    if (kings == 0) {
+        return; // No king, can happen when testing
+    }
+
+    Square kingSquare = lsb(kings);
+    auto otherColor = INVERSE(color);
+    auto &other = board.pieces[otherColor];
+
+    kingCheckers[color] = (PawnAttacks[color][kingSquare] & other[PAWN]) |
+                          (KnightMoves[kingSquare] & other[KNIGHT]) |
+                          (KingMoves[kingSquare] & other[KING]);
+
+    // The sliding pieces that reach the king when only the pieces of the other color
+    // are blocking: each of them is either giving check, when there is no piece
+    // in-between, or pinning the piece in-between when there is only one.
+    auto otherPieces = board.allPieces(otherColor);
+    auto snipers = (RookAttacks(kingSquare, otherPieces) & (other[ROOK] | other[QUEEN])) |
+                   (BishopAttacks(kingSquare, otherPieces) & (other[BISHOP] | other[QUEEN]));
+    while (snipers > 0) {
+        Square square = lsb(snipers);
+        bb_clear(snipers, square);
+
+        auto blockers = SquaresBetween[kingSquare][square] & board.getOccupancy();
+        if (blockers == 0) {
+            bb_set(kingCheckers[color], square);
+        } else if (bb_count(blockers) == 1) {
+            pinnedPieces[color] |= blockers;
+        }
+    }
+}
+
+bool AttackInfo::isAttacked(Square square, Color byColor) {
+    // Use the attacks if they have been computed already, otherwise
+    // it is faster to only look for the attackers of that square.
+    if ((computed & (ATTACKS << byColor)) > 0) {
+        return bb_test(allAttacks[byColor], square);
+    } else {
+        return board.isAttacked(square, byColor);
+    }
+}
+
+bool AttackInfo::isLegal(Move move) {
+    auto color = MOVE_COLOR(move);
+    auto from = MOVE_FROM(move);
+    auto piece = MOVE_PIECE(move);
+
+    // The move can be validated without being played when it moves a piece
+    // of its color (which is not the case of the quiet moves generated for the
+    // opponent in moveCaptureAndDefenseMoves mode) and it's not an en-passant,
+    // which removes two pieces from the same rank.
+    if (board.mailbox[from] == SQUARE_CONTENT(color, piece) && !MOVE_IS_ENPASSANT(move)) {
+        computeKingSafety(color);
+        if (singleKing[color]) {
+            if (piece == KING) {
+                // The king cannot move to a square that is attacked, the king itself
+                // being removed from the occupancy because it doesn't block the attacks
+                // of the sliding pieces that are giving check along its line.
+                auto occupancy = board.getOccupancy() & ~(1UL << from);
+                return board.attackersTo(MOVE_TO(move), INVERSE(color), occupancy) == 0;
+            }
+
+            // Any other piece can move if the king is not in check and the piece is not
+            // pinned, otherwise play the move to find out.
+            if (kingCheckers[color] == 0 && !bb_test(pinnedPieces[color], from)) {
+                return true;
+            }
+        }
+    }
+
+    ChessBoard validBoard = board;
+    validBoard.move(move);
+    return !validBoard.isCheck(color);
+}
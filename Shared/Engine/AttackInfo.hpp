@@ -0,0 +1,98 @@
+//
+//  AttackInfo.hpp
+//  BChess
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#pragma once
+
+#include "ChessBoard.hpp"
+
+// Attacks of a position shared by the move generation, the evaluation and the search
+// of a particular node. Each part is computed lazily, the first time it is requested,
+// and only once for the node, instead of being recomputed by every isCheck(),
+// isAttacked() or legality test of the generated moves.
+// Note: the board must not be modified while the attack info is in use.
+class AttackInfo {
+public:
+    explicit AttackInfo(ChessBoard &board) : board(board) { }
+
+    ChessBoard &board;
+
+    // Squares attacked by the pieces of the specified color and type
+    Bitboard attacksBy(Color color, Piece piece) {
+        computeAttacks(color);
+        return attacks[color][piece];
+    }
+
+    // Squares attacked by all the pieces of the specified color
+    Bitboard attacksBy(Color color) {
+        computeAttacks(color);
+        return allAttacks[color];
+    }
+
+    // Squares attacked by the piece on the specified square, which must not be empty
+    Bitboard attacksFrom(Square square) {
+        assert(board.mailbox[square] != EMPTY_SQUARE);
+        computeAttacks(SQUARE_CONTENT_COLOR(board.mailbox[square]));
+        return squareAttacks[square];
+    }
+
+    // Pieces of the opposite color giving check to the king of the specified color
+    Bitboard checkers(Color color) {
+        computeKingSafety(color);
+        return kingCheckers[color];
+    }
+
+    // Pieces of the specified color that cannot leave the line between
+    // their king and a sliding piece of the opposite color
+    Bitboard pinned(Color color) {
+        computeKingSafety(color);
+        return pinnedPieces[color];
+    }
+
+    bool isCheck(Color color) {
+        return checkers(color) > 0;
+    }
+
+    bool isAttacked(Square square, Color byColor);
+
+    // Returns true if the move doesn't leave the king of its color in check
+    bool isLegal(Move move);
+
+private:
+    enum : uint8_t {
+        ATTACKS = 1,
+        KING_SAFETY = 4
+    };
+
+    // Parts already computed for each color (see the enum above, shifted by the color)
+    uint8_t computed = 0;
+
+    Bitboard attacks[COUNT][PCOUNT];
+    Bitboard allAttacks[COUNT];
+    Bitboard squareAttacks[64]; // Only set for the squares with a piece
+    Bitboard kingCheckers[COUNT];
+    Bitboard pinnedPieces[COUNT];
+
+    // True when the color has exactly one king, which is required by the fast legality test
+    bool singleKing[COUNT];
+
+    void computeAttacks(Color color) {
+        if ((computed & (ATTACKS << color)) == 0) {
+            buildAttacks(color);
+            computed |= ATTACKS << color;
+        }
+    }
+
+    void computeKingSafety(Color color) {
+        if ((computed & (KING_SAFETY << color)) == 0) {
+            buildKingSafety(color);
+            computed |= KING_SAFETY << color;
+        }
+    }
+
+    void buildAttacks(Color color);
+    void buildKingSafety(Color color);
+};
@@ -0,0 +1,572 @@
+//
+//  Bitbases.cpp
+//  BChess
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#include "Bitbases.hpp"
+#include "ChessMoveGenerator.hpp"
+#include "SlidingAttacks.hpp"
+#include "FUtility.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <set>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std::chrono;
+
+namespace {
+
+// Both kings and up to two pieces
+static const int MaxPieces = 4;
+
+// Pieces in the order of a signature, the most valuable first
+static const Piece SignatureOrder[] = { QUEEN, ROOK, BISHOP, KNIGHT, PAWN };
+
+// Number of pieces of each kind (besides the king), 4 bits each
+static uint32_t materialKey(const std::vector<Piece> &pieces) {
+    uint32_t key = 0;
+    for (auto piece : pieces) {
+        key += 1 << (4 * piece);
+    }
+    return key;
+}
+
+// Same key from the material of the board, for the pieces of one color (the king excluded)
+static uint32_t materialKey(const ChessBoard &board, Color color) {
+    return uint32_t(board.getMaterialKey() >> (4 * SQUARE_CONTENT(color, PAWN))) & (MATERIAL_KEY(WHITE, KING) - 1);
+}
+
+static std::string signatureOf(std::vector<Piece> pieces) {
+    std::string signature = "K";
+    for (auto piece : SignatureOrder) {
+        signature += std::string(std::count(pieces.begin(), pieces.end(), piece), pieceToChar(piece, true));
+    }
+    return signature + "K";
+}
+
+// Returns true if the pieces cannot mate the lone king: no piece or a single knight or bishop
+static bool isInsufficient(const std::vector<Piece> &pieces) {
+    return pieces.empty() || (pieces.size() == 1 && (pieces[0] == KNIGHT || pieces[0] == BISHOP));
+}
+
+// Signatures of the positions reached by a capture of the lone king or a promotion
+static std::vector<std::string> dependencies(const std::vector<Piece> &pieces) {
+    std::vector<std::string> signatures;
+    for (size_t index=0; index<pieces.size(); index++) {
+        auto remaining = pieces;
+        remaining.erase(remaining.begin() + index);
+        if (!isInsufficient(remaining)) {
+            signatures.push_back(signatureOf(remaining));
+        }
+        if (pieces[index] == PAWN) {
+            for (auto piece : { QUEEN, ROOK, BISHOP, KNIGHT }) {
+                auto promoted = pieces;
+                promoted[index] = piece;
+                if (!isInsufficient(promoted)) {
+                    signatures.push_back(signatureOf(promoted));
+                }
+            }
+        }
+    }
+    return signatures;
+}
+
+#pragma mark - Index
+
+// The squares of a position are, in this order, the king of the stronger side (which is white), the lone king
+// and the other pieces, in the order of the signature. The index is made of the square of the first king (once
+// the board is mirrored), the square of each other piece and the side to move in the lowest bit.
+static size_t positionCount(bool hasPawns, int count) {
+    size_t positions = (hasPawns ? 32 : 16) * 2;
+    for (int index=1; index<count; index++) {
+        positions *= 64;
+    }
+    return positions;
+}
+
+// Mirrors the board horizontally to have the king of the stronger side on the files a to d and, without
+// pawns, vertically to have it on the ranks 1 to 4. Every position has a single mirrored position because
+// the king is never on the axis of a symmetry.
+static void mirror(Square *squares, int count, bool hasPawns) {
+    int flip = (FileFrom(squares[0]) > 3 ? 7 : 0) | (!hasPawns && RankFrom(squares[0]) > 3 ? 56 : 0);
+    for (int index=0; index<count; index++) {
+        squares[index] ^= flip;
+    }
+}
+
+static size_t positionIndex(Square *squares, int count, bool hasPawns, bool weakToMove) {
+    mirror(squares, count, hasPawns);
+    size_t index = RankFrom(squares[0]) * 4 + FileFrom(squares[0]);
+    for (int piece=1; piece<count; piece++) {
+        index = index * 64 + squares[piece];
+    }
+    return index * 2 + weakToMove;
+}
+
+static void positionSquares(size_t index, Square *squares, int count, bool &weakToMove) {
+    weakToMove = index & 1;
+    index /= 2;
+    for (int piece=count-1; piece>0; piece--) {
+        squares[piece] = Square(index % 64);
+        index /= 64;
+    }
+    squares[0] = SquareFrom(index % 4, Rank(index / 4));
+}
+
+#pragma mark - Generation
+
+// State of each position during the generation: the round of the analysis when the position was found to be
+// won, or one of these values. The positions won in the first round are the mates and the positions where
+// a capture or a promotion reaches a position won in a bitbase already generated.
+enum PositionState: uint16_t {
+    UNKNOWN = 0, FIRST_ROUND = 1, DRAWN = 0xFFFE, INVALID = 0xFFFF
+};
+
+static void setupBoard(ChessBoard &board, const Square *squares, const std::vector<Piece> &pieces, bool weakToMove) {
+    board.clear();
+    board.castling = 0;
+    board.enPassantSquare = 0;
+    board.halfMoveClock = 0;
+    board.color = weakToMove ? BLACK : WHITE;
+    board.set({ false, WHITE, KING }, FileFrom(squares[0]), RankFrom(squares[0]));
+    board.set({ false, BLACK, KING }, FileFrom(squares[1]), RankFrom(squares[1]));
+    for (size_t index=0; index<pieces.size(); index++) {
+        board.set({ false, WHITE, pieces[index] }, FileFrom(squares[index + 2]), RankFrom(squares[index + 2]));
+    }
+}
+
+// Squares where the piece can come from, without any capture (which would come from another bitbase).
+// The pawns, which are white, move backward.
+static Bitboard unmoves(Piece piece, Square square, Bitboard occupancy) {
+    switch (piece) {
+        case PAWN: {
+            Bitboard squares = 0;
+            if (RankFrom(square) >= 2 && !bb_test(occupancy, square - 8)) {
+                bb_set(squares, square - 8);
+                if (RankFrom(square) == 3 && !bb_test(occupancy, square - 16)) {
+                    bb_set(squares, square - 16);
+                }
+            }
+            return squares;
+        }
+        case KNIGHT:
+            return KnightMoves[square] & ~occupancy;
+        case BISHOP:
+            return BishopAttacks(square, occupancy) & ~occupancy;
+        case ROOK:
+            return RookAttacks(square, occupancy) & ~occupancy;
+        case QUEEN:
+            return (RookAttacks(square, occupancy) | BishopAttacks(square, occupancy)) & ~occupancy;
+        default:
+            return KingMoves[square] & ~occupancy;
+    }
+}
+
+} // namespace
+
+#pragma mark - Bitbases
+
+Bitbases::~Bitbases() {
+    unmap();
+}
+
+std::unique_ptr<Bitbases::Bitbase> Bitbases::create(std::string signature) {
+    // The first and last characters are the kings
+    if (signature.size() < 3 || signature.size() > MaxPieces || signature.front() != 'K' || signature.back() != 'K') {
+        return nullptr;
+    }
+
+    std::unique_ptr<Bitbase> bitbase(new Bitbase());
+    for (char c : signature.substr(1, signature.size() - 2)) {
+        auto piece = std::string("PNBRQ").find(c);
+        if (piece == std::string::npos) {
+            return nullptr;
+        }
+        bitbase->pieces.push_back(Piece(piece));
+    }
+
+    std::sort(bitbase->pieces.begin(), bitbase->pieces.end(), [](Piece a, Piece b) {
+        return a > b;
+    });
+    bitbase->signature = signatureOf(bitbase->pieces);
+    bitbase->key = materialKey(bitbase->pieces);
+    bitbase->hasPawns = std::find(bitbase->pieces.begin(), bitbase->pieces.end(), PAWN) != bitbase->pieces.end();
+    bitbase->positions = positionCount(bitbase->hasPawns, int(bitbase->pieces.size()) + 2);
+    return bitbase;
+}
+
+bool Bitbases::isValidSignature(std::string signature) {
+    return create(signature) != nullptr;
+}
+
+const Bitbases::Bitbase *Bitbases::find(uint32_t key) const {
+    for (auto &bitbase : bitbases) {
+        if (bitbase->key == key) {
+            return bitbase.get();
+        }
+    }
+    return nullptr;
+}
+
+void Bitbases::add(std::unique_ptr<Bitbase> bitbase) {
+    maxPieces = std::max(maxPieces, int(bitbase->pieces.size()) + 2);
+    for (auto &existing : bitbases) {
+        if (existing->key == bitbase->key) {
+            existing = std::move(bitbase);
+            return;
+        }
+    }
+    bitbases.push_back(std::move(bitbase));
+}
+
+void Bitbases::unmap() {
+    if (mapping) {
+        munmap(mapping, mappingSize);
+        mapping = nullptr;
+        mappingSize = 0;
+    }
+}
+
+void Bitbases::clear() {
+    bitbases.clear();
+    unmap();
+    maxPieces = 0;
+    version++;
+}
+
+std::vector<std::string> Bitbases::signatures() const {
+    std::vector<std::string> signatures;
+    for (auto &bitbase : bitbases) {
+        signatures.push_back(bitbase->signature);
+    }
+    return signatures;
+}
+
+bool Bitbases::probe(ChessBoard &board, int &outcome) const {
+    if (bb_count(board.getOccupancy()) > maxPieces || board.castling) {
+        return false;
+    }
+
+    Color strong;
+    if (board.allPieces(BLACK) == board.pieces[BLACK][KING]) {
+        strong = WHITE;
+    } else if (board.allPieces(WHITE) == board.pieces[WHITE][KING]) {
+        strong = BLACK;
+    } else {
+        return false;
+    }
+
+    auto bitbase = find(materialKey(board, strong));
+    if (!bitbase) {
+        return false;
+    }
+
+    // The bitbases have the stronger side being white, otherwise the board is flipped vertically
+    int flip = strong == WHITE ? 0 : 56;
+    Square squares[MaxPieces];
+    squares[0] = lsb(board.pieces[strong][KING]) ^ flip;
+    squares[1] = lsb(board.pieces[INVERSE(strong)][KING]) ^ flip;
+    int count = 2;
+    for (auto piece : SignatureOrder) {
+        for (Bitboard pieces = board.pieces[strong][piece]; pieces; pieces &= pieces - 1) {
+            squares[count++] = lsb(pieces) ^ flip;
+        }
+    }
+
+    auto index = positionIndex(squares, count, bitbase->hasPawns, board.color != strong);
+    outcome = bitbase->isWin(index) ? (strong == WHITE ? 1 : -1) : 0;
+    return true;
+}
+
+bool Bitbases::generate(std::vector<std::string> signatures, Callback callback) {
+    std::set<std::string> requested;
+    for (auto signature : signatures) {
+        auto bitbase = create(signature);
+        if (!bitbase) {
+            return false;
+        }
+        requested.insert(bitbase->signature);
+    }
+
+    // The dependencies come before the bitbases depending on them
+    std::vector<std::string> order;
+    std::set<std::string> visited;
+    std::function<void(std::string)> visit = [&](std::string signature) {
+        if (!visited.insert(signature).second) {
+            return;
+        }
+        for (auto dependency : dependencies(create(signature)->pieces)) {
+            visit(dependency);
+        }
+        order.push_back(signature);
+    };
+    for (auto signature : requested) {
+        visit(signature);
+    }
+
+    for (auto signature : order) {
+        auto bitbase = create(signature);
+        if (requested.count(signature) || !find(bitbase->key)) {
+            generate(*bitbase, callback);
+            add(std::move(bitbase));
+        }
+    }
+    version++;
+    return true;
+}
+
+// Retrograde analysis: the won positions are found round after round, starting from the mates. A position
+// with the stronger side to move is won as soon as one of its moves reaches a won position, and a position
+// with the lone king to move is won once all its moves reach a won position, which is tracked by counting
+// down its moves that are not known to be won yet. Instead of generating the moves of each position again
+// and again, the moves leading to the positions won in a round are played backward (the un-moves) to find
+// the positions that need to be updated. Each round is processed in parallel, a position being updated
+// atomically. The positions not won when a round finds no new position are draws.
+void Bitbases::generate(Bitbase &bitbase, Callback callback) {
+    auto start = steady_clock::now();
+
+    auto &pieces = bitbase.pieces;
+    int count = int(pieces.size()) + 2;
+    std::vector<std::atomic<uint16_t>> states(bitbase.positions);
+    std::vector<std::atomic<uint8_t>> remainingMoves(bitbase.positions);
+
+    auto initialState = [&](size_t index, ChessBoard &board) -> uint16_t {
+        Square squares[MaxPieces];
+        bool weakToMove;
+        positionSquares(index, squares, count, weakToMove);
+        for (int piece=0; piece<count; piece++) {
+            for (int other=0; other<piece; other++) {
+                if (squares[piece] == squares[other]) {
+                    return INVALID;
+                }
+            }
+            if (piece >= 2 && pieces[piece - 2] == PAWN && (RankFrom(squares[piece]) == 0 || RankFrom(squares[piece]) == 7)) {
+                return INVALID;
+            }
+        }
+
+        setupBoard(board, squares, pieces, weakToMove);
+        if (board.isCheck(INVERSE(board.color))) {
+            return INVALID;
+        }
+
+        auto moves = ChessMoveGenerator::generateMoves(board);
+        if (moves.count == 0) {
+            return weakToMove && board.isCheck(board.color) ? FIRST_ROUND : DRAWN;
+        }
+
+        // The captures and promotions leave the bitbase: their outcome is known
+        int remaining = 0;
+        for (int index=0; index<moves.count; index++) {
+            auto move = moves[index];
+            if (!MOVE_IS_CAPTURE(move) && MOVE_PROMOTION_PIECE(move) == 0) {
+                remaining++;
+                continue;
+            }
+
+            auto newBoard = board;
+            newBoard.move(move);
+            int outcome = 0;
+            bool won = probe(newBoard, outcome) && outcome == 1;
+            if (won && !weakToMove) {
+                return FIRST_ROUND;
+            }
+            if (!won && weakToMove) {
+                return DRAWN;
+            }
+        }
+
+        if (weakToMove) {
+            if (remaining == 0) {
+                return FIRST_ROUND;
+            }
+            remainingMoves[index].store(uint8_t(remaining), std::memory_order_relaxed);
+        }
+        return UNKNOWN;
+    };
+
+    parallelFor(bitbase.positions, threads, [&](int, size_t start, size_t end) {
+        ChessBoard board;
+        for (size_t index=start; index<end; index++) {
+            states[index].store(initialState(index, board), std::memory_order_relaxed);
+        }
+    });
+
+    // Updates the positions leading to a position won in the round
+    auto propagate = [&](size_t index, uint16_t round) {
+        Square squares[MaxPieces];
+        bool weakToMove;
+        positionSquares(index, squares, count, weakToMove);
+        Bitboard occupancy = 0;
+        for (int piece=0; piece<count; piece++) {
+            bb_set(occupancy, squares[piece]);
+        }
+
+        for (int piece=0; piece<count; piece++) {
+            // Only the side that moved last can be moved backward, the lone king being the second piece
+            if ((piece == 1) == weakToMove) {
+                continue;
+            }
+            auto type = piece < 2 ? KING : pieces[piece - 2];
+            for (Bitboard from = unmoves(type, squares[piece], occupancy); from; from &= from - 1) {
+                Square previous[MaxPieces];
+                std::copy(squares, squares + count, previous);
+                previous[piece] = lsb(from);
+                auto previousIndex = positionIndex(previous, count, bitbase.hasPawns, !weakToMove);
+                auto &state = states[previousIndex];
+                if (weakToMove) {
+                    uint16_t unknown = UNKNOWN;
+                    state.compare_exchange_strong(unknown, round + 1);
+                } else if (state.load() == UNKNOWN && remainingMoves[previousIndex].fetch_sub(1) == 1) {
+                    state.store(round + 1);
+                }
+            }
+        }
+    };
+
+    for (uint16_t round=FIRST_ROUND; ; round++) {
+        std::atomic<bool> progress(false);
+        parallelFor(bitbase.positions, threads, [&](int, size_t start, size_t end) {
+            for (size_t index=start; index<end; index++) {
+                if (states[index].load(std::memory_order_relaxed) == round) {
+                    propagate(index, round);
+                    progress = true;
+                }
+            }
+        });
+        if (!progress) {
+            break;
+        }
+    }
+
+    size_t positions = 0;
+    size_t wins = 0;
+    bitbase.storage.assign((bitbase.positions + 63) / 64, 0);
+    for (size_t index=0; index<bitbase.positions; index++) {
+        auto state = states[index].load(std::memory_order_relaxed);
+        positions += state != INVALID;
+        if (state >= FIRST_ROUND && state < DRAWN) {
+            bitbase.storage[index / 64] |= uint64_t(1) << (index % 64);
+            wins++;
+        }
+    }
+    bitbase.bits = bitbase.storage.data();
+
+    if (callback) {
+        callback(bitbase.signature, positions, wins, duration<double, std::milli>(steady_clock::now() - start).count());
+    }
+}
+
+#pragma mark - File
+
+// The file starts with the magic "BCBB", the version of the format and the number of bitbases, followed by
+// the signature, the offset in the file of the bits and the number of positions of each bitbase. The bits
+// are aligned on 64 bytes so they can be used directly from the file mapped in memory.
+// Note: the values are stored in little-endian, which is the byte order of all the supported platforms.
+static const char Magic[4] = { 'B', 'C', 'B', 'B' };
+static const uint32_t FileVersion = 1;
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+};
+
+struct FileEntry {
+    char signature[8];
+    uint64_t offset;
+    uint64_t positions;
+};
+
+inline static uint64_t alignedOffset(uint64_t offset) {
+    return (offset + 63) & ~uint64_t(63);
+}
+
+bool Bitbases::save(std::string path) {
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    FileHeader header = { };
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = FileVersion;
+    header.count = uint32_t(bitbases.size());
+    bool success = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    std::vector<FileEntry> entries(bitbases.size());
+    uint64_t offset = alignedOffset(sizeof(FileHeader) + entries.size() * sizeof(FileEntry));
+    for (size_t index=0; index<bitbases.size(); index++) {
+        auto &entry = entries[index];
+        strncpy(entry.signature, bitbases[index]->signature.c_str(), sizeof(entry.signature));
+        entry.offset = offset;
+        entry.positions = bitbases[index]->positions;
+        offset = alignedOffset(offset + (entry.positions + 63) / 64 * sizeof(uint64_t));
+    }
+    success = success && fwrite(entries.data(), sizeof(FileEntry), entries.size(), file) == entries.size();
+
+    for (size_t index=0; index<bitbases.size() && success; index++) {
+        success = fseek(file, long(entries[index].offset), SEEK_SET) == 0 &&
+                  fwrite(bitbases[index]->bits, sizeof(uint64_t), (entries[index].positions + 63) / 64, file) == (entries[index].positions + 63) / 64;
+    }
+    return fclose(file) == 0 && success;
+}
+
+bool Bitbases::load(std::string path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+
+    struct stat status;
+    void *address = MAP_FAILED;
+    if (fstat(fd, &status) == 0 && status.st_size >= (off_t)sizeof(FileHeader)) {
+        address = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (address == MAP_FAILED) {
+        return false;
+    }
+
+    size_t size = status.st_size;
+    auto data = (const uint8_t *)address;
+    FileHeader header;
+    memcpy(&header, data, sizeof(header));
+    bool valid = memcmp(header.magic, Magic, sizeof(Magic)) == 0 && header.version == FileVersion &&
+                 sizeof(FileHeader) + header.count * sizeof(FileEntry) <= size;
+
+    std::vector<std::unique_ptr<Bitbase>> loaded;
+    for (uint32_t index=0; index<header.count && valid; index++) {
+        FileEntry entry;
+        memcpy(&entry, data + sizeof(FileHeader) + index * sizeof(FileEntry), sizeof(entry));
+        auto bitbase = create(std::string(entry.signature, strnlen(entry.signature, sizeof(entry.signature))));
+        valid = bitbase && bitbase->positions == entry.positions && entry.offset % 64 == 0 &&
+                entry.offset + (entry.positions + 63) / 64 * sizeof(uint64_t) <= size;
+        if (valid) {
+            bitbase->bits = (const uint64_t *)(data + entry.offset);
+            loaded.push_back(std::move(bitbase));
+        }
+    }
+
+    if (!valid) {
+        munmap(address, size);
+        return false;
+    }
+
+    clear();
+    mapping = address;
+    mappingSize = size;
+    for (auto &bitbase : loaded) {
+        add(std::move(bitbase));
+    }
+    return true;
+}
@@ -0,0 +1,107 @@
+//
+//  Bitbases.hpp
+//  BChess
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#pragma once
+
+#include "ChessBoard.hpp"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Win/draw bitbases of the endgames where one side only has its king, like KPK, KRK, KQK or KBNK:
+// one bit for each position tells if the stronger side wins. Unlike the Syzygy tablebases (see Tablebases),
+// they don't need any external file: they are generated in-process, by retrograde analysis, and can then
+// be saved to a file which is memory-mapped when loaded.
+// https://www.chessprogramming.org/Retrograde_Analysis
+//
+// The material of a bitbase is its signature, the pieces of the stronger side (king first) followed by the
+// lone king, with at most two pieces besides the kings. A position is indexed by the squares of its pieces
+// and the side to move, the board being mirrored to have the king of the stronger side on the files a to d
+// (and, without pawns, on the ranks 1 to 4), which divides the size by 2 (or 4). KBNK takes 1 MB.
+//
+// Note: the bitbases ignore castling, so a position with castling rights is never probed.
+class Bitbases {
+public:
+    // Number of threads generating a bitbase
+    int threads = std::max(1, (int)std::thread::hardware_concurrency());
+
+    Bitbases() = default;
+    Bitbases(const Bitbases&) = delete;
+    Bitbases &operator=(const Bitbases&) = delete;
+    ~Bitbases();
+
+    // Returns true if the signature, like KPK or KBNK, can have a bitbase
+    static bool isValidSignature(std::string signature);
+
+    // Generates the bitbases of the signatures, with the ones they depend on (the positions reached by a capture
+    // or a promotion), replacing the bitbases of the same material. The callback is invoked after each bitbase
+    // with the number of legal positions and the number of positions won. Returns false if a signature is invalid.
+    typedef std::function<void(std::string signature, size_t positions, size_t wins, double milliseconds)> Callback;
+    bool generate(std::vector<std::string> signatures, Callback callback = nullptr);
+
+    // Loads the bitbases from a file created by save(), replacing the ones loaded or generated before.
+    // Returns false, leaving the bitbases unchanged, if the file cannot be read or has an invalid format.
+    // Note: no search must be running because the bitbases in use are unmapped.
+    bool load(std::string path);
+    bool save(std::string path);
+
+    void clear();
+
+    // Signatures of the bitbases available
+    std::vector<std::string> signatures() const;
+
+    // Incremented each time the bitbases change, which invalidates the evaluations already computed
+    int getVersion() const {
+        return version;
+    }
+
+    // Returns true if the position is in one of the bitbases, the outcome being 1 if white
+    // wins, -1 if black wins and 0 for a draw.
+    bool probe(ChessBoard &board, int &outcome) const;
+
+private:
+    struct Bitbase {
+        std::string signature;
+
+        // Pieces of the stronger side besides its king, and their number of each kind (see materialKey())
+        std::vector<Piece> pieces;
+        uint32_t key = 0;
+        bool hasPawns = false;
+
+        size_t positions = 0;
+
+        // One bit for each position, either in the storage or in the file mapped
+        const uint64_t *bits = nullptr;
+        std::vector<uint64_t> storage;
+
+        bool isWin(size_t index) const {
+            return (bits[index / 64] >> (index % 64)) & 1;
+        }
+    };
+
+    std::vector<std::unique_ptr<Bitbase>> bitbases;
+
+    // Largest number of pieces, kings included, of the bitbases available
+    int maxPieces = 0;
+
+    int version = 0;
+
+    void *mapping = nullptr;
+    size_t mappingSize = 0;
+
+    static std::unique_ptr<Bitbase> create(std::string signature);
+
+    const Bitbase *find(uint32_t key) const;
+    void add(std::unique_ptr<Bitbase> bitbase);
+    void unmap();
+
+    // Generates the bitbase, the ones it depends on having been generated before
+    void generate(Bitbase &bitbase, Callback callback);
+};
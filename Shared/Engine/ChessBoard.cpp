@@ -10,14 +10,10 @@
 #include "ChessBoardHash.hpp"
 
 #include <bitstring.h>
+#include <algorithm>
 #include <iostream>
 #include <cassert>
-#include "magicmoves.h"
-
-Bitboard PawnAttacks[2][64];
-
-Bitboard KingMoves[64];
-Bitboard KnightMoves[64];
+#include "SlidingAttacks.hpp"
 
 /**
 rank
@@ -179,6 +175,23 @@ static Bitboard IBlackPawns = BB(0b\
 00000000\
 );
 
+// Castling availability that remains after a piece moves from or to a particular square:
+// moving the king or a rook, or capturing a rook, removes the corresponding castling.
+static const uint8_t CastlingMask[64] = {
+    // a1 ... h1
+    ALL_CASTLING & ~WHITE_QUEEN_SIDE, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING,
+    ALL_CASTLING & ~(WHITE_KING_SIDE|WHITE_QUEEN_SIDE), ALL_CASTLING, ALL_CASTLING, ALL_CASTLING & ~WHITE_KING_SIDE,
+    ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING,
+    ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING,
+    ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING,
+    ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING,
+    ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING,
+    ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING,
+    // a8 ... h8
+    ALL_CASTLING & ~BLACK_QUEEN_SIDE, ALL_CASTLING, ALL_CASTLING, ALL_CASTLING,
+    ALL_CASTLING & ~(BLACK_KING_SIDE|BLACK_QUEEN_SIDE), ALL_CASTLING, ALL_CASTLING, ALL_CASTLING & ~BLACK_KING_SIDE,
+};
+
 #pragma mark -
 
 ChessBoard::ChessBoard() {
@@ -187,8 +200,12 @@ ChessBoard::ChessBoard() {
 
 void ChessBoard::clear() {
     memset(pieces, 0, sizeof(pieces));
-    occupancyDirty = true;
+    memset(mailbox, EMPTY_SQUARE, sizeof(mailbox));
+    updateOccupancy();
     hash = 0; // need to recompute it
+    pawnHash = 0;
+    materialKey = 0;
+    phase = 0;
 }
 
 void ChessBoard::reset() {
@@ -208,19 +225,31 @@ void ChessBoard::reset() {
     pieces[BLACK][BISHOP] = IBlackBishops;
     pieces[BLACK][KNIGHT] = IBlackKnights;
     
+    for (unsigned color=0; color<Color::COUNT; color++) {
+        for (unsigned piece=0; piece<Piece::PCOUNT; piece++) {
+            auto squares = pieces[color][piece];
+            while (squares > 0) {
+                Square square = lsb(squares);
+                bb_clear(squares, square);
+                mailbox[square] = SQUARE_CONTENT(Color(color), Piece(piece));
+                materialKey += MATERIAL_KEY(Color(color), Piece(piece));
+            }
+        }
+    }
+    updateOccupancy();
+    
     color = WHITE;
     
-    whiteCanCastleKingSide = true;
-    whiteCanCastleQueenSide = true;
-    blackCanCastleKingSide = true;
-    blackCanCastleQueenSide = true;
+    castling = ALL_CASTLING;
     
-    enPassant = 0;
+    enPassantSquare = 0;
     halfMoveClock = 0;
     fullMoveCount = 1;
     
     // Make sure to start with the hash representation of the initial board
     hash = getHash();
+    pawnHash = ChessBoardHash::pawnHash(*this);
+    phase = TotalPhase;
 }
 
 void ChessBoard::move(Move move) {
@@ -228,7 +257,9 @@ void ChessBoard::move(Move move) {
         fullMoveCount++;
     }
 
-    halfMoveClock++;
+    if (halfMoveClock < UINT8_MAX) {
+        halfMoveClock++;
+    }
     
     auto moveColor = MOVE_COLOR(move);
     auto movePiece = MOVE_PIECE(move);
@@ -238,10 +269,10 @@ void ChessBoard::move(Move move) {
     
     ChessBoard::move(moveColor, movePiece, from, to);
     
+    castling &= CastlingMask[from] & CastlingMask[to];
+    
     if (movePiece == KING) {
         if (moveColor == WHITE) {
-            whiteCanCastleKingSide = whiteCanCastleQueenSide = false;
-            
             if (from == e1 && to == g1) {
                 // White castle king side, need to move the rook
                 ChessBoard::move(moveColor, ROOK, h1, f1);
@@ -251,8 +282,6 @@ void ChessBoard::move(Move move) {
                 ChessBoard::move(moveColor, ROOK, a1, d1);
             }
         } else {
-            blackCanCastleKingSide = blackCanCastleQueenSide = false;
-            
             if (from == e8 && to == g8) {
                 // Black castle king side, need to move the rook
                 ChessBoard::move(moveColor, ROOK, h8, f8);
@@ -274,68 +303,64 @@ void ChessBoard::move(Move move) {
     if (promotionPiece > PAWN) {
         bb_clear(pieces[color][movePiece], to);
         bb_set(pieces[color][promotionPiece], to);
+        mailbox[to] = SQUARE_CONTENT(color, promotionPiece);
         
         // Update the hash
         hash ^= ChessBoardHash::getPseudoNumber(to, color, movePiece); // Remove the piece that is going to be promoted
         hash ^= ChessBoardHash::getPseudoNumber(to, color, promotionPiece); // Set the promoted piece
+        pawnHash ^= ChessBoardHash::getPseudoNumber(to, color, movePiece);
+        materialKey += MATERIAL_KEY(color, promotionPiece) - MATERIAL_KEY(color, movePiece);
+        phase += PhaseWeight[promotionPiece];
     }
     
     // First detect if the move is the "en-passant" move
     if (MOVE_IS_ENPASSANT(move)) {
         auto otherColor = INVERSE(moveColor);
-        auto enPassantSquare = lsb(enPassant);
         // The pawn to remove by the "en-passant" move is actually below the pawn doing the "en-passant" move.
-        if (moveColor == WHITE) {
-            enPassantSquare -= 8;
-        } else {
-            enPassantSquare += 8;
-        }
+        Square capturedSquare = moveColor == WHITE ? enPassantSquare - 8 : enPassantSquare + 8;
         
-        bb_clear(pieces[otherColor][PAWN], enPassantSquare);
+        bb_clear(pieces[otherColor][PAWN], capturedSquare);
+        bb_clear(colorOccupancy[otherColor], capturedSquare);
+        mailbox[capturedSquare] = EMPTY_SQUARE;
         
         // Update the hash by removing the pawn being captured by the "en-passant" move
-        hash ^= ChessBoardHash::getPseudoNumber(enPassantSquare, otherColor, PAWN);
+        hash ^= ChessBoardHash::getPseudoNumber(capturedSquare, otherColor, PAWN);
+        pawnHash ^= ChessBoardHash::getPseudoNumber(capturedSquare, otherColor, PAWN);
     }
     
     // Detect if a pawn moves two squares in order to enable
-    // the "en-passant" move. Clear the enPassant bitboard
+    // the "en-passant" move. Clear the en-passant square
     // in case no en-passant is found.
-    enPassant = 0;
+    enPassantSquare = 0;
     if (movePiece == PAWN) {
         auto fromRank = RankFrom(from);
         auto toRank = RankFrom(to);
         if (moveColor == WHITE && toRank - fromRank == 2) {
-            bb_set(enPassant, from+8);
+            enPassantSquare = from+8;
         } else if (moveColor == BLACK && fromRank - toRank == 2) {
-            bb_set(enPassant, from-8);
+            enPassantSquare = from-8;
         }
     }
 
-    if (movePiece == ROOK) {
-        if (moveColor == WHITE) {
-            if (from == a1) {
-                whiteCanCastleQueenSide = false;
-            } else if (from == h1) {
-                whiteCanCastleKingSide = false;
-            }
-        } else {
-            if (from == a8) {
-                blackCanCastleQueenSide = false;
-            } else if (from == h8) {
-                blackCanCastleKingSide = false;
-            }
-        }
-    }
-    
     if (MOVE_IS_CAPTURE(move)) {
         halfMoveClock = 0; // reset halfmove clock if capture is done
         
         auto otherColor = INVERSE(moveColor);
         auto capturedPiece = MOVE_CAPTURED_PIECE(move);
+        // Note: the mailbox and the occupancy already contain the moving piece on that square
         bb_clear(pieces[otherColor][capturedPiece], to);
+        bb_clear(colorOccupancy[otherColor], to);
+        phase -= PhaseWeight[capturedPiece];
+        materialKey -= MATERIAL_KEY(otherColor, capturedPiece);
         
-        // Update the hash by removing the piece being captured
-        hash ^= ChessBoardHash::getPseudoNumber(to, otherColor, capturedPiece);
+        // Update the hash by removing the piece being captured, except for the "en-passant"
+        // move whose captured pawn is not on that square and has already been removed above.
+        if (!MOVE_IS_ENPASSANT(move)) {
+            hash ^= ChessBoardHash::getPseudoNumber(to, otherColor, capturedPiece);
+            if (capturedPiece == PAWN) {
+                pawnHash ^= ChessBoardHash::getPseudoNumber(to, otherColor, PAWN);
+            }
+        }
     }
 
     // Switch the side that is moving
@@ -347,41 +372,67 @@ void ChessBoard::undo_move(Move move) {
     ChessBoard::move(MOVE_COLOR(move), MOVE_PIECE(move), MOVE_TO(move), MOVE_FROM(move));
 }
 
-Bitboard ChessBoard::getOccupancy() {
-    if (occupancyDirty) {
-        auto whitePieces = allPieces(Color::WHITE);
-        auto blackPieces = allPieces(Color::BLACK);
-        occupancy = whitePieces|blackPieces;
-        occupancyDirty = false;
+void ChessBoard::updateOccupancy() {
+    for (unsigned color=0; color<Color::COUNT; color++) {
+        colorOccupancy[color] = pieces[color][PAWN]|
+        pieces[color][ROOK]|
+        pieces[color][KNIGHT]|
+        pieces[color][BISHOP]|
+        pieces[color][QUEEN]|
+        pieces[color][KING];
     }
-    return occupancy;
 }
 
 Move ChessBoard::getMove(std::string from, std::string to) {
     Square fromSquare = squareForName(from);
     Square toSquare = squareForName(to);
-    for (unsigned piece=PAWN; piece<Piece::PCOUNT; piece++) {
-        if (bb_test(pieces[color][piece], fromSquare)) {
-            auto attackedColor = INVERSE(color);
-            bool capture = bb_test(allPieces(attackedColor), toSquare);
-            if (capture) {
-                unsigned attackedPiece = PAWN;
-                for (; attackedPiece<PCOUNT; attackedPiece++) {
-                    if (bb_test(pieces[attackedColor][attackedPiece], toSquare)) {
-                        break;
-                    }
-                }
-                assert(attackedPiece != PCOUNT);
-                Move m = createCapture(fromSquare, toSquare, color, Piece(piece), attackedColor, Piece(attackedPiece));
-                return m;
-            } else {
-                Move m = createMove(fromSquare, toSquare, color, Piece(piece));
-                return m;
-            }
+    auto fromContent = mailbox[fromSquare];
+    if (fromContent == EMPTY_SQUARE || SQUARE_CONTENT_COLOR(fromContent) != color) {
+        return 0; // Invalid move
+    }
+    
+    auto piece = SQUARE_CONTENT_PIECE(fromContent);
+    auto toContent = mailbox[toSquare];
+    auto attackedColor = INVERSE(color);
+    if (toContent != EMPTY_SQUARE && SQUARE_CONTENT_COLOR(toContent) == attackedColor) {
+        return createCapture(fromSquare, toSquare, color, piece, attackedColor, SQUARE_CONTENT_PIECE(toContent));
+    } else {
+        return createMove(fromSquare, toSquare, color, piece);
+    }
+}
+
+Move ChessBoard::decodeMove(CompactMove compact) const {
+    auto from = COMPACT_MOVE_FROM(compact);
+    auto to = COMPACT_MOVE_TO(compact);
+    auto fromContent = mailbox[from];
+    auto toContent = mailbox[to];
+    if (compact == INVALID_COMPACT_MOVE || fromContent == EMPTY_SQUARE || SQUARE_CONTENT_COLOR(fromContent) != color ||
+        (toContent != EMPTY_SQUARE && SQUARE_CONTENT_COLOR(toContent) == color)) {
+        return INVALID_MOVE;
+    }
+    
+    auto piece = SQUARE_CONTENT_PIECE(fromContent);
+    switch (COMPACT_MOVE_FLAG(compact)) {
+        case COMPACT_ENPASSANT:
+            return createEnPassant(from, to, color, piece);
+            
+        case COMPACT_CASTLING:
+            return createCastling(from, to, color, piece);
+            
+        default:
             break;
-        }
     }
-    return 0; // Invalid move
+    
+    Move move;
+    if (toContent != EMPTY_SQUARE) {
+        move = createCapture(from, to, color, piece, INVERSE(color), SQUARE_CONTENT_PIECE(toContent));
+    } else {
+        move = createMove(from, to, color, piece);
+    }
+    if (COMPACT_MOVE_FLAG(compact) == COMPACT_PROMOTION) {
+        SET_MOVE_PROMOTION_PIECE(move, COMPACT_MOVE_PROMOTION_PIECE(compact));
+    }
+    return move;
 }
 
 void ChessBoard::move(Color color, Piece piece, Square from, Square to) {
@@ -393,8 +444,16 @@ void ChessBoard::move(Color color, Piece piece, Square from, Square to) {
     bb_set(pieces[color][piece], to);
     hash ^= ChessBoardHash::getPseudoNumber(to, color, piece);
     
-    // Needs to re-compute the occupancy bitboard
-    occupancyDirty = true;
+    if (piece == PAWN) {
+        pawnHash ^= ChessBoardHash::getPseudoNumber(from, color, PAWN) ^ ChessBoardHash::getPseudoNumber(to, color, PAWN);
+    }
+    
+    mailbox[from] = EMPTY_SQUARE;
+    mailbox[to] = SQUARE_CONTENT(color, piece);
+    
+    // Update the occupancy bitboards
+    bb_clear(colorOccupancy[color], from);
+    bb_set(colorOccupancy[color], to);
 }
 
 inline static std::string charForPiece(Color color, Piece piece) {
@@ -439,49 +498,36 @@ void ChessBoard::print() {
 }
 
 BoardSquare ChessBoard::get(File file, Rank rank) {
-    BoardSquare square;
-    if (bb_test(getOccupancy(), file, rank)) {
-        for (unsigned color=0; color<Color::COUNT; color++) {
-            for (unsigned piece=0; piece<Piece::PCOUNT; piece++) {
-                if (bb_test(pieces[color][piece], file, rank)) {
-                    square.empty = false;
-                    square.color = Color(color);
-                    square.piece = Piece(piece);
-                    return square;
-                }
-            }
-        }
-    } else {
-        square.empty = true;
-    }
-    return square;
+    return get(SquareFrom(file, rank));
 }
 
 void ChessBoard::set(BoardSquare square, File file, Rank rank) {
-    if (square.empty) {
-        for (unsigned color=0; color<Color::COUNT; color++) {
-            for (unsigned piece=0; piece<Piece::PCOUNT; piece++) {
-                bb_clear(pieces[color][piece], file, rank);
-            }
+    auto index = SquareFrom(file, rank);
+    
+    // Remove the piece currently on that square, if any
+    auto content = mailbox[index];
+    if (content != EMPTY_SQUARE) {
+        bb_clear(pieces[SQUARE_CONTENT_COLOR(content)][SQUARE_CONTENT_PIECE(content)], index);
+        phase -= PhaseWeight[SQUARE_CONTENT_PIECE(content)];
+        materialKey -= MATERIAL_KEY(SQUARE_CONTENT_COLOR(content), SQUARE_CONTENT_PIECE(content));
+        if (SQUARE_CONTENT_PIECE(content) == PAWN) {
+            pawnHash ^= ChessBoardHash::getPseudoNumber(index, SQUARE_CONTENT_COLOR(content), PAWN);
         }
+    }
+    
+    if (square.empty) {
+        mailbox[index] = EMPTY_SQUARE;
     } else {
-        bb_set(pieces[square.color][square.piece], file, rank);
+        bb_set(pieces[square.color][square.piece], index);
+        mailbox[index] = SQUARE_CONTENT(square.color, square.piece);
+        phase += PhaseWeight[square.piece];
+        materialKey += MATERIAL_KEY(square.color, square.piece);
+        if (square.piece == PAWN) {
+            pawnHash ^= ChessBoardHash::getPseudoNumber(index, square.color, PAWN);
+        }
     }
     hash = 0; // Need to recompute it
-    occupancyDirty = true;
-}
-
-Bitboard ChessBoard::allPieces(Color color) {
-    return pieces[color][PAWN]|
-    pieces[color][ROOK]|
-    pieces[color][KNIGHT]|
-    pieces[color][BISHOP]|
-    pieces[color][QUEEN]|
-    pieces[color][KING];    
-}
-
-Bitboard ChessBoard::emptySquares() {
-    return ~getOccupancy();
+    updateOccupancy();
 }
 
 bool ChessBoard::isAttacked(Square square, Color byColor) {
@@ -507,14 +553,14 @@ bool ChessBoard::isAttacked(Square square, Color byColor) {
     }
     
     // Same for bishop (and queen)
-    auto rawBishopMoves = Bmagic(square, getOccupancy());
+    auto rawBishopMoves = BishopAttacks(square, getOccupancy());
     auto bishopMoves = rawBishopMoves & (pieces[byColor][Piece::BISHOP]|pieces[byColor][Piece::QUEEN]);
     if (bishopMoves > 0) {
         return true;
     }
     
     // Same for rook (and queen)
-    auto rawRookMoves = Rmagic(square, getOccupancy());
+    auto rawRookMoves = RookAttacks(square, getOccupancy());
     auto rookMoves = rawRookMoves & (pieces[byColor][Piece::ROOK]|pieces[byColor][Piece::QUEEN]);
     if (rookMoves > 0) {
         return true;
@@ -523,6 +569,16 @@ bool ChessBoard::isAttacked(Square square, Color byColor) {
     return false;
 }
 
+Bitboard ChessBoard::attackersTo(Square square, Color byColor, Bitboard occupancy) const {
+    // Same as isAttacked but collecting all the attacking pieces
+    Bitboard attackers = PawnAttacks[INVERSE(byColor)][square] & pieces[byColor][Piece::PAWN];
+    attackers |= KingMoves[square] & pieces[byColor][Piece::KING];
+    attackers |= KnightMoves[square] & pieces[byColor][Piece::KNIGHT];
+    attackers |= BishopAttacks(square, occupancy) & (pieces[byColor][Piece::BISHOP]|pieces[byColor][Piece::QUEEN]);
+    attackers |= RookAttacks(square, occupancy) & (pieces[byColor][Piece::ROOK]|pieces[byColor][Piece::QUEEN]);
+    return attackers;
+}
+
 bool ChessBoard::isCheck(Color color) {
     // Locate the king
     auto kingBoard = pieces[color][Piece::KING];
@@ -536,6 +592,59 @@ bool ChessBoard::isCheck(Color color) {
     return isAttacked(kingSquare, otherColor);
 }
 
+// Value of the pieces for the static exchange evaluation
+static constexpr int ExchangeValue[PCOUNT] = { 100, 320, 330, 500, 900, 20000 };
+
+int ChessBoard::staticExchange(Move move) const {
+    auto from = MOVE_FROM(move);
+    auto to = MOVE_TO(move);
+    
+    // Material won after each capture, from the point of view of the side capturing
+    int gain[32];
+    int captures = 0;
+    gain[0] = MOVE_IS_CAPTURE(move) ? ExchangeValue[MOVE_CAPTURED_PIECE(move)] : 0;
+    
+    auto occupancy = getOccupancy() & ~(1UL << from);
+    if (MOVE_IS_ENPASSANT(move)) {
+        occupancy &= ~(1UL << (MOVE_COLOR(move) == WHITE ? to - 8 : to + 8));
+    }
+    
+    // The pieces removed from the occupancy reveal the sliding pieces behind them
+    auto target = MOVE_PIECE(move);
+    auto side = INVERSE(MOVE_COLOR(move));
+    while (captures < 31) {
+        auto attackers = attackersTo(to, side, occupancy) & occupancy;
+        if (attackers == 0) {
+            break;
+        }
+        
+        Piece attacker = PAWN;
+        while ((attackers & pieces[side][attacker]) == 0) {
+            attacker = Piece(attacker + 1);
+        }
+        auto attackerSquare = lsb(attackers & pieces[side][attacker]);
+        
+        // The king cannot capture a defended piece
+        if (attacker == KING && (attackersTo(to, INVERSE(side), occupancy) & occupancy) != 0) {
+            break;
+        }
+        
+        captures++;
+        gain[captures] = ExchangeValue[target] - gain[captures - 1];
+        
+        target = attacker;
+        occupancy &= ~(1UL << attackerSquare);
+        side = INVERSE(side);
+    }
+    
+    // Each side only captures when it doesn't lose material, starting from the last capture
+    while (captures > 0) {
+        gain[captures - 1] = -std::max(-gain[captures - 1], gain[captures]);
+        captures--;
+    }
+    return gain[0];
+}
+
 BoardHash ChessBoard::getHash() {
     if (hash == 0) {
         hash = ChessBoardHash::hash(*this);
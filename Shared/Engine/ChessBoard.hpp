@@ -11,49 +11,110 @@
 #include "Move.hpp"
 #include "Bitboard.hpp"
 #include "Types.hpp"
+#include "LeaperAttacks.hpp"
 
 #include <stdio.h>
 #include <string>
 
-extern Bitboard PawnAttacks[2][64];
-extern Bitboard KingMoves[64];
-extern Bitboard KnightMoves[64];
-
 struct BoardSquare {
     bool empty;
     Color color;
     Piece piece;
 };
 
+// Content of a square of the mailbox (see ChessBoard::mailbox) stored in 8 bits:
+// the piece for a white piece, the piece + PCOUNT for a black piece
+// (the same index as the Zobrist keys) or EMPTY_SQUARE.
+typedef uint8_t SquareContent;
+
+static const SquareContent EMPTY_SQUARE = 2 * PCOUNT;
+
+inline static SquareContent SQUARE_CONTENT(Color color, Piece piece) {
+    return SquareContent(piece + color * PCOUNT);
+}
+
+inline static Color SQUARE_CONTENT_COLOR(SquareContent content) {
+    return content < PCOUNT ? WHITE : BLACK;
+}
+
+inline static Piece SQUARE_CONTENT_PIECE(SquareContent content) {
+    return Piece(content < PCOUNT ? content : content - PCOUNT);
+}
+
+// Material of a position: the number of pieces of each color and kind, 4 bits each,
+// at the index of their SquareContent (the white pieces in the lowest bits).
+typedef uint64_t MaterialKey;
+
+inline static MaterialKey MATERIAL_KEY(Color color, Piece piece, unsigned count = 1) {
+    return MaterialKey(count) << (4 * SQUARE_CONTENT(color, piece));
+}
+
+inline static unsigned MATERIAL_COUNT(MaterialKey key, Color color, Piece piece) {
+    return (key >> (4 * SQUARE_CONTENT(color, piece))) & 0xF;
+}
+
+// Castling availability stored as a 4-bit mask
+enum CastlingRight: uint8_t {
+    WHITE_KING_SIDE = 1,
+    WHITE_QUEEN_SIDE = 2,
+    BLACK_KING_SIDE = 4,
+    BLACK_QUEEN_SIDE = 8,
+    ALL_CASTLING = 15
+};
+
+// Weight of each piece in the game phase (see ChessBoard::phase): the phase goes
+// from TotalPhase, with all the pieces on the board, down to 0 with only pawns and kings.
+// https://www.chessprogramming.org/Tapered_Eval
+static constexpr uint8_t PhaseWeight[PCOUNT] = { 0, 1, 1, 2, 4, 0 };
+static constexpr int TotalPhase = 24;
+
+// Note: the board is copied for each node of the search and for each candidate
+// move, so the fields are ordered from the largest to the smallest to avoid
+// any padding (see the static_assert at the end of this file).
 struct ChessBoard {
 private:
-    Bitboard occupancy = 0;
+    // Occupancy of the pieces of each color, updated incrementally each time a piece
+    // is moved, added or removed (the occupancy of all the pieces is their union).
+    Bitboard colorOccupancy[COUNT] = { };
+    
     BoardHash hash = 0;
     
-public:
-    Color color = WHITE;
+    // Zobrist key of the pawns only, updated incrementally, used by the pawn hash table
+    BoardHash pawnHash = 0;
+    
+    // Material of the position, updated incrementally, used to find the specialized
+    // evaluation of the endgames (see Endgames)
+    MaterialKey materialKey = 0;
     
-    bool occupancyDirty = false;
+    void updateOccupancy();
     
+public:
     Bitboard pieces[COUNT][PCOUNT] = { };
     
-    // Bitboard representing the en-passant
-    // square (the one where the opposing pawn
-    // can move to) for the last move.
-    // Or 0 if no en-passant available.
-    Bitboard enPassant = 0;
+    // Piece on each square, kept in sync with the bitboards above,
+    // to find in constant time which piece sits on a particular square.
+    SquareContent mailbox[64];
     
-    // Halfmove clock: This is the number of halfmoves since the last capture or pawn advance. This is used to determine if a draw can be claimed under the fifty-move rule.
-    int halfMoveClock = 0;
-
     // Fullmove number: The number of the full move. It starts at 1, and is incremented after Black's move
-    int fullMoveCount = 1;
-
-    // Castling availability (KQkq)
-    bool whiteCanCastleKingSide = true;
-    bool whiteCanCastleQueenSide = true;
-    bool blackCanCastleKingSide = true;
-    bool blackCanCastleQueenSide = true;
+    uint16_t fullMoveCount = 1;
+    
+    // Halfmove clock: This is the number of halfmoves since the last capture or pawn advance. This is used to determine if a draw can be claimed under the fifty-move rule.
+    uint8_t halfMoveClock = 0;
+    
+    // Castling availability (KQkq), see CastlingRight
+    uint8_t castling = ALL_CASTLING;
+    
+    // En-passant square (the one where the opposing pawn
+    // can move to) for the last move.
+    // Or 0 if no en-passant available (a1 can never be
+    // an en-passant square).
+    Square enPassantSquare = 0;
+    
+    // Sum of the PhaseWeight of the pieces of both colors, updated incrementally.
+    // Note: it can exceed TotalPhase after a promotion.
+    uint8_t phase = TotalPhase;
+    
+    Color color = WHITE;
     
     ChessBoard();
     
@@ -62,45 +123,100 @@ public:
     void clear();
     
     BoardSquare get(File file, Rank rank);
+    BoardSquare get(Square square) const {
+        BoardSquare boardSquare;
+        auto content = mailbox[square];
+        boardSquare.empty = content == EMPTY_SQUARE;
+        if (!boardSquare.empty) {
+            boardSquare.color = SQUARE_CONTENT_COLOR(content);
+            boardSquare.piece = SQUARE_CONTENT_PIECE(content);
+        }
+        return boardSquare;
+    }
+    
     void set(BoardSquare square, File file, Rank rank);
     
     Move getMove(std::string from, std::string to);
+    
+    // Returns the move of the side to move corresponding to the compact move, with the piece moved
+    // and the piece captured found on the board, or an invalid move if there is no piece of the side
+    // to move on the origin square or if there is one on the destination square.
+    // Note: the move itself is not validated, the compact move must come from this position.
+    Move decodeMove(CompactMove compact) const;
 
     void move(Move move);
     void undo_move(Move move);
     
     void move(Color color, Piece piece, Square from, Square to);
     
-    Bitboard allPieces(Color color);
-    Bitboard emptySquares();
+    Bitboard allPieces(Color color) const {
+        return colorOccupancy[color];
+    }
+    
+    Bitboard emptySquares() const {
+        return ~getOccupancy();
+    }
     
-    Bitboard getOccupancy();
+    Bitboard getOccupancy() const {
+        return colorOccupancy[WHITE]|colorOccupancy[BLACK];
+    }
     
     bool isAttacked(Square square, Color byColor);
     
+    // Returns the pieces of the specified color attacking the square, the sliding
+    // attacks being computed with the specified occupancy.
+    Bitboard attackersTo(Square square, Color byColor, Bitboard occupancy) const;
+    
     bool isCheck(Color color);
     
+    // Static exchange evaluation: returns the material won (or lost when negative) by the side playing
+    // the move when both sides keep capturing on its destination square, with their least valuable piece
+    // first, and can stop whenever capturing would lose material.
+    // https://www.chessprogramming.org/Static_Exchange_Evaluation
+    int staticExchange(Move move) const;
+    
     BoardHash getHash();
     
+    BoardHash getPawnHash() const {
+        return pawnHash;
+    }
+    
+    MaterialKey getMaterialKey() const {
+        return materialKey;
+    }
+    
+    bool canCastle(CastlingRight right) const {
+        return (castling & right) != 0;
+    }
+    
     void setCastling(std::string castling) {
-        whiteCanCastleKingSide = castling.find('K') != std::string::npos;
-        whiteCanCastleQueenSide = castling.find('Q') != std::string::npos;
-        blackCanCastleKingSide = castling.find('k') != std::string::npos;
-        blackCanCastleQueenSide = castling.find('q') != std::string::npos;
+        this->castling = 0;
+        if (castling.find('K') != std::string::npos) {
+            this->castling |= WHITE_KING_SIDE;
+        }
+        if (castling.find('Q') != std::string::npos) {
+            this->castling |= WHITE_QUEEN_SIDE;
+        }
+        if (castling.find('k') != std::string::npos) {
+            this->castling |= BLACK_KING_SIDE;
+        }
+        if (castling.find('q') != std::string::npos) {
+            this->castling |= BLACK_QUEEN_SIDE;
+        }
     }
     
     std::string getCastling() {
         std::string castling = "";
-        if (whiteCanCastleKingSide) {
+        if (canCastle(WHITE_KING_SIDE)) {
             castling += "K";
         }
-        if (whiteCanCastleQueenSide) {
+        if (canCastle(WHITE_QUEEN_SIDE)) {
             castling += "Q";
         }
-        if (blackCanCastleKingSide) {
+        if (canCastle(BLACK_KING_SIDE)) {
             castling += "k";
         }
-        if (blackCanCastleQueenSide) {
+        if (canCastle(BLACK_QUEEN_SIDE)) {
             castling += "q";
         }
         if (castling.size() == 0) {
@@ -112,3 +228,4 @@ public:
     void print();
 };
 
+static_assert(sizeof(ChessBoard) == 208, "ChessBoard layout should stay compact");
@@ -10,15 +10,25 @@
 #include "ChessMoveGenerator.hpp"
 #include "ChessBoard.hpp"
 #include "GameHistory.hpp"
+#include "Endgames.hpp"
 
 #include "magicmoves.h"
 
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <memory>
 
 bool ChessEvaluater::positionalAnalysis = false;
 
+NeuralNetwork ChessEvaluater::network;
+bool ChessEvaluater::neuralEvaluation = false;
+
+Bitbases ChessEvaluater::bitbases;
+
 // All these numbers are taken from https://chessprogramming.wikispaces.com/Simplified+evaluation+function
-static int PawnPositionBonus[64] = {
+static constexpr int PawnPositionBonus[64] = {
     0,  0,  0,  0,  0,  0,  0,  0,
     50, 50, 50, 50, 50, 50, 50, 50,
     10, 10, 20, 30, 30, 20, 10, 10,
@@ -29,7 +39,7 @@ static int PawnPositionBonus[64] = {
     0,  0,  0,  0,  0,  0,  0,  0
 };
 
-static int KnightPositionBonus[64] = {
+static constexpr int KnightPositionBonus[64] = {
     -50,-40,-30,-30,-30,-30,-40,-50,
     -40,-20,  0,  0,  0,  0,-20,-40,
     -30,  0, 10, 15, 15, 10,  0,-30,
@@ -40,7 +50,7 @@ static int KnightPositionBonus[64] = {
     -50,-40,-30,-30,-30,-30,-40,-50,
 };
 
-static int BishopPositionBonus[64] = {
+static constexpr int BishopPositionBonus[64] = {
     -20,-10,-10,-10,-10,-10,-10,-20,
     -10,  0,  0,  0,  0,  0,  0,-10,
     -10,  0,  5, 10, 10,  5,  0,-10,
@@ -51,7 +61,7 @@ static int BishopPositionBonus[64] = {
     -20,-10,-10,-10,-10,-10,-10,-20,
 };
 
-static int RookPositionBonus[64] = {
+static constexpr int RookPositionBonus[64] = {
     0,  0,  0,  0,  0,  0,  0,  0,
     5, 10, 10, 10, 10, 10, 10,  5,
     -5,  0,  0,  0,  0,  0,  0, -5,
@@ -62,7 +72,7 @@ static int RookPositionBonus[64] = {
     0,  0,  0,  5,  5,  0,  0,  0
 };
 
-static int QueenPositionBonus[64] = {
+static constexpr int QueenPositionBonus[64] = {
     -20,-10,-10, -5, -5,-10,-10,-20,
     -10,  0,  0,  0,  0,  0,  0,-10,
     -10,  0,  5,  5,  5,  5,  0,-10,
@@ -73,8 +83,7 @@ static int QueenPositionBonus[64] = {
     -20,-10,-10, -5, -5,-10,-10,-20
 };
 
-// TODO: see wiki to implement the end game position bonus for king
-static int KingPositionBonus[64] = {
+static constexpr int KingPositionBonus[64] = {
     -30,-40,-40,-50,-50,-40,-40,-30,
     -30,-40,-40,-50,-50,-40,-40,-30,
     -30,-40,-40,-50,-50,-40,-40,-30,
@@ -85,18 +94,137 @@ static int KingPositionBonus[64] = {
     20, 30, 10,  0,  0, 10, 30, 20
 };
 
-static int PieceValue[PCOUNT] = { 100, 320, 330, 500, 900, 20000 };
+// In the endgame, the pawns are worth more the closer they are to promotion
+static constexpr int PawnEndgamePositionBonus[64] = {
+    0,  0,  0,  0,  0,  0,  0,  0,
+    80, 80, 80, 80, 80, 80, 80, 80,
+    50, 50, 50, 50, 50, 50, 50, 50,
+    30, 30, 30, 30, 30, 30, 30, 30,
+    15, 15, 15, 15, 15, 15, 15, 15,
+    5,  5,  5,  5,  5,  5,  5,  5,
+    0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0
+};
+
+static constexpr int RookEndgamePositionBonus[64] = {
+    0,  0,  0,  0,  0,  0,  0,  0,
+    10, 10, 10, 10, 10, 10, 10, 10,
+    0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0
+};
+
+// In the endgame, the king must leave its shelter and go to the center
+static constexpr int KingEndgamePositionBonus[64] = {
+    -50,-40,-30,-20,-20,-30,-40,-50,
+    -30,-20,-10,  0,  0,-10,-20,-30,
+    -30,-10, 20, 30, 30, 20,-10,-30,
+    -30,-10, 30, 40, 40, 30,-10,-30,
+    -30,-10, 30, 40, 40, 30,-10,-30,
+    -30,-10, 20, 30, 30, 20,-10,-30,
+    -30,-30,  0,  0,  0,  0,-30,-30,
+    -50,-30,-30,-30,-30,-30,-30,-50
+};
+
+// The knights, bishops and queens use the same table in both stages
+static constexpr const int *PositionBonus[ChessEvaluater::STAGE_COUNT][PCOUNT] = {
+    { PawnPositionBonus, KnightPositionBonus, BishopPositionBonus, RookPositionBonus, QueenPositionBonus, KingPositionBonus },
+    { PawnEndgamePositionBonus, KnightPositionBonus, BishopPositionBonus, RookEndgamePositionBonus, QueenPositionBonus, KingEndgamePositionBonus }
+};
+
+static constexpr int PieceValue[ChessEvaluater::STAGE_COUNT][PCOUNT] = {
+    { 100, 320, 330, 500, 900, 20000 },
+    { 120, 300, 320, 530, 920, 20000 }
+};
+
+// The tables above are from the point of view of white with a8 first
+static constexpr Square whiteIndex(Square original) {
+    return (7-RankFrom(original))*8+FileFrom(original);
+}
+
+// https://www.chessprogramming.org/Pawn_Structure
+static const int DoubledPawnPenalty = 10;
+static const int IsolatedPawnPenalty = 10;
+static const int BackwardPawnPenalty = 8;
+
+// Bonus of a passed pawn for each rank, from the point of view of its color
+static const int PassedPawnBonus[8] = { 0, 5, 10, 20, 35, 60, 100, 0 };
 
-static Square whiteIndex(Square original) {
-    auto rank = RankFrom(original);
-    auto file = FileFrom(original);
-    return (7-rank)*8+file;
+static ChessEvaluater::Weights defaultWeights() {
+    ChessEvaluater::Weights weights = { };
+    for (int stage=0; stage<ChessEvaluater::STAGE_COUNT; stage++) {
+        for (unsigned piece=0; piece<PCOUNT; piece++) {
+            weights.pieceValue[stage][piece] = PieceValue[stage][piece];
+            for (Square square=0; square<64; square++) {
+                weights.positionBonus[stage][piece][square] = PositionBonus[stage][piece][whiteIndex(square)];
+            }
+        }
+    }
+    
+    // Advantage when a pair of bishop is detected, which is worth 1/2 pawn
+    // https://www.chess.com/article/view/the-evaluation-of-material-imbalances-by-im-larry-kaufman
+    weights.bishopPair = PieceValue[ChessEvaluater::MIDDLEGAME][PAWN] / 2;
+    
+    // A defended piece is worth one point. An attacked piece costs one point
+    // to the other color, plus ten points because it is not defended against
+    // that particular attack (see evaluateAction).
+    weights.defendedPiece = 1;
+    weights.attackedPiece = 11;
+    
+    weights.mobility = 1;
+    
+    weights.doubledPawn = DoubledPawnPenalty;
+    weights.isolatedPawn = IsolatedPawnPenalty;
+    weights.backwardPawn = BackwardPawnPenalty;
+    std::copy(std::begin(PassedPawnBonus), std::end(PassedPawnBonus), weights.passedPawn);
+    return weights;
 }
 
-static Square blackIndex(Square original) {
-    auto rank = RankFrom(original);
-    auto file = FileFrom(original);
-    return rank*8+file;
+const ChessEvaluater::Weights ChessEvaluater::DefaultWeights = defaultWeights();
+
+ChessEvaluater::Weights ChessEvaluater::weights = ChessEvaluater::DefaultWeights;
+int ChessEvaluater::weightsVersion = 0;
+
+// Bonus of each piece for each stage, color and square (a1 first), built from the weights
+// so the evaluation doesn't have to flip the squares for each piece.
+struct BonusTables {
+    int bonus[ChessEvaluater::STAGE_COUNT][COUNT][PCOUNT][64];
+    
+    BonusTables(const ChessEvaluater::Weights &weights) {
+        build(weights);
+    }
+    
+    void build(const ChessEvaluater::Weights &weights) {
+        for (int stage=0; stage<ChessEvaluater::STAGE_COUNT; stage++) {
+            for (unsigned piece=0; piece<PCOUNT; piece++) {
+                for (Square square=0; square<64; square++) {
+                    bonus[stage][WHITE][piece][square] = weights.positionBonus[stage][piece][square];
+                    bonus[stage][BLACK][piece][square] = weights.positionBonus[stage][piece][square ^ 56];
+                }
+            }
+        }
+    }
+};
+
+static BonusTables Bonus = BonusTables(ChessEvaluater::DefaultWeights);
+
+// Trace used by the evaluation when the contribution of the weights is not needed,
+// which the compiler optimizes away entirely.
+struct NullTrace {
+    int phase;
+    
+    void add(const int &, int) { }
+};
+
+void ChessEvaluater::setWeights(const Weights &newWeights) {
+    weights = newWeights;
+    Bonus.build(weights);
+    
+    // The pawn structures evaluated with the previous weights are not valid anymore (see pawnTable())
+    weightsVersion++;
 }
 
 bool ChessEvaluater::isQuiet(Move move) {
@@ -107,30 +235,8 @@ bool ChessEvaluater::isQuiet(Move move) {
     return !MOVE_IS_CAPTURE(move) && MOVE_PROMOTION_PIECE(move) == 0 && !MOVE_IS_CHECK(move);
 }
 
-int ChessEvaluater::getBonus(Piece piece, Color color, Square square) {
-    auto index = color == WHITE ? whiteIndex(square) : blackIndex(square);
-    switch (piece) {
-        case PAWN:
-            return PawnPositionBonus[index];
-            
-        case BISHOP:
-            return BishopPositionBonus[index];
-            
-        case KNIGHT:
-            return KnightPositionBonus[index];
-            
-        case ROOK:
-            return RookPositionBonus[index];
-            
-        case KING:
-            return KingPositionBonus[index];
-            
-        case QUEEN:
-            return QueenPositionBonus[index];
-            
-        default:
-            return 0;
-    }
+int ChessEvaluater::getBonus(Piece piece, Color color, Square square, Stage stage) {
+    return Bonus.bonus[stage][color][piece][square];
 }
 
 bool ChessEvaluater::isDraw(ChessBoard board, HistoryPtr history) {
@@ -138,13 +244,24 @@ bool ChessEvaluater::isDraw(ChessBoard board, HistoryPtr history) {
 }
 
 int ChessEvaluater::evaluate(ChessBoard board, HistoryPtr history) {
-    auto moves = ChessMoveGenerator::generateMoves(board, board.color, ChessMoveGenerator::Mode::firstMoveOnly);
-    return evaluate(board, history, moves);
+    AttackInfo info(board);
+    return evaluate(info, history);
 }
 
 int ChessEvaluater::evaluate(ChessBoard board, HistoryPtr history, MoveList moves) {
+    AttackInfo info(board);
+    return evaluate(info, history, moves);
+}
+
+int ChessEvaluater::evaluate(AttackInfo &info, HistoryPtr history, const NeuralAccumulator *accumulator) {
+    auto moves = ChessMoveGenerator::generateMoves(info, info.board.color, ChessMoveGenerator::Mode::firstMoveOnly);
+    return evaluate(info, history, moves, accumulator);
+}
+
+int ChessEvaluater::evaluate(AttackInfo &info, HistoryPtr history, MoveList &moves, const NeuralAccumulator *accumulator) {
+    auto &board = info.board;
     if (moves.count == 0) {
-        if (board.isCheck(board.color)) {
+        if (info.isCheck(board.color)) {
             // No moves but a check, that's a mat
             // Note: always evaluate from white's point of view
             return board.color == WHITE ? -MAT_VALUE : MAT_VALUE;
@@ -160,135 +277,462 @@ int ChessEvaluater::evaluate(ChessBoard board, HistoryPtr history, MoveList move
         return 0;
     }
     
-    // Compute the piece balance value
+    // The endgames with a specialized evaluation, found from the material
+    auto endgame = Endgames::probe(board.getMaterialKey());
+    if (endgame && endgame->draw) {
+        return 0;
+    }
+    
+    // The outcome of the positions of the bitbases is known: a draw is exactly a draw
+    int outcome;
+    bool bitbasePosition = bitbases.probe(board, outcome);
+    if (bitbasePosition && outcome == 0) {
+        return 0;
+    }
+    
+    int value;
+    if (endgame && endgame->evaluation) {
+        value = endgame->evaluation(board, endgame->strong);
+    } else {
+        if (useNeuralNetwork()) {
+            value = accumulator ? network.evaluate(board, *accumulator) : network.evaluate(board);
+        } else {
+            value = evaluatePosition(info);
+        }
+        if (endgame && endgame->scale) {
+            value = value * endgame->scale(board, endgame->strong) / Endgames::NormalScale;
+        }
+    }
+    
+    if (bitbasePosition) {
+        value += outcome * BITBASE_WIN_VALUE;
+    }
+    return value;
+}
+
+int ChessEvaluater::evaluatePosition(AttackInfo &info) {
+    NullTrace trace;
+    return computePosition(info, trace);
+}
+
+int ChessEvaluater::evaluatePosition(AttackInfo &info, EvaluationTrace &trace) {
+    return computePosition(info, trace);
+}
+
+template <class Trace> int ChessEvaluater::computePosition(AttackInfo &info, Trace &trace) {
+    auto &board = info.board;
+    
+    // Compute the piece balance value, separately for the middlegame and the endgame,
+    // the two being interpolated according to the phase of the game.
+    // https://www.chessprogramming.org/Tapered_Eval
     int value = 0;
+    int middlegame = 0;
+    int endgame = 0;
     for (unsigned color=0; color<COUNT; color++) {
         // Note: always evaluate from white's point of view
         int colorSign = (color == WHITE) ? 1 : -1;
         
-        // The bonus of the pieces' locations, for that particular color
-        int totalBonus = 0;
         for (unsigned piece=0; piece<PCOUNT; piece++) {
             Bitboard pieces = board.pieces[color][piece];
             int count = bb_count(pieces);
-            int pvalue = PieceValue[piece];
 
-            value += colorSign * (pvalue * count);
+            middlegame += colorSign * weights.pieceValue[MIDDLEGAME][piece] * count;
+            endgame += colorSign * weights.pieceValue[ENDGAME][piece] * count;
+            trace.add(weights.pieceValue[MIDDLEGAME][piece], colorSign * count);
+            trace.add(weights.pieceValue[ENDGAME][piece], colorSign * count);
             
-            // Advantage when a pair of bishop is detected, which is worth 1/2 pawn
-            // https://www.chess.com/article/view/the-evaluation-of-material-imbalances-by-im-larry-kaufman
+            // Advantage when a pair of bishop is detected
             if (piece == BISHOP && count >= 2) {
-                value += color * (PieceValue[PAWN]/2);
+                value += colorSign * weights.bishopPair;
+                trace.add(weights.bishopPair, colorSign);
             }
             
             // Now let's add some bonus depending on the piece location
+            auto &middlegameBonus = Bonus.bonus[MIDDLEGAME][color][piece];
+            auto &endgameBonus = Bonus.bonus[ENDGAME][color][piece];
             while (pieces > 0) {
                 Square square = lsb(pieces);
                 bb_clear(pieces, square);
                 
-                totalBonus += getBonus((Piece)piece, (Color)color, square);
+                middlegame += colorSign * middlegameBonus[square];
+                endgame += colorSign * endgameBonus[square];
+                
+                Square whiteSquare = color == WHITE ? square : square ^ 56;
+                trace.add(weights.positionBonus[MIDDLEGAME][piece][whiteSquare], colorSign);
+                trace.add(weights.positionBonus[ENDGAME][piece][whiteSquare], colorSign);
             }
         }
-        
-        value += colorSign * totalBonus;
     }
     
+    int phase = std::min((int)board.phase, TotalPhase);
+    value += (middlegame * phase + endgame * (TotalPhase - phase)) / TotalPhase;
+    trace.phase = phase;
+    
     // Compute the piece action value (either attacked, defended or hanging) and mobility
     // See http://www.chessbin.com/post/Chess-Board-Evaluation
     if (positionalAnalysis) {
-        auto moveList = ChessMoveGenerator::generateMoves(board, board.color, ChessMoveGenerator::Mode::moveCaptureAndDefenseMoves);
-        auto opponentMoveList = ChessMoveGenerator::generateMoves(board, INVERSE(board.color), ChessMoveGenerator::Mode::moveCaptureAndDefenseMoves);
-        
-        value += evaluateAction(moveList) + evaluateAction(opponentMoveList);
-        value += evaluateMobility(moveList) + evaluateMobility(opponentMoveList);
+        value += evaluateAction(info, trace);
+        value += evaluateMobility(info, trace);
+        value += tracePawns(board, trace).score;
     }
     
     return value;
 }
 
 int ChessEvaluater::evaluateAction(ChessBoard board) {
-    auto moveList = ChessMoveGenerator::generateMoves(board, board.color, ChessMoveGenerator::Mode::moveCaptureAndDefenseMoves);
-    auto opponentMoveList = ChessMoveGenerator::generateMoves(board, INVERSE(board.color), ChessMoveGenerator::Mode::moveCaptureAndDefenseMoves);
-    return evaluateAction(moveList) + evaluateAction(opponentMoveList);
+    AttackInfo info(board);
+    NullTrace trace;
+    return evaluateAction(info, trace);
 }
 
-// TODO: at some point, give more value to pawn when attacking or defending than queen?
-//static int PieceActionValue[PCOUNT] = { 6, 3, 3, 2, 1, 1 };
+static constexpr Bitboard FileA = 0x0101010101010101UL;
+static constexpr Bitboard FileH = 0x8080808080808080UL;
+static constexpr Bitboard PawnPushRank[COUNT] = { 0xFF0000UL, 0xFF0000000000UL }; // Rank after the initial one
+static constexpr Bitboard PawnPromotionRank[COUNT] = { 0xFF000000000000UL, 0xFF00UL }; // Rank before the last one
+static constexpr Square KingInitialSquare[COUNT] = { e1, e8 };
 
-int ChessEvaluater::evaluateAction(MoveList moves) {
-    int attackedValues[2][64] = { };
-    int defendedValues[2][64] = { };
+// Returns the number of pieces in the targets attacked by the pawns, a piece attacked
+// by two pawns counting twice (which is why the captures to each side are kept separate).
+static int pawnAttacks(Bitboard pawns, Color color, Bitboard targets) {
+    if (color == WHITE) {
+        return bb_count(((pawns & ~FileA) << 7) & targets) + bb_count(((pawns & ~FileH) << 9) & targets);
+    } else {
+        return bb_count(((pawns & ~FileA) >> 9) & targets) + bb_count(((pawns & ~FileH) >> 7) & targets);
+    }
+}
+
+// Returns the number of pushes (one or two squares) of the pawns
+static int pawnPushes(Bitboard pawns, Color color, Bitboard emptySquares) {
+    if (color == WHITE) {
+        auto onePush = (pawns << 8) & emptySquares;
+        return bb_count(onePush) + bb_count(((onePush & PawnPushRank[color]) << 8) & emptySquares);
+    } else {
+        auto onePush = (pawns >> 8) & emptySquares;
+        return bb_count(onePush) + bb_count(((onePush & PawnPushRank[color]) >> 8) & emptySquares);
+    }
+}
+
+// Returns the number of castling moves the king of the specified color can do
+static int castlingMoves(AttackInfo &info, Color color) {
+    auto &board = info.board;
+    auto square = KingInitialSquare[color];
+    if (!bb_test(board.pieces[color][KING], square) || info.isCheck(color)) {
+        return 0;
+    }
     
-    for (int index=0; index<moves.count; index++) {
-        auto move = moves[index];
-        auto moveColor = MOVE_COLOR(move);
-        
-        if (MOVE_IS_CAPTURE(move)) {
-            auto to = MOVE_TO(move);
-            if (MOVE_CAPTURED_PIECE_COLOR(move) == MOVE_COLOR(move)) {
-                // Same color, means defense. Doesn't count towards
-                // mobility because in reality that piece cannot move.
-                defendedValues[moveColor][to]++;
-            } else {
-                // Different color means capture.
-                // This count also towards mobility.
-                attackedValues[INVERSE(moveColor)][to]++;
-            }
+    auto otherColor = INVERSE(color);
+    auto emptySquares = board.emptySquares();
+    int moves = 0;
+    if (board.canCastle(color == WHITE ? WHITE_KING_SIDE : BLACK_KING_SIDE)) {
+        Bitboard kingMoves = 1UL << (square+1) | 1UL << (square+2);
+        if ((kingMoves & emptySquares) == kingMoves && !info.isAttacked(square+1, otherColor) && !info.isAttacked(square+2, otherColor)) {
+            moves++;
         }
     }
-    
+    if (board.canCastle(color == WHITE ? WHITE_QUEEN_SIDE : BLACK_QUEEN_SIDE)) {
+        Bitboard kingMoves = 1UL << (square-1) | 1UL << (square-2) | 1UL << (square-3);
+        if ((kingMoves & emptySquares) == kingMoves && !info.isAttacked(square-1, otherColor) && !info.isAttacked(square-2, otherColor)) {
+            moves++;
+        }
+    }
+    return moves;
+}
+
+// TODO: at some point, give more value to pawn when attacking or defending than queen?
+//static int PieceActionValue[PCOUNT] = { 6, 3, 3, 2, 1, 1 };
+
+template <class Trace> int ChessEvaluater::evaluateAction(AttackInfo &info, Trace &trace) {
+    auto &board = info.board;
     int value = 0;
     
-    for (int index=0; index<64; index++) {
-        for (unsigned color=0; color<COUNT; color++) {
-            auto colorSign = (color == WHITE) ? 1 : -1;
-            
-            auto attacked = attackedValues[color][index];
-            auto defended = defendedValues[color][index];
-            
-            value -= colorSign * attacked;
-            value += colorSign * defended;
+    for (unsigned color=0; color<COUNT; color++) {
+        auto colorSign = (color == WHITE) ? 1 : -1;
+        auto ownPieces = board.allPieces((Color)color);
+        auto otherPieces = board.allPieces(INVERSE((Color)color));
+        
+        // Count how many times each piece defends a piece of the same color
+        // and attacks a piece of the other color. The attacks of a promoting pawn
+        // count for each of the four promoted pieces.
+        auto pawns = board.pieces[color][PAWN];
+        auto promotingPawns = pawns & PawnPromotionRank[color];
+        int defended = pawnAttacks(pawns, (Color)color, ownPieces) + 3 * pawnAttacks(promotingPawns, (Color)color, ownPieces);
+        int attacked = pawnAttacks(pawns, (Color)color, otherPieces) + 3 * pawnAttacks(promotingPawns, (Color)color, otherPieces);
+        
+        auto pieces = ownPieces & ~pawns;
+        while (pieces > 0) {
+            Square square = lsb(pieces);
+            bb_clear(pieces, square);
             
-            if (defended < attacked) {
-                value -= colorSign * ((attacked - defended) * 10);
-            }
+            auto attacks = info.attacksFrom(square);
+            defended += bb_count(attacks & ownPieces);
+            attacked += bb_count(attacks & otherPieces);
         }
-    }
         
+        // A defended piece is worth a few points. An attacked piece costs more to the
+        // other color because it is not defended against that particular attack (the attacks
+        // and the defenses of the two colors are not compared against each other).
+        value += colorSign * defended * weights.defendedPiece;
+        value += colorSign * attacked * weights.attackedPiece;
+        trace.add(weights.defendedPiece, colorSign * defended);
+        trace.add(weights.attackedPiece, colorSign * attacked);
+    }
+    
     return value;
 }
 
 int ChessEvaluater::evaluateMobility(ChessBoard board) {
-    auto moveList = ChessMoveGenerator::generateMoves(board, board.color, ChessMoveGenerator::Mode::moveCaptureAndDefenseMoves);
-    auto opponentMoveList = ChessMoveGenerator::generateMoves(board, INVERSE(board.color), ChessMoveGenerator::Mode::moveCaptureAndDefenseMoves);
-    return evaluateMobility(moveList) + evaluateMobility(opponentMoveList);
+    AttackInfo info(board);
+    NullTrace trace;
+    return evaluateMobility(info, trace);
 }
 
-int ChessEvaluater::evaluateMobility(MoveList moves) {
+template <class Trace> int ChessEvaluater::evaluateMobility(AttackInfo &info, Trace &trace) {
+    auto &board = info.board;
+    auto emptySquares = board.emptySquares();
     int mobility = 0;
     
-    for (int index=0; index<moves.count; index++) {
-        auto move = moves[index];
-        auto moveColor = MOVE_COLOR(move);
-        auto whiteMove = moveColor == WHITE;
-        auto colorSign = whiteMove ? 1 : -1;
+    for (unsigned color=0; color<COUNT; color++) {
+        auto colorSign = (color == WHITE) ? 1 : -1;
+        auto otherColor = INVERSE((Color)color);
+        auto ownPieces = board.allPieces((Color)color);
+        auto otherPieces = board.allPieces(otherColor);
         
-        if (MOVE_IS_CAPTURE(move)) {
-            if (MOVE_CAPTURED_PIECE_COLOR(move) != MOVE_COLOR(move)) {
-                // Different color means capture.
-                // This count also towards mobility.
-                mobility += colorSign * 1;
+        // Pawns: captures and pushes, a move to the last rank
+        // counting for each of the four promoted pieces.
+        auto pawns = board.pieces[color][PAWN];
+        auto promotingPawns = pawns & PawnPromotionRank[color];
+        mobility += colorSign * (pawnAttacks(pawns, (Color)color, otherPieces) + pawnPushes(pawns, (Color)color, emptySquares));
+        mobility += colorSign * 3 * (pawnAttacks(promotingPawns, (Color)color, otherPieces) + pawnPushes(promotingPawns, (Color)color, emptySquares));
+        
+        // Pieces: moves to an empty square or captures, the king cannot
+        // move to a square attacked by the other color.
+        auto pieces = ownPieces & ~pawns;
+        while (pieces > 0) {
+            Square square = lsb(pieces);
+            bb_clear(pieces, square);
+            
+            auto moves = info.attacksFrom(square) & ~ownPieces;
+            if (SQUARE_CONTENT_PIECE(board.mailbox[square]) == KING) {
+                moves &= ~info.attacksBy(otherColor);
             }
-        } else {
-            // Regular move, just count towards mobility
-            mobility += colorSign * 1;
+            mobility += colorSign * bb_count(moves);
+        }
+        
+        // Castling counts double because two pieces are moving
+        mobility += colorSign * 2 * castlingMoves(info, (Color)color);
+    }
+    
+    trace.add(weights.mobility, mobility);
+    return mobility * weights.mobility;
+}
+
+#pragma mark - Pawn structure
+
+// Fills the squares in front of (north) or behind (south) each piece of the bitboard, including its own square
+// https://www.chessprogramming.org/Pawn_Fills
+static Bitboard northFill(Bitboard bb) {
+    bb |= bb << 8;
+    bb |= bb << 16;
+    bb |= bb << 32;
+    return bb;
+}
+
+static Bitboard southFill(Bitboard bb) {
+    bb |= bb >> 8;
+    bb |= bb >> 16;
+    bb |= bb >> 32;
+    return bb;
+}
+
+PawnHashTable &ChessEvaluater::pawnTable() {
+    // Allocated on the heap because the table is too large for the thread storage
+    static thread_local std::unique_ptr<PawnHashTable> table;
+    static thread_local int tableWeightsVersion = 0;
+    if (!table) {
+        table.reset(new PawnHashTable());
+        tableWeightsVersion = weightsVersion;
+    } else if (tableWeightsVersion != weightsVersion) {
+        table->clear();
+        tableWeightsVersion = weightsVersion;
+    }
+    return *table;
+}
+
+PawnEntry ChessEvaluater::evaluatePawns(ChessBoard &board) {
+    auto &table = pawnTable();
+    PawnEntry entry;
+    auto pawnHash = board.getPawnHash();
+    if (!table.lookup(pawnHash, entry)) {
+        NullTrace trace;
+        entry = computePawnEntry(board, trace);
+        table.store(pawnHash, entry);
+    }
+    return entry;
+}
+
+PawnEntry ChessEvaluater::tracePawns(ChessBoard &board, NullTrace &) {
+    return evaluatePawns(board);
+}
+
+// The pawn table is not used when tracing because the trace of the cached entries is not available
+PawnEntry ChessEvaluater::tracePawns(ChessBoard &board, EvaluationTrace &trace) {
+    return computePawnEntry(board, trace);
+}
+
+template <class Trace> PawnEntry ChessEvaluater::computePawnEntry(ChessBoard &board, Trace &trace) {
+    PawnEntry entry;
+    
+    Bitboard pawns[COUNT] = { board.pieces[WHITE][PAWN], board.pieces[BLACK][PAWN] };
+    
+    // Squares in front of the pawns (same file), the pawns excluded
+    Bitboard frontSpans[COUNT] = { northFill(pawns[WHITE]) << 8, southFill(pawns[BLACK]) >> 8 };
+    
+    // Squares behind the pawns (same file), the pawns excluded
+    Bitboard rearSpans[COUNT] = { southFill(pawns[WHITE]) >> 8, northFill(pawns[BLACK]) << 8 };
+    
+    // Squares attacked by the pawns, now or when advancing
+    auto whiteFill = northFill(pawns[WHITE]);
+    auto blackFill = southFill(pawns[BLACK]);
+    entry.attackSpans[WHITE] = ((whiteFill & ~FileA) << 7) | ((whiteFill & ~FileH) << 9);
+    entry.attackSpans[BLACK] = ((blackFill & ~FileA) >> 9) | ((blackFill & ~FileH) >> 7);
+    
+    Bitboard attacks[COUNT] = {
+        ((pawns[WHITE] & ~FileA) << 7) | ((pawns[WHITE] & ~FileH) << 9),
+        ((pawns[BLACK] & ~FileA) >> 9) | ((pawns[BLACK] & ~FileH) >> 7)
+    };
+    
+    for (unsigned color=0; color<COUNT; color++) {
+        auto colorSign = (color == WHITE) ? 1 : -1;
+        auto otherColor = INVERSE((Color)color);
+        auto ownPawns = pawns[color];
+        
+        // A pawn is passed when no pawn of the other color can stop it or capture it
+        // (only the front pawn counts when the pawns are doubled)
+        entry.passed[color] = ownPawns & ~(frontSpans[otherColor] | entry.attackSpans[otherColor] | rearSpans[color]);
+        
+        // A pawn is doubled when there is another pawn in front of it
+        auto doubled = ownPawns & frontSpans[color];
+        
+        // A pawn is isolated when there is no pawn of the same color on the adjacent files
+        auto files = northFill(southFill(ownPawns));
+        auto isolated = ownPawns & ~(((files & ~FileA) >> 1) | ((files & ~FileH) << 1));
+        
+        // A pawn is backward when the square in front of it is attacked by a pawn of the other
+        // color and cannot be defended by the pawns of the same color (which are all in front)
+        auto stops = color == WHITE ? ownPawns << 8 : ownPawns >> 8;
+        auto backwardStops = stops & attacks[otherColor] & ~entry.attackSpans[color];
+        auto backward = color == WHITE ? backwardStops >> 8 : backwardStops << 8;
+        
+        int score = -weights.doubledPawn * bb_count(doubled) - weights.isolatedPawn * bb_count(isolated) - weights.backwardPawn * bb_count(backward);
+        trace.add(weights.doubledPawn, -colorSign * bb_count(doubled));
+        trace.add(weights.isolatedPawn, -colorSign * bb_count(isolated));
+        trace.add(weights.backwardPawn, -colorSign * bb_count(backward));
+        
+        auto passed = entry.passed[color];
+        while (passed > 0) {
+            Square square = lsb(passed);
+            bb_clear(passed, square);
             
-            // One more bonus when castling because two pieces are moving
-            if (MOVE_IS_CASTLING(move)) {
-                mobility += colorSign * 1;
+            Rank rank = RankFrom(square);
+            auto &bonus = weights.passedPawn[color == WHITE ? rank : 7 - rank];
+            score += bonus;
+            trace.add(bonus, colorSign);
+        }
+        
+        entry.score += colorSign * score;
+    }
+    
+    return entry;
+}
+
+#pragma mark - Weights
+
+std::vector<ChessEvaluater::Weights::Table> ChessEvaluater::Weights::tables() {
+    static const char *StageNames[STAGE_COUNT] = { "Middlegame", "Endgame" };
+    static const char *PieceNames[PCOUNT] = { "Pawn", "Knight", "Bishop", "Rook", "Queen", "King" };
+    
+    std::vector<Table> tables;
+    for (int stage=0; stage<STAGE_COUNT; stage++) {
+        tables.push_back({ std::string("PieceValue.") + StageNames[stage], pieceValue[stage], PCOUNT, Stage(stage), false });
+    }
+    for (int stage=0; stage<STAGE_COUNT; stage++) {
+        for (unsigned piece=0; piece<PCOUNT; piece++) {
+            tables.push_back({ std::string(PieceNames[piece]) + "PositionBonus." + StageNames[stage], positionBonus[stage][piece], 64, Stage(stage), true });
+        }
+    }
+    tables.push_back({ "BishopPair", &bishopPair, 1, STAGE_COUNT, false });
+    tables.push_back({ "DefendedPiece", &defendedPiece, 1, STAGE_COUNT, false });
+    tables.push_back({ "AttackedPiece", &attackedPiece, 1, STAGE_COUNT, false });
+    tables.push_back({ "Mobility", &mobility, 1, STAGE_COUNT, false });
+    tables.push_back({ "DoubledPawn", &doubledPawn, 1, STAGE_COUNT, false });
+    tables.push_back({ "IsolatedPawn", &isolatedPawn, 1, STAGE_COUNT, false });
+    tables.push_back({ "BackwardPawn", &backwardPawn, 1, STAGE_COUNT, false });
+    tables.push_back({ "PassedPawn", passedPawn, 8, STAGE_COUNT, false });
+    return tables;
+}
+
+// The file contains the name of each table followed by its values, the boards being
+// written with the 8th rank first like the tables at the top of this file.
+bool ChessEvaluater::Weights::save(std::string path) {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+    
+    file << "# BChess evaluation weights" << std::endl;
+    for (auto table : tables()) {
+        file << table.name;
+        for (int index=0; index<table.count; index++) {
+            if (table.board && index % 8 == 0) {
+                file << std::endl;
+            }
+            file << " " << table.values[table.board ? whiteIndex(index) : index];
+        }
+        file << std::endl;
+    }
+    return file.good();
+}
+
+bool ChessEvaluater::Weights::load(std::string path) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    
+    // Read the weights into a copy to leave these ones unchanged if the file is invalid
+    Weights weights = *this;
+    std::map<std::string, Table> tablesByName;
+    for (auto table : weights.tables()) {
+        tablesByName[table.name] = table;
+    }
+    
+    std::string line;
+    std::stringstream content;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] != '#') {
+            content << line << " ";
+        }
+    }
+    
+    std::string name;
+    while (content >> name) {
+        auto table = tablesByName.find(name);
+        if (table == tablesByName.end()) {
+            return false;
+        }
+        for (int index=0; index<table->second.count; index++) {
+            if (!(content >> table->second.values[table->second.board ? whiteIndex(index) : index])) {
+                return false;
             }
         }
+        tablesByName.erase(table);
+    }
+    
+    // All the tables must be in the file
+    if (!tablesByName.empty()) {
+        return false;
     }
     
-    return mobility;
+    *this = weights;
+    return true;
 }
@@ -10,6 +10,16 @@
 
 #include "ChessBoard.hpp"
 #include "MoveList.hpp"
+#include "AttackInfo.hpp"
+#include "PawnHashTable.hpp"
+#include "NeuralNetwork.hpp"
+#include "Bitbases.hpp"
+
+#include <string>
+#include <vector>
+
+struct EvaluationTrace;
+struct NullTrace;
 
 // https://chessprogramming.wikispaces.com/Evaluation
 class ChessEvaluater {
@@ -20,20 +30,149 @@ public:
     // the line of moves to the mat).
     static const int MAT_VALUE = 100000;
     
+    // Value of a position won according to the endgame tablebases: lower
+    // than a mat but greater than any evaluation of the position.
+    static const int TABLEBASE_WIN_VALUE = MAT_VALUE / 2;
+    
+    // Value of a position won according to the bitbases, to which the evaluation
+    // of the position is added for the search to make progress towards the mat.
+    static const int BITBASE_WIN_VALUE = TABLEBASE_WIN_VALUE / 2;
+    
+    // Value of a position known to be won (see Endgames), to which the material and
+    // the specialized evaluation of the endgame are added.
+    static const int KNOWN_WIN_VALUE = BITBASE_WIN_VALUE / 2;
+    
     static bool positionalAnalysis;
     
+    // The evaluation is computed for the middlegame and the endgame and interpolated
+    enum Stage: uint8_t {
+        MIDDLEGAME, ENDGAME, STAGE_COUNT
+    };
+    
+    // Weights of the hand-crafted evaluation, which can be tuned (see TexelTuner) and loaded
+    // from a file. All the weights are integers so the structure can be used as an array.
+    struct Weights {
+        int pieceValue[STAGE_COUNT][PCOUNT];
+        
+        // Bonus of each piece for each square (a1 first) from white's point of view
+        int positionBonus[STAGE_COUNT][PCOUNT][64];
+        
+        int bishopPair;
+        
+        // Used by the positional analysis only
+        int defendedPiece;
+        int attackedPiece;
+        int mobility;
+        int doubledPawn;
+        int isolatedPawn;
+        int backwardPawn;
+        int passedPawn[8]; // For each rank from the point of view of the pawn
+        
+        // Table of the weights, as named in the weights file
+        struct Table {
+            std::string name;
+            int *values;
+            int count;
+            
+            // Stage of the evaluation that uses these weights, STAGE_COUNT for both
+            Stage stage;
+            
+            // The table is a board, written with the 8th rank first
+            bool board;
+        };
+        
+        std::vector<Table> tables();
+        
+        // Loads the weights from a file created by save(). Returns false, leaving
+        // the weights unchanged, if the file cannot be read or has an invalid format.
+        bool load(std::string path);
+        bool save(std::string path);
+    };
+    
+    static const int WeightCount = sizeof(Weights) / sizeof(int);
+    
+    static const Weights DefaultWeights;
+    
+    // Weights currently used by the evaluation, changed with setWeights()
+    static const Weights &getWeights() {
+        return weights;
+    }
+    static void setWeights(const Weights &weights);
+    
+    // Network used instead of the hand-crafted evaluation when neuralEvaluation
+    // is true and the network has weights (see useNeuralNetwork()).
+    // Note: experimental and off by default: even with the accumulators updated incrementally,
+    // a network evaluation is still three to four times slower than the hand-crafted one
+    // (see ChessEngine::benchmarkEvaluation()) and no trained weights ship with the engine.
+    static NeuralNetwork network;
+    static bool neuralEvaluation;
+    
+    static bool useNeuralNetwork() {
+        return neuralEvaluation && network.isReady();
+    }
+    
+    // Bitbases of the endgames against a lone king, giving the exact outcome of their positions
+    static Bitbases bitbases;
+    
+    // Changes each time the evaluation of a position changes, because of the options
+    // above or of new weights, to invalidate the evaluations already cached.
+    static int evaluationVersion() {
+        return (((weightsVersion * 1024 + network.getVersion()) * 1024 + bitbases.getVersion()) << 2) | (useNeuralNetwork() << 1) | positionalAnalysis;
+    }
+    
     static bool isQuiet(Move move);    
     static bool isDraw(ChessBoard board, HistoryPtr history);
 
     static int evaluate(ChessBoard board, HistoryPtr history);
     static int evaluate(ChessBoard board, HistoryPtr history, MoveList moves);
+    
+    // Same as above but sharing the attack info of the node and, when the neural network
+    // is used, the accumulator of the node computed incrementally by the search.
+    static int evaluate(AttackInfo &info, HistoryPtr history, const NeuralAccumulator *accumulator = nullptr);
+    static int evaluate(AttackInfo &info, HistoryPtr history, MoveList &moves, const NeuralAccumulator *accumulator = nullptr);
 
+    // Hand-crafted evaluation of the position, without checking for a mate or a draw
+    static int evaluatePosition(AttackInfo &info);
+    
+    // Same as above, recording how much each weight contributes to the evaluation
+    static int evaluatePosition(AttackInfo &info, EvaluationTrace &trace);
+    
     static int evaluateAction(ChessBoard board);
     static int evaluateMobility(ChessBoard board);
 
-    static int getBonus(Piece piece, Color color, Square square);
+    static int getBonus(Piece piece, Color color, Square square, Stage stage = MIDDLEGAME);
+    
+    // Table of the pawn structures evaluated so far by the calling thread. Each search
+    // thread has its own table, cleared when the weights of the evaluation change.
+    static PawnHashTable &pawnTable();
+    
+    // Returns the evaluation of the pawn structure (passed, isolated, doubled and backward pawns)
+    static PawnEntry evaluatePawns(ChessBoard &board);
     
 private:
-    static int evaluateAction(MoveList moves);
-    static int evaluateMobility(MoveList moves);
+    static Weights weights;
+    static int weightsVersion;
+    
+    template <class Trace> static int computePosition(AttackInfo &info, Trace &trace);
+    
+    template <class Trace> static int evaluateAction(AttackInfo &info, Trace &trace);
+    template <class Trace> static int evaluateMobility(AttackInfo &info, Trace &trace);
+    
+    template <class Trace> static PawnEntry computePawnEntry(ChessBoard &board, Trace &trace);
+    
+    static PawnEntry tracePawns(ChessBoard &board, NullTrace &trace);
+    static PawnEntry tracePawns(ChessBoard &board, EvaluationTrace &trace);
+};
+
+// Coefficient of each weight in the evaluation of a position, from white's point of view: the evaluation
+// is the sum of each weight multiplied by its coefficient, the weights of each stage being interpolated
+// according to the phase. This is what the tuner needs to compute the gradient of the evaluation.
+struct EvaluationTrace {
+    int coefficients[ChessEvaluater::WeightCount] = { };
+    
+    int phase = 0;
+    
+    void add(const int &weight, int coefficient) {
+        coefficients[&weight - (const int *)&ChessEvaluater::getWeights()] += coefficient;
+    }
 };
@@ -10,11 +10,24 @@
 
 #include "MoveList.hpp"
 
+#include <vector>
+
 struct ChessEvaluation {
     MoveList line;
         
     int value = 0;
     
+    // A line with its own score, used when searching for
+    // more than one principal variation (MultiPV).
+    struct Variation {
+        MoveList line;
+        int value = 0;
+    };
+    
+    // The best lines ranked from the best to the worst one. The first
+    // variation is always the same as line and value above.
+    std::vector<Variation> variations;
+    
     int quiescenceDepth = 0;
     int depth = 0;
     
@@ -22,10 +35,21 @@ struct ChessEvaluation {
     int nodes = 0;
     int movesPerSecond = 0;
     
+    // Percentage of the pawn hash table lookups that were hits during the search
+    int pawnTableHitRate = 0;
+    
+    // Number of evaluations found (hits) or not (misses) in the evaluation cache during the last iteration
+    int evalCacheHits = 0;
+    int evalCacheMisses = 0;
+    
+    // Number of positions found in the endgame tablebases during the last iteration
+    int tablebaseHits = 0;
+    
     Color engineColor = WHITE;
     
     void clear() {
         line.count = 0;
+        variations.clear();
     }
     
 };
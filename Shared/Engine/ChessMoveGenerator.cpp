@@ -7,103 +7,76 @@
 //
 
 #include "ChessMoveGenerator.hpp"
-#include "magicmoves.h"
+#include "SlidingAttacks.hpp"
 
 #include <cassert>
 
-void ChessMoveGenerator::initialize() {
-    initmagicmoves();
-    initPawnMoves();
-    initKingMoves();
-    initKnightMoves();
-}
+// Ranges of the scores of the moves, the history of the quiet moves staying below the killer moves
+static const int GoodCaptureScore = 4 * MoveOrdering::MaxHistory;
+static const int KillerScore = 2 * MoveOrdering::MaxHistory;
+static const int BadCaptureScore = -GoodCaptureScore;
 
-void ChessMoveGenerator::initPawnMoves() {
-    // Note: generate moves even for the first and last rank, because it
-    // is used by the some functions to determine if a piece is attacked
-    // by a pawn which might need white pawn in the first rank or a black
-    // pawn in the last rank to determine proper attack.
-    for (Square square = 0; square < 64; square++) {
-        auto fileIndex = FileFrom(square);
-        auto rankIndex = RankFrom(square);
-        
-        assert(SquareFrom(fileIndex, rankIndex) == square);
-        
-        // White pawn attacks
-        bb_set(PawnAttacks[WHITE][square], fileIndex-1, rankIndex+1);
-        bb_set(PawnAttacks[WHITE][square], fileIndex+1, rankIndex+1);
-        
-        // Black pawn attacks
-        bb_set(PawnAttacks[BLACK][square], fileIndex-1, rankIndex-1);
-        bb_set(PawnAttacks[BLACK][square], fileIndex+1, rankIndex-1);
+void MoveOrdering::update(Move move, int ply, int depthLeft) {
+    auto compact = COMPACT_MOVE(move);
+    if (ply < MaxPly && killers[ply][0] != compact) {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = compact;
     }
-}
-
-void ChessMoveGenerator::initKingMoves() {
-    for (Square square = 0; square < 64; square++) {
-        auto fileIndex = FileFrom(square);
-        auto rankIndex = RankFrom(square);
-        
-        bb_set(KingMoves[square], fileIndex, rankIndex+1);
-        bb_set(KingMoves[square], fileIndex+1, rankIndex+1);
-        bb_set(KingMoves[square], fileIndex+1, rankIndex);
-        bb_set(KingMoves[square], fileIndex+1, rankIndex-1);
-        bb_set(KingMoves[square], fileIndex, rankIndex-1);
-        bb_set(KingMoves[square], fileIndex-1, rankIndex-1);
-        bb_set(KingMoves[square], fileIndex-1, rankIndex);
-        bb_set(KingMoves[square], fileIndex-1, rankIndex+1);
+    
+    auto &score = history[MOVE_COLOR(move)][MOVE_FROM(move)][MOVE_TO(move)];
+    score += depthLeft * depthLeft;
+    if (score >= MaxHistory) {
+        for (auto &scores : history) {
+            for (auto &fromScores : scores) {
+                for (auto &toScore : fromScores) {
+                    toScore /= 2;
+                }
+            }
+        }
     }
 }
 
-void ChessMoveGenerator::initKnightMoves() {
-    for (Square square = 0; square < 64; square++) {
-        auto fileIndex = FileFrom(square);
-        auto rankIndex = RankFrom(square);
-        
-        // Top
-        bb_set(KnightMoves[square], fileIndex-1, rankIndex+2);
-        bb_set(KnightMoves[square], fileIndex+1, rankIndex+2);
-        
-        // Bottom
-        bb_set(KnightMoves[square], fileIndex-1, rankIndex-2);
-        bb_set(KnightMoves[square], fileIndex+1, rankIndex-2);
-        
-        // Left
-        bb_set(KnightMoves[square], fileIndex-2, rankIndex+1);
-        bb_set(KnightMoves[square], fileIndex-2, rankIndex-1);
-        
-        // Right
-        bb_set(KnightMoves[square], fileIndex+2, rankIndex+1);
-        bb_set(KnightMoves[square], fileIndex+2, rankIndex-1);
-    }
+void MoveOrdering::clear() {
+    memset(killers, 0, sizeof(killers));
+    memset(history, 0, sizeof(history));
 }
 
-bool moveComparison(Move i, Move j) {
-    if (i == j) {
-        return false;
-    }
-    
-    if (MOVE_IS_CAPTURE(i) && !MOVE_IS_CAPTURE(j)) {
-        return true;
-    } else if (!MOVE_IS_CAPTURE(i) && MOVE_IS_CAPTURE(j)) {
-        return false;
-    } if (MOVE_IS_CAPTURE(i) && MOVE_IS_CAPTURE(j)) {
-        if (MOVE_CAPTURED_PIECE(i) > MOVE_CAPTURED_PIECE(j)) {
-            return true;
-        } else if (MOVE_CAPTURED_PIECE(i) == MOVE_CAPTURED_PIECE(j)) {
-            return MOVE_PIECE(i) > MOVE_PIECE(j);
+void ChessMoveGenerator::scoreMoves(ChessBoard &board, MoveList &moves, const MoveOrdering *ordering, int ply) {
+    auto killers = ordering && ply < MoveOrdering::MaxPly ? ordering->killers[ply] : nullptr;
+    for (int index=0; index<moves.count; index++) {
+        auto move = moves.moves[index];
+        auto piece = MOVE_PIECE(move);
+        auto promotion = MOVE_PROMOTION_PIECE(move);
+        auto compact = COMPACT_MOVE(move);
+        
+        int score;
+        if (MOVE_IS_CAPTURE(move)) {
+            // Capturing a piece at least as valuable as the capturing piece never loses material
+            auto captured = MOVE_CAPTURED_PIECE(move);
+            int mvvLva = 8 * (captured + promotion) + PCOUNT - piece;
+            if (captured >= piece || board.staticExchange(move) >= 0) {
+                score = GoodCaptureScore + mvvLva;
+            } else {
+                score = BadCaptureScore + mvvLva;
+            }
+        } else if (promotion > PAWN) {
+            score = GoodCaptureScore + 8 * promotion;
+        } else if (killers && (compact == killers[0] || compact == killers[1])) {
+            score = compact == killers[0] ? KillerScore + 1 : KillerScore;
+        } else if (ordering) {
+            score = ordering->history[MOVE_COLOR(move)][MOVE_FROM(move)][MOVE_TO(move)];
         } else {
-            return false;
+            score = 0;
         }
-    } else {
-        return false;
+        moves.scores[index] = score;
     }
 }
 
-void ChessMoveGenerator::sortMoves(MoveList & moves) {
-    // Sort the moves according to:
-    // MVV/LVA (Most Valuable Victim/Least Valuable Attacker).
-    std::stable_sort(std::begin(moves.moves), std::begin(moves.moves) + moves.count, moveComparison);
+void ChessMoveGenerator::sortMoves(ChessBoard &board, MoveList &moves) {
+    scoreMoves(board, moves);
+    for (int index=0; index<moves.count; index++) {
+        moves.selectBest(index);
+    }
 }
 
 #pragma mark -
@@ -113,68 +86,310 @@ MoveList ChessMoveGenerator::generateQuiescenceMoves(ChessBoard &board) {
 }
 
 MoveList ChessMoveGenerator::generateQuiescenceMoves(ChessBoard &board, Color color) {
-    return generateMoves(board, color, Mode::quiescenceMoveOnly);
+    AttackInfo info(board);
+    return generateCaptures(info, color);
+}
+
+MoveList ChessMoveGenerator::generateQuiescenceMoves(AttackInfo &info) {
+    return generateCaptures(info, info.board.color);
 }
 
 MoveList ChessMoveGenerator::generateMoves(ChessBoard &board) {
     return generateMoves(board, board.color);
 }
 
+MoveList ChessMoveGenerator::generateMoves(AttackInfo &info) {
+    return generateMoves(info, info.board.color);
+}
+
 #pragma mark -
 
+// Pawn direction and ranks, castling squares and rights for each color.
+// These tables are indexed by the color template parameter of the
+// generation functions below and so are resolved at compile time.
+static constexpr int PawnForward[COUNT] = { 8, -8 };
+static constexpr Rank PawnInitialRank[COUNT] = { 1, 6 };
+static constexpr Rank PawnLastRank[COUNT] = { 7, 0 };
+static constexpr Square KingInitialSquare[COUNT] = { e1, e8 };
+static constexpr CastlingRight KingSideCastling[COUNT] = { WHITE_KING_SIDE, BLACK_KING_SIDE };
+static constexpr CastlingRight QueenSideCastling[COUNT] = { WHITE_QUEEN_SIDE, BLACK_QUEEN_SIDE };
+
 MoveList ChessMoveGenerator::generateMoves(ChessBoard &board, Color color, Mode mode, Square specificSquare) {
+    AttackInfo info(board);
+    return generateMoves(info, color, mode, specificSquare);
+}
+
+MoveList ChessMoveGenerator::generateMoves(AttackInfo &info, Color color, Mode mode, Square specificSquare) {
     MoveList moveList;
     
-    generatePawnsMoves(board, color, moveList, mode, specificSquare);
-    if (mode == Mode::firstMoveOnly && moveList.count > 0) return moveList;
+    // Dispatch once to the generation specialized for the color and the mode
+    switch (mode) {
+        case Mode::allMoves:
+            if (color == WHITE) {
+                generateMoves<WHITE, Mode::allMoves>(info, moveList, specificSquare);
+            } else {
+                generateMoves<BLACK, Mode::allMoves>(info, moveList, specificSquare);
+            }
+            break;
+            
+        case Mode::quiescenceMoveOnly:
+            if (color == WHITE) {
+                generateMoves<WHITE, Mode::quiescenceMoveOnly>(info, moveList, specificSquare);
+            } else {
+                generateMoves<BLACK, Mode::quiescenceMoveOnly>(info, moveList, specificSquare);
+            }
+            break;
+            
+        case Mode::firstMoveOnly:
+            if (color == WHITE) {
+                generateMoves<WHITE, Mode::firstMoveOnly>(info, moveList, specificSquare);
+            } else {
+                generateMoves<BLACK, Mode::firstMoveOnly>(info, moveList, specificSquare);
+            }
+            break;
+            
+        case Mode::moveCaptureAndDefenseMoves:
+            if (color == WHITE) {
+                generateMoves<WHITE, Mode::moveCaptureAndDefenseMoves>(info, moveList, specificSquare);
+            } else {
+                generateMoves<BLACK, Mode::moveCaptureAndDefenseMoves>(info, moveList, specificSquare);
+            }
+            break;
+    }
+    
+    return moveList;
+}
+
+template<Color color, ChessMoveGenerator::Mode mode>
+void ChessMoveGenerator::generateMoves(AttackInfo &info, MoveList &moveList, Square specificSquare) {
+    generatePawnsMoves<color, mode>(info, moveList, specificSquare);
+    if (mode == Mode::firstMoveOnly && moveList.count > 0) return;
 
-    generateKingsMoves(board, color, moveList, mode, specificSquare);
-    if (mode == Mode::firstMoveOnly && moveList.count > 0) return moveList;
+    generateKingsMoves<color, mode>(info, moveList, specificSquare);
+    if (mode == Mode::firstMoveOnly && moveList.count > 0) return;
     
-    generateKnightsMoves(board, color, moveList, mode, specificSquare);
-    if (mode == Mode::firstMoveOnly && moveList.count > 0) return moveList;
+    generateKnightsMoves<color, mode>(info, moveList, specificSquare);
+    if (mode == Mode::firstMoveOnly && moveList.count > 0) return;
 
-    generateSlidingMoves(board, color, ROOK, moveList, mode, specificSquare);
-    if (mode == Mode::firstMoveOnly && moveList.count > 0) return moveList;
+    generateSlidingMoves<color, mode, ROOK>(info, moveList, specificSquare);
+    if (mode == Mode::firstMoveOnly && moveList.count > 0) return;
 
-    generateSlidingMoves(board, color, BISHOP, moveList, mode, specificSquare);
-    if (mode == Mode::firstMoveOnly && moveList.count > 0) return moveList;
+    generateSlidingMoves<color, mode, BISHOP>(info, moveList, specificSquare);
+    if (mode == Mode::firstMoveOnly && moveList.count > 0) return;
 
-    generateSlidingMoves(board, color, QUEEN, moveList, mode, specificSquare);
+    generateSlidingMoves<color, mode, QUEEN>(info, moveList, specificSquare);
+}
+
+MoveList ChessMoveGenerator::generateCaptures(AttackInfo &info, Color color) {
+    MoveList moveList;
+    if (color == WHITE) {
+        generateCaptures<WHITE>(info, moveList);
+    } else {
+        generateCaptures<BLACK>(info, moveList);
+    }
+    return moveList;
+}
+
+template<Color color>
+void ChessMoveGenerator::generateCaptures(AttackInfo &info, MoveList &moveList) {
+    auto &board = info.board;
+    const Color attackedColor = INVERSE(color);
+    auto occupancy = board.getOccupancy();
+    
+    // The most valuable victim first (the king cannot be captured)
+    for (unsigned index = 0; index < KING; index++) {
+        auto capturedPiece = Piece(QUEEN - index);
+        auto victims = board.pieces[attackedColor][capturedPiece];
+        while (victims > 0) {
+            Square to = lsb(victims);
+            bb_clear(victims, to);
+            
+            auto attackers = board.attackersTo(to, color, occupancy);
+            
+            // Then the least valuable attacker first
+            for (unsigned attackingPiece = PAWN; attackers > 0 && attackingPiece < PCOUNT; attackingPiece++) {
+                auto pieceAttackers = attackers & board.pieces[color][attackingPiece];
+                attackers &= ~pieceAttackers;
+                while (pieceAttackers > 0) {
+                    Square from = lsb(pieceAttackers);
+                    bb_clear(pieceAttackers, from);
+                    moveList.addMove(info, createCapture(from, to, color, Piece(attackingPiece), attackedColor, capturedPiece));
+                }
+            }
+        }
+    }
     
+    if (board.enPassantSquare > 0) {
+        auto to = board.enPassantSquare;
+        auto pawns = PawnAttacks[attackedColor][to] & board.pieces[color][PAWN];
+        while (pawns > 0) {
+            Square from = lsb(pawns);
+            bb_clear(pawns, from);
+            moveList.addMove(info, createEnPassant(from, to, color, PAWN));
+        }
+    }
+}
+
+MoveList ChessMoveGenerator::generateQuietChecks(AttackInfo &info, Color color) {
+    MoveList moveList;
+    if (color == WHITE) {
+        generateQuietChecks<WHITE>(info, moveList);
+    } else {
+        generateQuietChecks<BLACK>(info, moveList);
+    }
     return moveList;
 }
 
-void ChessMoveGenerator::generateAttackMoves(ChessBoard &board, Color color, MoveList &moveList, Square fromSquare, Piece attackingPiece, Bitboard attackingSquares, Mode mode) {
-    auto attackedColor = INVERSE(color);
-    for (unsigned capturedPiece = PAWN; capturedPiece < PCOUNT; capturedPiece++) {
-        auto attacks = attackingSquares & board.pieces[attackedColor][capturedPiece];
-        if (attacks > 0) {
-            moveList.addCaptures(board, fromSquare, attacks, color, attackingPiece, attackedColor, Piece(capturedPiece));
-            if (mode == Mode::firstMoveOnly && moveList.count > 0) return;
+// Squares from where a piece of the color attacks the king of the other color
+static Bitboard checkSquares(Color color, Piece piece, Square kingSquare, Bitboard occupancy) {
+    switch (piece) {
+        case PAWN:
+            return PawnAttacks[INVERSE(color)][kingSquare];
+        case KNIGHT:
+            return KnightMoves[kingSquare];
+        case BISHOP:
+            return BishopAttacks(kingSquare, occupancy);
+        case ROOK:
+            return RookAttacks(kingSquare, occupancy);
+        case QUEEN:
+            return BishopAttacks(kingSquare, occupancy) | RookAttacks(kingSquare, occupancy);
+        default:
+            return 0;
+    }
+}
+
+template<Color color>
+void ChessMoveGenerator::generateQuietChecks(AttackInfo &info, MoveList &moveList) {
+    auto &board = info.board;
+    auto &own = board.pieces[color];
+    auto kings = board.pieces[INVERSE(color)][KING];
+    if (kings == 0) {
+        return; // No king, can happen when testing
+    }
+    Square kingSquare = lsb(kings);
+    auto occupancy = board.getOccupancy();
+    
+    // The discovered checks: the sliding pieces that reach the king when only one piece of
+    // the color is in-between, which gives check by leaving the line (to any square).
+    // Staying on the line, that piece can still give a direct check, the king being seen
+    // without the piece itself (like a queen moving along the line towards the king).
+    Bitboard candidates = 0;
+    auto snipers = (RookAttacks(kingSquare, 0) & (own[ROOK] | own[QUEEN])) |
+                   (BishopAttacks(kingSquare, 0) & (own[BISHOP] | own[QUEEN]));
+    while (snipers > 0) {
+        Square square = lsb(snipers);
+        bb_clear(snipers, square);
+        
+        auto line = SquaresBetween[kingSquare][square];
+        auto blockers = line & occupancy;
+        if (bb_count(blockers) == 1 && (blockers & board.allPieces(color)) > 0) {
+            Square blocker = lsb(blockers);
+            auto piece = SQUARE_CONTENT_PIECE(board.mailbox[blocker]);
+            candidates |= blockers;
+            generateQuietMoves<color>(info, moveList, blocker, ~line | checkSquares(color, piece, kingSquare, occupancy ^ blockers));
         }
     }
     
-    if (mode == Mode::moveCaptureAndDefenseMoves) {
+    // The direct checks: the squares from where each type of piece attacks the king
+    for (unsigned piece = PAWN; piece < KING; piece++) {
+        auto pieces = own[piece] & ~candidates;
+        if (pieces == 0) {
+            continue;
+        }
+        auto targets = checkSquares(color, Piece(piece), kingSquare, occupancy);
+        while (pieces > 0) {
+            Square square = lsb(pieces);
+            bb_clear(pieces, square);
+            generateQuietMoves<color>(info, moveList, square, targets);
+        }
+    }
+}
+
+template<Color color>
+void ChessMoveGenerator::generateQuietMoves(AttackInfo &info, MoveList &moveList, Square from, Bitboard targets) {
+    auto &board = info.board;
+    auto piece = SQUARE_CONTENT_PIECE(board.mailbox[from]);
+    auto emptySquares = board.emptySquares();
+    
+    Bitboard moves = 0;
+    switch (piece) {
+        case PAWN: {
+            // The pushes, without the promotions which are not quiet moves
+            Square oneSquareForward = from + PawnForward[color];
+            if (RankFrom(oneSquareForward) != PawnLastRank[color] && bb_test(emptySquares, oneSquareForward)) {
+                bb_set(moves, oneSquareForward);
+                Square twoSquaresForward = from + 2 * PawnForward[color];
+                if (RankFrom(from) == PawnInitialRank[color] && bb_test(emptySquares, twoSquaresForward)) {
+                    bb_set(moves, twoSquaresForward);
+                }
+            }
+            break;
+        }
+        case KNIGHT:
+            moves = KnightMoves[from];
+            break;
+        case BISHOP:
+            moves = BishopAttacks(from, board.getOccupancy());
+            break;
+        case ROOK:
+            moves = RookAttacks(from, board.getOccupancy());
+            break;
+        case QUEEN:
+            moves = BishopAttacks(from, board.getOccupancy()) | RookAttacks(from, board.getOccupancy());
+            break;
+        case KING:
+            moves = KingMoves[from];
+            break;
+        default:
+            break;
+    }
+    
+    moves &= emptySquares & targets;
+    while (moves > 0) {
+        Square to = lsb(moves);
+        bb_clear(moves, to);
+        moveList.addSingleMove(info, createMove(from, to, color, piece));
+    }
+}
+
+template<Color color, ChessMoveGenerator::Mode mode>
+void ChessMoveGenerator::generateAttackMoves(AttackInfo &info, MoveList &moveList, Square fromSquare, Piece attackingPiece, Bitboard attackingSquares) {
+    auto &board = info.board;
+    const Color attackedColor = INVERSE(color);
+    
+    // Look for the piece being captured only if there is actually a piece to capture
+    if ((attackingSquares & board.allPieces(attackedColor)) > 0) {
+        for (unsigned capturedPiece = PAWN; capturedPiece < PCOUNT; capturedPiece++) {
+            auto attacks = attackingSquares & board.pieces[attackedColor][capturedPiece];
+            if (attacks > 0) {
+                moveList.addCaptures(info, fromSquare, attacks, color, attackingPiece, attackedColor, Piece(capturedPiece));
+                if (mode == Mode::firstMoveOnly && moveList.count > 0) return;
+            }
+        }
+    }
+    
+    if (mode == Mode::moveCaptureAndDefenseMoves && (attackingSquares & board.allPieces(color)) > 0) {
         for (unsigned ownPiece = PAWN; ownPiece < PCOUNT; ownPiece++) {
             auto defenses = attackingSquares & board.pieces[color][ownPiece];
             if (defenses > 0) {
-                moveList.addCaptures(board, fromSquare, defenses, color, attackingPiece, color, Piece(ownPiece));
+                moveList.addCaptures(info, fromSquare, defenses, color, attackingPiece, color, Piece(ownPiece));
             }
         }
     }
 }
 
-void ChessMoveGenerator::generatePawnsMoves(ChessBoard &board, Color color, MoveList &moveList, Mode mode, Square specificSquare) {
+template<Color color, ChessMoveGenerator::Mode mode>
+void ChessMoveGenerator::generatePawnsMoves(AttackInfo &info, MoveList &moveList, Square specificSquare) {
+    auto &board = info.board;
     auto pawns = board.pieces[color][PAWN];
     auto emptySquares = board.emptySquares();
     
-    // Generate moves for each white pawn
+    // Generate moves for each pawn
     while (pawns > 0) {
-        // Find the first white pawn starting from the least significant bit (that is, square a1)
+        // Find the first pawn starting from the least significant bit (that is, square a1)
         Square square = lsb(pawns);
         
-        // Clear that bit so next time we can find the next white pawn
+        // Clear that bit so next time we can find the next pawn
         bb_clear(pawns, square);
         
         // If the square index is specified, only generate move for that square
@@ -182,19 +397,17 @@ void ChessMoveGenerator::generatePawnsMoves(ChessBoard &board, Color color, Move
             continue;
         }
 
-        // Generate a bitboard for all the attacks that this white pawn
+        // Generate a bitboard for all the attacks that this pawn
         // can do. The attacks bitboard is masked with the occupancy bitboard
-        // because a pawn attack can only happen when there is a black piece
-        // in the target square.
-        generateAttackMoves(board, color, moveList, square, PAWN, PawnAttacks[color][square], mode);
+        // because a pawn attack can only happen when there is a piece of the
+        // opposite color in the target square.
+        generateAttackMoves<color, mode>(info, moveList, square, PAWN, PawnAttacks[color][square]);
         if (mode == Mode::firstMoveOnly && moveList.count > 0) return;
 
         // Also check if it's possible to do the en-passant
-        if (board.enPassant > 0) {
-            auto enPassantMove = PawnAttacks[color][square] & board.enPassant;
-            if (enPassantMove > 0) {
-                auto enPassantToSquare = lsb(enPassantMove);
-                moveList.addMove(board, createEnPassant(square, enPassantToSquare, color, PAWN));
+        if (board.enPassantSquare > 0) {
+            if (bb_test(PawnAttacks[color][square], board.enPassantSquare)) {
+                moveList.addMove(info, createEnPassant(square, board.enPassantSquare, color, PAWN));
                 if (mode == Mode::firstMoveOnly && moveList.count > 0) return;
             }
         }
@@ -205,32 +418,20 @@ void ChessMoveGenerator::generatePawnsMoves(ChessBoard &board, Color color, Move
         // Generate the move for the pawn:
         // - Either one square or
         // - Two squares if the pawn is in its initial rank
-        Square oneSquareForward, twoSquaresForward;
-        Rank initialRank;
         Rank currentRank = RankFrom(square);
-        if (color == WHITE) {
-            if (currentRank == 7) {
-                continue; // cannot move anymore, we are on the last rank
-            }
-            initialRank = 1;
-            oneSquareForward = square + 8;
-            twoSquaresForward = square + 16;
-        } else {
-            if (currentRank == 0) {
-                continue; // cannot move anymore, we are on the last rank
-            }
-            initialRank = 6;
-            oneSquareForward = square - 8;
-            twoSquaresForward = square - 16;
+        if (currentRank == PawnLastRank[color]) {
+            continue; // cannot move anymore, we are on the last rank
         }
+        Square oneSquareForward = square + PawnForward[color];
+        Square twoSquaresForward = square + 2 * PawnForward[color];
         
         // Can we move the pawn forward one square?
         if (((1UL << oneSquareForward) & emptySquares) > 0) {
-            moveList.addMove(board, createMove(square, oneSquareForward, color, PAWN));
+            moveList.addMove(info, createMove(square, oneSquareForward, color, PAWN));
 
             // Is pawn on the initial rank? Try two squares forward
-            if (currentRank == initialRank && ((1UL << twoSquaresForward) & emptySquares) > 0) {
-                moveList.addMove(board, createMove(square, twoSquaresForward, color, PAWN));
+            if (currentRank == PawnInitialRank[color] && ((1UL << twoSquaresForward) & emptySquares) > 0) {
+                moveList.addMove(info, createMove(square, twoSquaresForward, color, PAWN));
             }
         }
         
@@ -238,17 +439,19 @@ void ChessMoveGenerator::generatePawnsMoves(ChessBoard &board, Color color, Move
     }
 }
 
-void ChessMoveGenerator::generateKingsMoves(ChessBoard &board, Color color, MoveList &moveList, Mode mode, Square specificSquare) {
-    auto otherColor = INVERSE(color);
+template<Color color, ChessMoveGenerator::Mode mode>
+void ChessMoveGenerator::generateKingsMoves(AttackInfo &info, MoveList &moveList, Square specificSquare) {
+    auto &board = info.board;
+    const Color otherColor = INVERSE(color);
     auto kings = board.pieces[color][KING];
     auto emptySquares = board.emptySquares();
     
-    // Generate moves for each white knight
+    // Generate moves for each king
     while (kings > 0) {
-        // Find the first white knight starting from the least significant bit (that is, square a1)
+        // Find the first king starting from the least significant bit (that is, square a1)
         Square square = lsb(kings);
         
-        // Clear that bit so next time we can find the next white knight
+        // Clear that bit so next time we can find the next king
         bb_clear(kings, square);
 
         // If the square index is specified, only generate move for that square
@@ -256,48 +459,32 @@ void ChessMoveGenerator::generateKingsMoves(ChessBoard &board, Color color, Move
             continue;
         }
         
-        // Generate a bitboard for all the moves that this white knight
-        // can do. The attacks bitboard is masked to ensure it can only
-        // happy on an empty square or a square with a piece of the opposite color.
-        generateAttackMoves(board, color, moveList, square, KING, KingMoves[square], mode);
+        // Generate a bitboard for all the moves that this king can do.
+        // The attacks bitboard is masked to ensure it can only
+        // move on an empty square or a square with a piece of the opposite color.
+        generateAttackMoves<color, mode>(info, moveList, square, KING, KingMoves[square]);
         if (mode == Mode::firstMoveOnly && moveList.count > 0) return;
 
         if (mode == Mode::quiescenceMoveOnly) continue;
 
         auto moves = KingMoves[square] & emptySquares;
-        moveList.addMoves(board, square, moves, KING);
+        moveList.addMoves(info, square, moves, KING);
         if (mode == Mode::firstMoveOnly && moveList.count > 0) return;
 
         // Generate all legal casting moves. Note that we only generate the move for the king,
         // the board is going to move the rook in move() when it detects a castling move.
-        if (color == WHITE && square == e1 && !board.isCheck(color)) {
-            if (board.whiteCanCastleKingSide) {
-                Bitboard kingMoves = 1 << (square+1) | 1 << (square+2);
-                if ((kingMoves & emptySquares) == kingMoves && !board.isAttacked(square+1, otherColor) && !board.isAttacked(square+2, otherColor)) {
-                    moveList.addMove(board, createCastling(square, square+2, color, KING));
-                    if (mode == Mode::firstMoveOnly && moveList.count > 0) return;
-                }
-            }
-            if (board.whiteCanCastleQueenSide) {
-                Bitboard kingMoves = 1 << (square-1) | 1 << (square-2) | 1 << (square-3);
-                if ((kingMoves & emptySquares) == kingMoves && !board.isAttacked(square-1, otherColor) && !board.isAttacked(square-2, otherColor)) {
-                    moveList.addMove(board, createCastling(square, square-2, color, KING));
-                    if (mode == Mode::firstMoveOnly && moveList.count > 0) return;
-                }
-            }
-        }
-        if (color == BLACK && square == e8 && !board.isCheck(color)) {
-            if (board.blackCanCastleKingSide) {
+        if (square == KingInitialSquare[color] && !info.isCheck(color)) {
+            if (board.canCastle(KingSideCastling[color])) {
                 Bitboard kingMoves = 1UL << (square+1) | 1UL << (square+2);
-                if ((kingMoves & emptySquares) == kingMoves && !board.isAttacked(square+1, otherColor) && !board.isAttacked(square+2, otherColor)) {
-                    moveList.addMove(board, createCastling(square, square+2, color, KING));
+                if ((kingMoves & emptySquares) == kingMoves && !info.isAttacked(square+1, otherColor) && !info.isAttacked(square+2, otherColor)) {
+                    moveList.addMove(info, createCastling(square, square+2, color, KING));
                     if (mode == Mode::firstMoveOnly && moveList.count > 0) return;
                 }
             }
-            if (board.blackCanCastleQueenSide) {
+            if (board.canCastle(QueenSideCastling[color])) {
                 Bitboard kingMoves = 1UL << (square-1) | 1UL << (square-2) | 1UL << (square-3);
-                if ((kingMoves & emptySquares) == kingMoves && !board.isAttacked(square-1, otherColor) && !board.isAttacked(square-2, otherColor)) {
-                    moveList.addMove(board, createCastling(square, square-2, color, KING));
+                if ((kingMoves & emptySquares) == kingMoves && !info.isAttacked(square-1, otherColor) && !info.isAttacked(square-2, otherColor)) {
+                    moveList.addMove(info, createCastling(square, square-2, color, KING));
                     if (mode == Mode::firstMoveOnly && moveList.count > 0) return;
                 }
             }
@@ -305,38 +492,44 @@ void ChessMoveGenerator::generateKingsMoves(ChessBoard &board, Color color, Move
     }
 }
 
-void ChessMoveGenerator::generateKnightsMoves(ChessBoard &board, Color color, MoveList &moveList, Mode mode, Square specificSquare) {
-    auto whiteKnights = board.pieces[color][KNIGHT];
+template<Color color, ChessMoveGenerator::Mode mode>
+void ChessMoveGenerator::generateKnightsMoves(AttackInfo &info, MoveList &moveList, Square specificSquare) {
+    auto &board = info.board;
+    auto knights = board.pieces[color][KNIGHT];
     auto emptySquares = board.emptySquares();
 
-    // Generate moves for each white knight
-    while (whiteKnights > 0) {
-        // Find the first white knight starting from the least significant bit (that is, square a1)
-        Square square = lsb(whiteKnights);
+    // Generate moves for each knight
+    while (knights > 0) {
+        // Find the first knight starting from the least significant bit (that is, square a1)
+        Square square = lsb(knights);
         
-        // Clear that bit so next time we can find the next white knight
-        bb_clear(whiteKnights, square);
+        // Clear that bit so next time we can find the next knight
+        bb_clear(knights, square);
 
         // If the square index is specified, only generate move for that square
         if (specificSquare != SquareUndefined && square != specificSquare) {
             continue;
         }
         
-        // Generate a bitboard for all the moves that this white knight
+        // Generate a bitboard for all the moves that this knight
         // can do. The attacks bitboard is masked to ensure it can only
         // move on an empty square or a square with a piece of the opposite color.
-        generateAttackMoves(board, color, moveList, square, KNIGHT, KnightMoves[square], mode);
+        generateAttackMoves<color, mode>(info, moveList, square, KNIGHT, KnightMoves[square]);
         if (mode == Mode::firstMoveOnly && moveList.count > 0) return;
 
         if (mode == Mode::quiescenceMoveOnly) continue;
 
         auto moves = KnightMoves[square] & emptySquares;
-        moveList.addMoves(board, square, moves, KNIGHT);
+        moveList.addMoves(info, square, moves, KNIGHT);
         if (mode == Mode::firstMoveOnly && moveList.count > 0) return;
     }
 }
 
-void ChessMoveGenerator::generateSlidingMoves(ChessBoard &board, Color color, Piece piece, MoveList &moveList, Mode mode, Square specificSquare) {
+template<Color color, ChessMoveGenerator::Mode mode, Piece piece>
+void ChessMoveGenerator::generateSlidingMoves(AttackInfo &info, MoveList &moveList, Square specificSquare) {
+    auto &board = info.board;
+    static_assert(piece == ROOK || piece == BISHOP || piece == QUEEN, "Not a sliding piece");
+    
     auto slidingPieces = board.pieces[color][piece];
     auto occupancy = board.getOccupancy();
     auto emptySquares = board.emptySquares();
@@ -355,35 +548,24 @@ void ChessMoveGenerator::generateSlidingMoves(ChessBoard &board, Color color, Pi
         }
 
         // Generate a bitboard for all the moves that this sliding piece can do.
-        Bitboard potentialMoves;
-        switch (piece) {
-            case ROOK:
-                potentialMoves = Rmagic(square, occupancy);
-                break;
-                
-            case BISHOP:
-                potentialMoves = Bmagic(square, occupancy);
-                break;
-                
-            case QUEEN:
-                potentialMoves = Rmagic(square, occupancy) | Bmagic(square, occupancy);
-                break;
-                
-            default:
-                assert(false); // not a sliding piece
-                break;
+        Bitboard potentialMoves = 0;
+        if (piece == ROOK || piece == QUEEN) {
+            potentialMoves |= RookAttacks(square, occupancy);
+        }
+        if (piece == BISHOP || piece == QUEEN) {
+            potentialMoves |= BishopAttacks(square, occupancy);
         }
         
         // Note: the occupancy bitboard has all the white and black pieces,
         // we need to filter out the moves that land into a piece of the same
-        // color because Rmagic will move to these squares anyway.
-        generateAttackMoves(board, color, moveList, square, piece, potentialMoves, mode);
+        // color because the attacks include these squares anyway.
+        generateAttackMoves<color, mode>(info, moveList, square, piece, potentialMoves);
         if (mode == Mode::firstMoveOnly && moveList.count > 0) return;
 
         if (mode == Mode::quiescenceMoveOnly) continue;
         
         auto moves = potentialMoves & emptySquares;
-        moveList.addMoves(board, square, moves, piece);
+        moveList.addMoves(info, square, moves, piece);
         if (mode == Mode::firstMoveOnly && moveList.count > 0) return;
     }
 }
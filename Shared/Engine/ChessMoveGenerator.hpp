@@ -10,21 +10,39 @@
 
 #include "MoveList.hpp"
 #include "ChessBoard.hpp"
+#include "AttackInfo.hpp"
 #include "Coordinate.hpp"
 
-// Without this, the C file won't be linked
-extern "C" void initmagicmoves(void);
+// Heuristics learned by a search to order the quiet moves: the killer moves, two quiet moves for each
+// ply that caused a beta cut-off, and the history of the quiet moves causing cut-offs at any ply.
+// https://www.chessprogramming.org/Killer_Heuristic
+// https://www.chessprogramming.org/History_Heuristic
+struct MoveOrdering {
+    static const int MaxPly = 64;
+    
+    // The history scores are halved when one of them reaches that limit
+    static const int MaxHistory = 1 << 20;
+    
+    CompactMove killers[MaxPly][2] = { };
+    int history[COUNT][64][64] = { };
+    
+    // Records the quiet move causing a cut-off at the ply, with the specified number of plies left to search
+    void update(Move move, int ply, int depthLeft);
+    
+    // Called before each search, which then doesn't depend on the searches done before
+    void clear();
+};
 
 class ChessMoveGenerator {
-private:
-    static void initPawnMoves();
-    static void initKingMoves();
-    static void initKnightMoves();
-
 public:
-    static void initialize();
-
-    static void sortMoves(MoveList & moves);
+    // Fills the score of each move to order them (see MoveList::selectBest()): the promotions and the captures
+    // that don't lose material (see ChessBoard::staticExchange()) first, by MVV/LVA (Most Valuable Victim/Least
+    // Valuable Attacker), then the killer moves of the ply, the quiet moves by their history and the captures
+    // losing material last.
+    static void scoreMoves(ChessBoard &board, MoveList &moves, const MoveOrdering *ordering = nullptr, int ply = 0);
+    
+    // Scores the moves and sorts all of them by their score
+    static void sortMoves(ChessBoard &board, MoveList &moves);
 
     static bool isValid(Move move) {
         return MOVE_ISVALID(move);
@@ -37,17 +55,58 @@ public:
         moveCaptureAndDefenseMoves
     };
     
+    // The quiescence moves are the captures, generated by generateCaptures()
     static MoveList generateQuiescenceMoves(ChessBoard &board);
     static MoveList generateQuiescenceMoves(ChessBoard &board, Color color);
 
     static MoveList generateMoves(ChessBoard &board);
     static MoveList generateMoves(ChessBoard &board, Color color, Mode mode = Mode::allMoves, Square specificSquare = SquareUndefined);
     
-    static void generateAttackMoves(ChessBoard &board, Color color, MoveList &moveList, Square fromSquare, Piece attackingPiece, Bitboard attackingSquares, Mode mode);
+    // Same as above but sharing the attack info of the node, which can be
+    // reused by the evaluation and the search of that node.
+    static MoveList generateQuiescenceMoves(AttackInfo &info);
+    static MoveList generateMoves(AttackInfo &info);
+    static MoveList generateMoves(AttackInfo &info, Color color, Mode mode = Mode::allMoves, Square specificSquare = SquareUndefined);
+    
+    // Generates the captures already in MVV/LVA order, without having to score and sort them: the victims
+    // from the queen down to the pawn and, for each victim, its attackers from the pawn up to the king
+    // (see ChessBoard::attackersTo()). The en-passant captures come last.
+    static MoveList generateCaptures(AttackInfo &info, Color color);
+    
+    // Generates the quiet moves (neither captures nor promotions) giving check to the king of the other color,
+    // used by the first ply of the quiescence search: the direct checks, moving a piece to one of the squares
+    // from where it attacks the king, and the discovered checks, moving a piece off the line between the king
+    // and one of the sliding pieces of the color. The castling moves are not generated.
+    static MoveList generateQuietChecks(AttackInfo &info, Color color);
+    
+private:
+    // The generation is specialized for each color and mode so
+    // the tests on the color and the mode are resolved at compile time.
+    template<Color color, Mode mode>
+    static void generateMoves(AttackInfo &info, MoveList &moveList, Square specificSquare);
+    
+    template<Color color>
+    static void generateCaptures(AttackInfo &info, MoveList &moveList);
+    
+    template<Color color>
+    static void generateQuietChecks(AttackInfo &info, MoveList &moveList);
+    
+    template<Color color>
+    static void generateQuietMoves(AttackInfo &info, MoveList &moveList, Square from, Bitboard targets);
+    
+    template<Color color, Mode mode>
+    static void generateAttackMoves(AttackInfo &info, MoveList &moveList, Square fromSquare, Piece attackingPiece, Bitboard attackingSquares);
+    
+    template<Color color, Mode mode>
+    static void generatePawnsMoves(AttackInfo &info, MoveList &moveList, Square specificSquare);
+    
+    template<Color color, Mode mode>
+    static void generateKingsMoves(AttackInfo &info, MoveList &moveList, Square specificSquare);
+    
+    template<Color color, Mode mode>
+    static void generateKnightsMoves(AttackInfo &info, MoveList &moveList, Square specificSquare);
     
-    static void generatePawnsMoves(ChessBoard &board, Color color, MoveList &moveList, Mode mode, Square specificSquare = SquareUndefined);
-    static void generateKingsMoves(ChessBoard &board, Color color, MoveList &moveList, Mode mode, Square specificSquare = SquareUndefined);
-    static void generateKnightsMoves(ChessBoard &board, Color color, MoveList &moveList, Mode mode, Square specificSquare = SquareUndefined);
-    static void generateSlidingMoves(ChessBoard &board, Color color, Piece piece, MoveList &moveList, Mode mode, Square specificSquare = SquareUndefined);
+    template<Color color, Mode mode, Piece piece>
+    static void generateSlidingMoves(AttackInfo &info, MoveList &moveList, Square specificSquare);
 };
 
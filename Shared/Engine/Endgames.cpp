@@ -0,0 +1,240 @@
+//
+//  Endgames.cpp
+//  BChess
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#include "Endgames.hpp"
+#include "ChessEvaluater.hpp"
+
+#include <cassert>
+#include <cstdlib>
+
+namespace {
+
+static constexpr Bitboard DarkSquares = 0xAA55AA55AA55AA55UL;
+
+static const MaterialKey PawnsMask = MATERIAL_KEY(WHITE, PAWN, 0xF) | MATERIAL_KEY(BLACK, PAWN, 0xF);
+
+// Same material with the colors swapped
+static MaterialKey swapColors(MaterialKey key) {
+    auto whiteKey = key & (MATERIAL_KEY(BLACK, PAWN) - 1);
+    return (whiteKey << (4 * PCOUNT)) | (key >> (4 * PCOUNT));
+}
+
+// Number of king moves between the two squares
+static int distance(Square from, Square to) {
+    return std::max(std::abs(FileFrom(from) - FileFrom(to)), std::abs(RankFrom(from) - RankFrom(to)));
+}
+
+static int manhattanDistance(Square from, Square to) {
+    return std::abs(FileFrom(from) - FileFrom(to)) + std::abs(RankFrom(from) - RankFrom(to));
+}
+
+// From 0 in the center to 6 in the corners
+static int centerDistance(Square square) {
+    int file = FileFrom(square);
+    int rank = RankFrom(square);
+    return std::max(3 - file, file - 4) + std::max(3 - rank, rank - 4);
+}
+
+// Value of the pieces of the color, the king excluded
+static int material(const ChessBoard &board, Color color) {
+    auto &values = ChessEvaluater::getWeights().pieceValue[ChessEvaluater::ENDGAME];
+    auto key = board.getMaterialKey();
+    int value = 0;
+    for (unsigned piece=PAWN; piece<KING; piece++) {
+        value += values[piece] * MATERIAL_COUNT(key, color, Piece(piece));
+    }
+    return value;
+}
+
+static int colorSign(Color color) {
+    return color == WHITE ? 1 : -1;
+}
+
+// Mate with a queen or a rook against the lone king: the king is pushed
+// to the edge of the board, with the king of the stronger side next to it.
+static int evaluateLoneKing(const ChessBoard &board, Color strong) {
+    auto strongKing = lsb(board.pieces[strong][KING]);
+    auto weakKing = lsb(board.pieces[INVERSE(strong)][KING]);
+    int value = ChessEvaluater::KNOWN_WIN_VALUE + material(board, strong);
+    value += 20 * centerDistance(weakKing) + 10 * (7 - distance(strongKing, weakKing));
+    return colorSign(strong) * value;
+}
+
+// KBNK: the mate is only possible in a corner of the color of the bishop,
+// where the lone king must be driven.
+static int evaluateKBNK(const ChessBoard &board, Color strong) {
+    auto strongKing = lsb(board.pieces[strong][KING]);
+    auto weakKing = lsb(board.pieces[INVERSE(strong)][KING]);
+    bool darkBishop = (board.pieces[strong][BISHOP] & DarkSquares) != 0;
+    int cornerDistance = darkBishop
+        ? std::min(manhattanDistance(weakKing, a1), manhattanDistance(weakKing, h8))
+        : std::min(manhattanDistance(weakKing, h1), manhattanDistance(weakKing, a8));
+
+    int value = ChessEvaluater::KNOWN_WIN_VALUE + material(board, strong);
+    value += 20 * (14 - cornerDistance) + 10 * (7 - distance(strongKing, weakKing));
+    return colorSign(strong) * value;
+}
+
+// KRKP: a race between the pawn and the king of the rook. The rook wins when its king reaches the
+// promotion square in time (the rule of the square) or when the pawn is left without the support of
+// its king. Otherwise the pawn usually costs the rook and the position is close to a draw.
+static int evaluateKRKP(const ChessBoard &board, Color strong) {
+    auto weak = INVERSE(strong);
+
+    // The stronger side is white, otherwise the board is flipped vertically: the pawn moves down
+    int flip = strong == WHITE ? 0 : 56;
+    Square strongKing = lsb(board.pieces[strong][KING]) ^ flip;
+    Square weakKing = lsb(board.pieces[weak][KING]) ^ flip;
+    Square pawn = lsb(board.pieces[weak][PAWN]) ^ flip;
+    Square promotion = SquareFrom(FileFrom(pawn), 0);
+    int rookValue = ChessEvaluater::getWeights().pieceValue[ChessEvaluater::ENDGAME][ROOK];
+
+    // Moves left to the pawn (its first one being a double step) and to the king to reach the
+    // promotion square, the side to move being one move ahead
+    int pawnMoves = RankFrom(pawn) == 6 ? 5 : int(RankFrom(pawn));
+    int kingMoves = distance(strongKing, promotion) - (board.color == strong ? 1 : 0);
+
+    // The pawn is supported when its king is next to it, or can be with its next move
+    bool supported = distance(weakKing, pawn) - (board.color == weak ? 1 : 0) <= 1;
+
+    if (kingMoves < pawnMoves || !supported) {
+        // The rook wins the pawn, the sooner with its king close to it
+        return colorSign(strong) * (rookValue - 2 * distance(strongKing, pawn));
+    }
+
+    // The further the pawn from its promotion and the closer the king of the rook to it, the better
+    int value = 20 + 15 * pawnMoves + 5 * (distance(weakKing, promotion) - distance(strongKing, promotion));
+    return colorSign(strong) * std::max(0, value);
+}
+
+// Opposite-colored bishops, with pawns: the bishop of the weaker side often blockades the pawns,
+// a pawn or two more being rarely enough to win.
+static int scaleOppositeBishops(const ChessBoard &board, Color) {
+    auto bishops = board.pieces[WHITE][BISHOP] | board.pieces[BLACK][BISHOP];
+    if (bb_count(bishops & DarkSquares) != 1) {
+        return Endgames::NormalScale;
+    }
+
+    auto key = board.getMaterialKey();
+    int difference = std::abs((int)MATERIAL_COUNT(key, WHITE, PAWN) - (int)MATERIAL_COUNT(key, BLACK, PAWN));
+    return std::min(Endgames::NormalScale, 16 * std::max(1, difference));
+}
+
+// Open addressing table of the endgames, indexed by their material key
+struct EndgameTable {
+    // Much larger than the number of endgames, to find them in one or two probes
+    static const int Size = 64;
+
+    Endgames::Endgame entries[Size];
+
+    static int slot(MaterialKey key) {
+        return (key * 0x9E3779B97F4A7C15UL) >> 58;
+    }
+
+    // Adds the endgame for both colors
+    void add(std::string signature, bool draw, Endgames::Function evaluation, Endgames::Function scale) {
+        Endgames::Endgame endgame;
+        endgame.key = Endgames::materialKey(signature);
+        endgame.draw = draw;
+        endgame.evaluation = evaluation;
+        endgame.scale = scale;
+        assert(endgame.key);
+        insert(endgame);
+
+        if (swapColors(endgame.key) != endgame.key) {
+            endgame.key = swapColors(endgame.key);
+            endgame.strong = BLACK;
+            insert(endgame);
+        }
+    }
+
+    void insert(Endgames::Endgame endgame) {
+        assert(!find(endgame.key));
+        int index = slot(endgame.key);
+        while (entries[index].key) {
+            index = (index + 1) % Size;
+        }
+        entries[index] = endgame;
+    }
+
+    const Endgames::Endgame *find(MaterialKey key) const {
+        for (int index = slot(key); entries[index].key; index = (index + 1) % Size) {
+            if (entries[index].key == key) {
+                return &entries[index];
+            }
+        }
+        return nullptr;
+    }
+};
+
+struct EndgameTables {
+    // Endgames of the exact material
+    EndgameTable evaluations;
+
+    // Endgames of the material without the pawns
+    EndgameTable scales;
+
+    // Queen or rook against the lone king, whatever the other pieces, for each stronger side
+    Endgames::Endgame loneKing[COUNT];
+
+    EndgameTables() {
+        // Neither side can force a mate
+        for (auto signature : { "KK", "KNK", "KBK", "KNNK", "KNKN", "KBKN", "KBKB" }) {
+            evaluations.add(signature, true, nullptr, nullptr);
+        }
+        evaluations.add("KBNK", false, evaluateKBNK, nullptr);
+        evaluations.add("KRKP", false, evaluateKRKP, nullptr);
+
+        scales.add("KBKB", false, nullptr, scaleOppositeBishops);
+
+        for (unsigned color=0; color<COUNT; color++) {
+            loneKing[color].strong = Color(color);
+            loneKing[color].evaluation = evaluateLoneKing;
+        }
+    }
+};
+
+static const EndgameTables Tables;
+
+}
+
+const Endgames::Endgame *Endgames::probe(MaterialKey key) {
+    if (auto endgame = Tables.evaluations.find(key)) {
+        return endgame;
+    }
+
+    for (unsigned color=0; color<COUNT; color++) {
+        auto strong = Color(color);
+        auto weak = INVERSE(strong);
+        auto weakKey = weak == WHITE ? key & (MATERIAL_KEY(BLACK, PAWN) - 1) : key >> (4 * PCOUNT);
+        if (weakKey == MATERIAL_KEY(WHITE, KING) &&
+            (MATERIAL_COUNT(key, strong, QUEEN) || MATERIAL_COUNT(key, strong, ROOK))) {
+            return &Tables.loneKing[strong];
+        }
+    }
+
+    return Tables.scales.find(key & ~PawnsMask);
+}
+
+MaterialKey Endgames::materialKey(std::string signature) {
+    static const std::string Pieces = "PNBRQK";
+
+    // The pieces of white, starting with its king, then the ones of black
+    MaterialKey key = 0;
+    int kings = 0;
+    for (auto c : signature) {
+        auto piece = Pieces.find(c);
+        if (piece == std::string::npos || (kings == 0 && piece != KING)) {
+            return 0;
+        }
+        if (piece == KING) {
+            kings++;
+        }
+        key += MATERIAL_KEY(kings == 1 ? WHITE : BLACK, Piece(piece));
+    }
+    return kings == 2 ? key : 0;
+}
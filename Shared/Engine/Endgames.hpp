@@ -0,0 +1,53 @@
+//
+//  Endgames.hpp
+//  BChess
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#pragma once
+
+#include "ChessBoard.hpp"
+
+#include <string>
+
+// Specialized knowledge of the endgames where the generic evaluation cannot find how to make progress,
+// like the mate with a bishop and a knight (KBNK), or misjudges the outcome, like the endgames with
+// opposite-colored bishops which are often drawn despite a pawn more. The endgame of a position is
+// found in constant time from the material key of the board (see ChessBoard::getMaterialKey()).
+// https://www.chessprogramming.org/Endgame_Evaluation
+class Endgames {
+public:
+    // Scale of the generic evaluation, in 64ths: NormalScale leaves it unchanged
+    static const int NormalScale = 64;
+
+    // Evaluation from white's point of view, replacing the generic one (or the scale
+    // applied to the generic one), the stronger side being the one with more material.
+    typedef int (*Function)(const ChessBoard &board, Color strong);
+
+    struct Endgame {
+        MaterialKey key = 0;
+
+        Color strong = WHITE;
+
+        // A known draw, which the search doesn't need to explore any further
+        bool draw = false;
+
+        Function evaluation = nullptr;
+        Function scale = nullptr;
+    };
+
+    // Returns the endgame of the material, or null if the generic evaluation applies. The scaled
+    // endgames, like the opposite-colored bishops, are found whatever the number of pawns.
+    static const Endgame *probe(MaterialKey key);
+
+    // Returns true if the position is one of the known draws, like KNK or KNNK
+    static bool isDraw(const ChessBoard &board) {
+        auto endgame = probe(board.getMaterialKey());
+        return endgame && endgame->draw;
+    }
+
+    // Returns the material key of a signature like KBNK or KRKP, the pieces of white first.
+    // Returns 0 if the signature is invalid.
+    static MaterialKey materialKey(std::string signature);
+};
@@ -11,6 +11,7 @@
 #include "Types.hpp"
 
 #include "FPGN.hpp"
+#include "FFEN.hpp"
 
 #include "MinMaxSearch.hpp"
 #include "IterativeDeepening.hpp"
@@ -20,8 +21,11 @@
 #include "ChessBoard.hpp"
 #include "ChessBoardHash.hpp"
 #include "ChessMoveGenerator.hpp"
+#include "SlidingAttacks.hpp"
 #include "ChessEvaluater.hpp"
 #include "ChessEvaluation.hpp"
+#include "TexelTuner.hpp"
+#include "Tablebases.hpp"
 
 typedef MinMaxSearch ChessMinMaxSearch;
 
@@ -40,6 +44,20 @@ public:
     
     bool transpositionTable = true;
     
+    bool probCut = false;
+    
+    // Number of best lines returned by the search (MultiPV)
+    int multiPV = 1;
+    
+    // Number of threads used to search the root moves
+    int threads = 1;
+    
+    // True to probe the endgame tablebases loaded by loadTablebases() during the search
+    bool tablebases = false;
+    
+    // Minimum number of plies left to probe the endgame tablebases during the search
+    int tablebaseProbeDepth = 1;
+    
     typedef std::function<void(ChessEvaluation, bool)> SearchCallback;
     
 public:
@@ -48,9 +66,25 @@ public:
         games.push_back(ChessGame());
     }
     
+    // Note: the attack tables and the Zobrist keys are either generated at compile time
+    // or when the program starts, calling this method is not required anymore.
     static void initialize() {
-        ChessMoveGenerator::initialize();
-        ChessBoardHash::initialize();
+        SlidingAttacks::initialize();
+    }
+    
+    // Prepares the engine for a new game by removing the
+    // analysis of the previous game from the transposition table.
+    // Returns the time in milliseconds it took to clear the table.
+    double newGame() {
+        cancel();
+        return iterativeSearch.clear();
+    }
+    
+    // Changes the size of the transposition table, in megabytes.
+    // Returns the time in milliseconds it took to resize the table.
+    double setHashSize(size_t megabytes) {
+        cancel();
+        return iterativeSearch.resizeTable(megabytes);
     }
     
     bool loadOpening(std::string pgn) {
@@ -124,6 +158,22 @@ public:
         return iterativeSearch.running();
     }
     
+    // When pondering, the search is done on the opponent's time: the current position
+    // already contains the opponent's expected move and the search won't complete
+    // until ponderhit() or stop() is called.
+    void setPondering(bool pondering) {
+        iterativeSearch.pondering = pondering;
+    }
+    
+    // The opponent played the expected move, the search becomes a regular search.
+    void ponderhit() {
+        iterativeSearch.ponderhit();
+    }
+    
+    bool pondering() {
+        return iterativeSearch.pondering;
+    }
+    
     bool isWhite() {
         return game().board.color == WHITE;
     }
@@ -162,6 +212,11 @@ public:
 
     void searchBestMove(int maxDepth, SearchCallback callback) {
         iterativeSearch.minMaxSearch.config.transpositionTable = transpositionTable;
+        iterativeSearch.minMaxSearch.config.probCut = probCut;
+        iterativeSearch.minMaxSearch.config.tablebases = tablebases;
+        iterativeSearch.minMaxSearch.config.tablebaseProbeDepth = tablebaseProbeDepth;
+        iterativeSearch.multiPV = multiPV;
+        iterativeSearch.threads = threads;
         ChessEvaluation info = iterativeSearch.search(game().board, game().history, maxDepth, [&](ChessEvaluation info) {
             if (!iterativeSearch.cancelled()) {
                 callback(info, false);
@@ -175,4 +230,155 @@ public:
     std::string getState() {
         return game().getState();
     }
+    
+    // Loads the weights of the neural network, which is used for the evaluation
+    // when ChessEvaluater::neuralEvaluation is true.
+    bool loadNeuralNetwork(std::string path) {
+        cancel();
+        return ChessEvaluater::network.load(path);
+    }
+    
+    // Loads the Syzygy endgame tablebases of the directories of the path, separated by ':'.
+    // Returns the number of WDL tables found.
+    int loadTablebases(std::string path) {
+        cancel();
+        return Tablebases::load(path);
+    }
+    
+    // Loads the bitbases of a file created by generateBitbases()
+    bool loadBitbases(std::string path) {
+        cancel();
+        return ChessEvaluater::bitbases.load(path);
+    }
+    
+    // Generates the bitbases of the signatures, like KPK or KBNK, and saves them with the bitbases
+    // already available to a file. The callback receives the progress of the generation.
+    bool generateBitbases(std::vector<std::string> signatures, std::string path, std::function<void(std::string)> callback) {
+        cancel();
+        auto &bitbases = ChessEvaluater::bitbases;
+        bool success = bitbases.generate(signatures, [&](std::string signature, size_t positions, size_t wins, double milliseconds) {
+            callback(signature + " " + std::to_string(wins) + " wins out of " + std::to_string(positions) + " positions in " + std::to_string(int(milliseconds)) + " ms");
+        });
+        return success && bitbases.save(path);
+    }
+    
+    // Loads the weights of the hand-crafted evaluation from a file created by tuneEvaluation()
+    bool loadEvaluationWeights(std::string path) {
+        cancel();
+        auto weights = ChessEvaluater::getWeights();
+        if (!weights.load(path)) {
+            return false;
+        }
+        ChessEvaluater::setWeights(weights);
+        return true;
+    }
+    
+    // Tunes the weights of the hand-crafted evaluation with the labelled positions of a file (see TexelTuner)
+    // and saves them to another file. The callback receives the progress of the tuning.
+    bool tuneEvaluation(std::string positionsPath, std::string weightsPath, int epochs, std::function<void(std::string)> callback) {
+        cancel();
+        TexelTuner tuner;
+        
+        TimeManagement clock;
+        clock.start();
+        auto count = tuner.load(positionsPath);
+        clock.stop();
+        callback("loaded " + std::to_string(count) + " positions in " + std::to_string(int(clock.elapsedMilli())) + " ms");
+        if (count == 0) {
+            return false;
+        }
+        
+        auto scalingConstant = tuner.computeScalingConstant();
+        callback("scaling constant " + std::to_string(scalingConstant));
+        
+        auto weights = tuner.tune(epochs, [&](int epoch, double error, double positionsPerSecond) {
+            callback("epoch " + std::to_string(epoch) + " error " + std::to_string(error) + " positions/s " + std::to_string(int(positionsPerSecond)));
+        });
+        return weights.save(weightsPath);
+    }
+    
+    // Number of evaluations per second of each evaluation
+    struct EvaluationBenchmark {
+        double handCrafted = 0;
+        double neuralRefresh = 0;
+        double neuralIncremental = 0;
+    };
+    
+    // Measures the speed of the hand-crafted evaluation and of the neural network, with the accumulators
+    // either computed from scratch or updated from the parent position, by evaluating the positions
+    // reached by all the moves of a few reference positions. A network with random weights is used
+    // if none has been loaded, which is as fast as any other.
+    EvaluationBenchmark benchmarkEvaluation(int iterations = 100) {
+        NeuralNetwork randomNetwork;
+        const NeuralNetwork *network = &ChessEvaluater::network;
+        if (!network->isReady()) {
+            randomNetwork.randomize(1);
+            network = &randomNetwork;
+        }
+        
+        const char *fens[] = {
+            StartFEN,
+            "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+            "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP3PPP/R2QKB1R w KQ - 0 8",
+            "8/2k5/3p4/p2P1p2/P4P2/1K6/8/8 w - - 0 1"
+        };
+        
+        std::vector<ChessBoard> parents;
+        std::vector<std::vector<std::pair<Move, ChessBoard>>> children;
+        int count = 0;
+        for (auto fen : fens) {
+            ChessBoard board;
+            FFEN::setFEN(fen, board);
+            parents.push_back(board);
+            
+            std::vector<std::pair<Move, ChessBoard>> boards;
+            auto moves = ChessMoveGenerator::generateMoves(board);
+            for (int index=0; index<moves.count; index++) {
+                auto child = board;
+                child.move(moves.moves[index]);
+                boards.push_back(std::make_pair(moves.moves[index], child));
+            }
+            count += (int)boards.size();
+            children.push_back(boards);
+        }
+        
+        // The sum of the evaluations is only there to make sure none of them is optimized away
+        int sum = 0;
+        auto evaluationsPerSecond = [&](std::function<void(size_t)> evaluate) {
+            TimeManagement clock;
+            clock.start();
+            for (int iteration=0; iteration<iterations; iteration++) {
+                for (size_t index=0; index<parents.size(); index++) {
+                    evaluate(index);
+                }
+            }
+            clock.stop();
+            return double(count) * iterations * 1000 / std::max(clock.elapsedMilli(), 0.001);
+        };
+        
+        EvaluationBenchmark benchmark;
+        benchmark.handCrafted = evaluationsPerSecond([&](size_t index) {
+            for (auto &child : children[index]) {
+                AttackInfo info(child.second);
+                sum += ChessEvaluater::evaluatePosition(info);
+            }
+        });
+        benchmark.neuralRefresh = evaluationsPerSecond([&](size_t index) {
+            for (auto &child : children[index]) {
+                sum += network->evaluate(child.second);
+            }
+        });
+        NeuralAccumulatorStack accumulators;
+        benchmark.neuralIncremental = evaluationsPerSecond([&](size_t index) {
+            accumulators.reset();
+            accumulators.accumulator(*network, parents[index]);
+            for (auto &child : children[index]) {
+                accumulators.push(child.first);
+                sum += network->evaluate(child.second, accumulators.accumulator(*network, child.second));
+                accumulators.pop();
+            }
+        });
+        (void)sum;
+        return benchmark;
+    }
 };
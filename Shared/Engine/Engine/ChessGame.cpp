@@ -53,10 +53,18 @@ std::vector<Move> ChessGame::movesAt(File file, Rank rank) {
 }
 
 std::vector<Move> ChessGame::allMoves() {
+    // The nodes store the compact moves, which are decoded
+    // while replaying the game from its initial position.
+    ChessBoard replay;
+    auto result = FFEN::setFEN(initialFEN, replay);
+    assert(result);
+    
     std::vector<Move> all;
-    MoveNode currentNode = root;
-    root.visit(0, moveIndexes, moveIndexes.moveCursor, [&all](auto & node, int cursor) {
-        all.push_back(node.move);
+    root.visit(0, moveIndexes, moveIndexes.moveCursor, [&all, &replay](auto & node, int) {
+        auto move = replay.decodeMove(node.move);
+        assert(MOVE_ISVALID(move));
+        all.push_back(move);
+        replay.move(move);
     });
     return all;
 }
@@ -79,7 +87,7 @@ void ChessGame::move(Move move, std::string comment, bool replace) {
             // This happens, for example, when a PGN has been loaded and
             // the player is playing a series of move that correspond to that PGN.
             for (int index=0; index<node.variations.size(); index++) {
-                if (node.variations[index].move == move) {
+                if (node.variations[index].move == COMPACT_MOVE(move)) {
                     moveIndexes.add(index);
                     found = true;
                     break;
@@ -94,7 +102,7 @@ void ChessGame::move(Move move, std::string comment, bool replace) {
             newNode.uuid = nextMoveUUID();
             newNode.moveNumber = ceil(moveIndexes.moveCursor / 2) + 1;
             newNode.comment = comment;
-            newNode.move = move;
+            newNode.move = COMPACT_MOVE(move);
             node.variations.push_back(newNode);
             
             // Insert the index of that new variation to the current move indexes
@@ -67,8 +67,9 @@ public:
         // The full move number
         unsigned moveNumber;
         
-        // The move itself
-        Move move;
+        // The move itself, in its compact form: the full move is decoded
+        // with the board on which it is played (see ChessBoard::decodeMove).
+        CompactMove move = INVALID_COMPACT_MOVE;
 
         // The comment associated with the move
         std::string comment;
@@ -109,7 +110,7 @@ public:
         bool matches(int cursor, std::vector<Move> moves, NodeCallback callback) {
             if (cursor < moves.size()) {
                 for (int vindex=0; vindex<variations.size(); vindex++) {
-                    if (variations[vindex].move == moves[cursor]) {
+                    if (variations[vindex].move == COMPACT_MOVE(moves[cursor])) {
                         return variations[vindex].matches(cursor+1, moves, callback);
                     }
                 }
@@ -154,14 +155,14 @@ public:
     }
     
     Move getMoveAtIndex(int indexMove) {
-        Move move = INVALID_MOVE;
-        // Note: use indexMove+1 because the node at index 0 is the root node
-        // which does not represent the first move (the first move is attached
-        // to the root node in the variations list).
-        root.lookupNode(0, indexMove+1, moveIndexes, [&move](auto & node) {
-            move = node.move;
-        });
-        return move;
+        // Note: the nodes only store the compact moves, which are decoded
+        // by replaying the game up to the current move.
+        auto moves = allMoves();
+        if (indexMove < moves.size()) {
+            return moves[indexMove];
+        } else {
+            return INVALID_MOVE;
+        }
     }
     
     unsigned int getCurrentMoveUUID() {
@@ -8,6 +8,7 @@
 
 #include "ChessOpenings.hpp"
 #include "FPGN.hpp"
+#include "FFEN.hpp"
 #include "FUtility.hpp"
 
 ChessOpenings::ChessOpenings() {
@@ -32,9 +33,17 @@ bool ChessOpenings::lookupAll(std::vector<Move> moves, OpeningsCallback callback
     std::vector<OpeningMove> possibleMoves;
     for (int gIndex=0; gIndex<games.size(); gIndex++) {
         auto & game = games[gIndex];
-        game.getRoot().matches(0, moves, [&game, &callback, &possibleMoves](auto &node) {
+        game.getRoot().matches(0, moves, [&game, &moves, &possibleMoves](auto &node) {
+            // The node matches the last move and stores the next ones in their compact form,
+            // decoded with the board reached after all the moves.
+            ChessBoard board;
+            FFEN::setFEN(game.initialFEN, board);
+            for (auto move : moves) {
+                board.move(move);
+            }
+            
             auto opening = OpeningMove();
-            opening.move = node.move;
+            opening.move = moves.empty() ? INVALID_MOVE : moves.back();
             opening.name = game.tags["Name"];
             opening.score = 0;
             auto scoreString = game.tags["Score"];
@@ -42,7 +51,7 @@ bool ChessOpenings::lookupAll(std::vector<Move> moves, OpeningsCallback callback
                 opening.score = integer(scoreString);
             }
             for (int vindex=0; vindex<node.variations.size(); vindex++) {
-                opening.nextMoves.push_back(node.variations[vindex].move);
+                opening.nextMoves.push_back(board.decodeMove(node.variations[vindex].move));
             }
             possibleMoves.push_back(opening);
         });
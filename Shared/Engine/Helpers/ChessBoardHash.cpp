@@ -27,65 +27,97 @@ class PRNG {
     
     uint64_t s;
     
-    uint64_t rand64() {
+    constexpr uint64_t rand64() {
         s ^= s >> 12;
         s ^= s << 25;
         s ^= s >> 27;
-        return s * 2685821657736338717LL;
+        return s * 2685821657736338717ULL;
     }
     
 public:
-    PRNG(uint64_t seed) : s(seed) { assert(seed); }
+    constexpr PRNG(uint64_t seed) : s(seed) { assert(seed); }
     
-    template<typename T> T rand() { return T(rand64()); }
+    template<typename T> constexpr T rand() { return T(rand64()); }
     
     /// Special generator used to fast init magic numbers.
     /// Output values only have 1/8th of their bits set on average.
-    template<typename T> T sparse_rand()
+    template<typename T> constexpr T sparse_rand()
     { return T(rand64() & rand64() & rand64()); }
 };
 
 // See https://en.wikipedia.org/wiki/Zobrist_hashing
 // See https://chessprogramming.wikispaces.com/Zobrist+Hashing
 
-static uint64_t zobrist[64][12];
-
-static uint64_t side;
-
-void ChessBoardHash::initialize() {
-    PRNG rng(1070372);
-    for (Square square=0; square<64; square++) {
-        for (int piece=0; piece<12; piece++) {
-            zobrist[square][piece] = rng.rand<BoardHash>();
+// The keys are generated at compile time so they live in the read-only data of the program
+struct ZobristKeys {
+    uint64_t pieces[64][12];
+    uint64_t side;
+    uint64_t castling[16];
+    uint64_t enPassant[8];
+    
+    constexpr ZobristKeys() : pieces(), side(0), castling(), enPassant() {
+        PRNG rng(1070372);
+        for (Square square=0; square<64; square++) {
+            for (int piece=0; piece<12; piece++) {
+                pieces[square][piece] = rng.rand<BoardHash>();
+            }
+        }
+        side = rng.rand<BoardHash>();
+        for (int index=1; index<16; index++) {
+            castling[index] = rng.rand<BoardHash>();
+        }
+        for (int file=0; file<8; file++) {
+            enPassant[file] = rng.rand<BoardHash>();
         }
     }
-    side = rng.rand<BoardHash>();
-}
+};
 
-BoardHash ChessBoardHash::hash(ChessBoard board) {
+static constexpr ZobristKeys Zobrist = ZobristKeys();
+
+BoardHash ChessBoardHash::hash(const ChessBoard &board) {
     uint64_t h = 0;
     for (Square square=0; square<64; square++) {
-        auto file = FileFrom(square);
-        auto rank = RankFrom(square);
-        auto boardSquare = board.get(file, rank);
-        if (boardSquare.empty) continue;
+        auto content = board.mailbox[square];
+        if (content == EMPTY_SQUARE) continue;
         
-        h ^= getPseudoNumber(square, boardSquare.color, boardSquare.piece);
+        // Note: the content of a square is also the index of the piece in the Zobrist table
+        h ^= Zobrist.pieces[square][content];
     }
     
     if (board.color == WHITE) {
-        h ^= side;
+        h ^= Zobrist.side;
     }
     
     return h;
 }
 
+BoardHash ChessBoardHash::pawnHash(const ChessBoard &board) {
+    uint64_t h = 0;
+    for (unsigned color=0; color<COUNT; color++) {
+        auto pawns = board.pieces[color][PAWN];
+        while (pawns > 0) {
+            Square square = lsb(pawns);
+            bb_clear(pawns, square);
+            h ^= Zobrist.pieces[square][SQUARE_CONTENT((Color)color, PAWN)];
+        }
+    }
+    return h;
+}
+
+BoardHash ChessBoardHash::exactHash(ChessBoard &board) {
+    auto h = board.getHash() ^ Zobrist.castling[board.castling & ALL_CASTLING];
+    if (board.enPassantSquare > 0) {
+        h ^= Zobrist.enPassant[FileFrom(board.enPassantSquare)];
+    }
+    return h;
+}
+
 uint64_t ChessBoardHash::getPseudoNumber(Square square, Color color, Piece piece) {
     int offsetPiece = color == WHITE ? 0 : PCOUNT;
-    return zobrist[square][piece+offsetPiece];
+    return Zobrist.pieces[square][piece+offsetPiece];
 }
 
 uint64_t ChessBoardHash::getWhiteTurn() {
-    return side;
+    return Zobrist.side;
 }
 
@@ -13,9 +13,14 @@
 
 class ChessBoardHash {    
 public:
-    static void initialize();
+    static BoardHash hash(const ChessBoard &board);
     
-    static BoardHash hash(ChessBoard board);
+    // Key of the pawns only, which is 0 when there are no pawns
+    static BoardHash pawnHash(const ChessBoard &board);
+    
+    // Same as the board hash but including the castling rights and the en-passant square,
+    // for the positions that must match exactly (they can change the available moves).
+    static BoardHash exactHash(ChessBoard &board);
     
     static uint64_t getPseudoNumber(Square square, Color color, Piece piece);
     
@@ -127,9 +127,8 @@ std::string FFEN::getFEN(ChessBoard board, bool hash) {
     fen += " "+board.getCastling();
     
     // En passant
-    if (board.enPassant > 0) {
-        int square = lsb(board.enPassant);
-        fen += " "+SquareNames[square];
+    if (board.enPassantSquare > 0) {
+        fen += " "+SquareNames[board.enPassantSquare];
     } else {
         fen += " -";
     }
@@ -198,9 +197,9 @@ bool FFEN::setFEN(std::string fen, ChessBoard &board) {
     if (fields.size() > 3) {
         auto enPassant = fields[3];
         if (enPassant == "-") {
-            board.enPassant = 0;
+            board.enPassantSquare = 0;
         } else {
-            bb_set(board.enPassant, squareForName(enPassant));
+            board.enPassantSquare = squareForName(enPassant);
         }
     }
     
@@ -787,7 +787,7 @@ static void getPGN(ChessBoard board, // The chess board representation which is
                    bool recursive, // True if this method should continue to traverse the next move and all its variation, false to just output this move and return
                    bool skip // True if the PGN output should be skipped for this method executed
 ) {
-    auto move = node.move;
+    auto move = board.decodeMove(node.move);
     auto piece = MOVE_PIECE(move);
     
     if (formatting == FPGN::Formatting::line && moveIndex == fromMoveIndex && !skip) {
@@ -11,6 +11,9 @@
 #include <string>
 #include <algorithm>
 #include <iterator>
+#include <functional>
+#include <thread>
+#include <vector>
 
 template <class Container>
 void split4(const std::string& str, Container& cont,
@@ -35,3 +38,16 @@ inline static int integer(std::string string) {
     }
 }
 
+// Calls the function for each range of the count, in parallel
+inline static void parallelFor(size_t count, int threads, std::function<void(int thread, size_t start, size_t end)> function) {
+    std::vector<std::thread> workers;
+    size_t chunk = (count + threads - 1) / threads;
+    for (int thread=0; thread<threads; thread++) {
+        size_t start = std::min(count, thread * chunk);
+        size_t end = std::min(count, start + chunk);
+        workers.push_back(std::thread(function, thread, start, end));
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
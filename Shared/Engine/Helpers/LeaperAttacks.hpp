@@ -0,0 +1,60 @@
+//
+//  LeaperAttacks.hpp
+//  BChess
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#pragma once
+
+#include "Bitboard.hpp"
+#include "Color.hpp"
+
+// Attacks of the pieces that jump to their destination (pawn captures, king and knight)
+// for each square. The tables are computed at compile time so they live in the
+// read-only data of the program and don't need any initialization.
+struct LeaperAttackTables {
+    Bitboard pawnAttacks[COUNT][64];
+    Bitboard kingMoves[64];
+    Bitboard knightMoves[64];
+    
+    constexpr LeaperAttackTables() : pawnAttacks(), kingMoves(), knightMoves() {
+        for (Square square = 0; square < 64; square++) {
+            File file = FileFrom(square);
+            Rank rank = RankFrom(square);
+            
+            // Note: generate moves even for the first and last rank, because it
+            // is used by the some functions to determine if a piece is attacked
+            // by a pawn which might need white pawn in the first rank or a black
+            // pawn in the last rank to determine proper attack.
+            bb_set(pawnAttacks[WHITE][square], file-1, rank+1);
+            bb_set(pawnAttacks[WHITE][square], file+1, rank+1);
+            bb_set(pawnAttacks[BLACK][square], file-1, rank-1);
+            bb_set(pawnAttacks[BLACK][square], file+1, rank-1);
+            
+            bb_set(kingMoves[square], file, rank+1);
+            bb_set(kingMoves[square], file+1, rank+1);
+            bb_set(kingMoves[square], file+1, rank);
+            bb_set(kingMoves[square], file+1, rank-1);
+            bb_set(kingMoves[square], file, rank-1);
+            bb_set(kingMoves[square], file-1, rank-1);
+            bb_set(kingMoves[square], file-1, rank);
+            bb_set(kingMoves[square], file-1, rank+1);
+            
+            bb_set(knightMoves[square], file-1, rank+2);
+            bb_set(knightMoves[square], file+1, rank+2);
+            bb_set(knightMoves[square], file-1, rank-2);
+            bb_set(knightMoves[square], file+1, rank-2);
+            bb_set(knightMoves[square], file-2, rank+1);
+            bb_set(knightMoves[square], file-2, rank-1);
+            bb_set(knightMoves[square], file+2, rank+1);
+            bb_set(knightMoves[square], file+2, rank-1);
+        }
+    }
+};
+
+static constexpr LeaperAttackTables LeaperAttacks = LeaperAttackTables();
+
+static constexpr const Bitboard (&PawnAttacks)[COUNT][64] = LeaperAttacks.pawnAttacks;
+static constexpr const Bitboard (&KingMoves)[64] = LeaperAttacks.kingMoves;
+static constexpr const Bitboard (&KnightMoves)[64] = LeaperAttacks.knightMoves;
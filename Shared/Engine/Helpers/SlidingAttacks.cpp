@@ -0,0 +1,172 @@
+//
+//  SlidingAttacks.cpp
+//  BChess
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#include "SlidingAttacks.hpp"
+
+#include <chrono>
+
+#ifdef SLIDING_ATTACKS_PEXT
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+bool SlidingAttacks::usePEXT = false;
+
+// Attacks for each square indexed by the PEXT of the occupancy with
+// the relevant occupancy mask of the square (the same masks as the magic
+// bitboards): the attacks of a square start at the offset of that square.
+// Note: plain arrays (and not vectors) so they don't depend on the order
+// in which the static variables of the program are initialized.
+static Bitboard RookPEXTAttacks[102400];
+static Bitboard BishopPEXTAttacks[5248];
+static unsigned RookPEXTOffsets[64];
+static unsigned BishopPEXTOffsets[64];
+
+static void buildTable(Bitboard *table, unsigned offsets[64], const U64 masks[64], Bitboard (*attacks)(Square, Bitboard)) {
+    unsigned size = 0;
+    for (Square square = 0; square < 64; square++) {
+        offsets[square] = size;
+        
+        // Enumerate all the subsets of the mask (Carry-Rippler trick) which happens
+        // to be in the same order as the index given by PEXT for each subset.
+        // https://www.chessprogramming.org/Traversing_Subsets_of_a_Set
+        Bitboard mask = masks[square];
+        Bitboard occupancy = 0;
+        do {
+            table[size++] = attacks(square, occupancy);
+            occupancy = (occupancy - mask) & mask;
+        } while (occupancy != 0);
+    }
+}
+
+static Bitboard rookMagicAttacks(Square square, Bitboard occupancy) {
+    return Rmagic(square, occupancy);
+}
+
+static Bitboard bishopMagicAttacks(Square square, Bitboard occupancy) {
+    return Bmagic(square, occupancy);
+}
+
+static bool buildTables() {
+    initmagicmoves();
+    
+    buildTable(RookPEXTAttacks, RookPEXTOffsets, magicmoves_r_mask, rookMagicAttacks);
+    buildTable(BishopPEXTAttacks, BishopPEXTOffsets, magicmoves_b_mask, bishopMagicAttacks);
+    
+    SlidingAttacks::setBackend(SlidingAttacks::isPEXTAvailable() ? SlidingAttacks::Backend::pext : SlidingAttacks::Backend::magic);
+    return true;
+}
+
+void SlidingAttacks::initialize() {
+    // The tables are built only once, even if several threads call this method
+    static bool initialized = buildTables();
+    (void)initialized;
+}
+
+// The tables are built when the program starts so there is no need to call initialize() explicitly
+static struct SlidingAttacksInitializer {
+    SlidingAttacksInitializer() {
+        SlidingAttacks::initialize();
+    }
+} slidingAttacksInitializer;
+
+bool SlidingAttacks::isPEXTAvailable() {
+#ifdef SLIDING_ATTACKS_PEXT
+    // BMI2 is reported by bit 8 of EBX for the leaf 7 (extended features)
+    unsigned eax, ebx, ecx, edx;
+    if (__get_cpuid_max(0, nullptr) >= 7) {
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        return (ebx & (1 << 8)) != 0;
+    }
+#endif
+    return false;
+}
+
+SlidingAttacks::Backend SlidingAttacks::getBackend() {
+    return usePEXT ? Backend::pext : Backend::magic;
+}
+
+bool SlidingAttacks::setBackend(Backend backend) {
+    if (backend == Backend::pext && !isPEXTAvailable()) {
+        return false;
+    }
+    usePEXT = backend == Backend::pext;
+    return true;
+}
+
+#ifdef SLIDING_ATTACKS_PEXT
+
+__attribute__((target("bmi2")))
+Bitboard SlidingAttacks::rookAttacksPEXT(Square square, Bitboard occupancy) {
+    return RookPEXTAttacks[RookPEXTOffsets[square] + _pext_u64(occupancy, magicmoves_r_mask[square])];
+}
+
+__attribute__((target("bmi2")))
+Bitboard SlidingAttacks::bishopAttacksPEXT(Square square, Bitboard occupancy) {
+    return BishopPEXTAttacks[BishopPEXTOffsets[square] + _pext_u64(occupancy, magicmoves_b_mask[square])];
+}
+
+#else
+
+// Returns the bits of the occupancy selected by the mask packed together,
+// which is what PEXT does in one instruction.
+static unsigned extractBits(Bitboard occupancy, Bitboard mask) {
+    unsigned index = 0;
+    unsigned bit = 0;
+    while (mask > 0) {
+        Square square = lsb(mask);
+        bb_clear(mask, square);
+        if (bb_test(occupancy, square)) {
+            index |= 1 << bit;
+        }
+        bit++;
+    }
+    return index;
+}
+
+Bitboard SlidingAttacks::rookAttacksPEXT(Square square, Bitboard occupancy) {
+    return RookPEXTAttacks[RookPEXTOffsets[square] + extractBits(occupancy, magicmoves_r_mask[square])];
+}
+
+Bitboard SlidingAttacks::bishopAttacksPEXT(Square square, Bitboard occupancy) {
+    return BishopPEXTAttacks[BishopPEXTOffsets[square] + extractBits(occupancy, magicmoves_b_mask[square])];
+}
+
+#endif
+
+double SlidingAttacks::benchmark(Backend backend, int iterations) {
+    auto previousBackend = getBackend();
+    if (!setBackend(backend)) {
+        return 0;
+    }
+    
+    // Pseudo-random occupancies (xorshift) so the lookups are spread over the tables
+    const int OCCUPANCY_COUNT = 1024;
+    Bitboard occupancies[OCCUPANCY_COUNT];
+    Bitboard seed = 1070372;
+    for (int index = 0; index < OCCUPANCY_COUNT; index++) {
+        seed ^= seed >> 12;
+        seed ^= seed << 25;
+        seed ^= seed >> 27;
+        occupancies[index] = seed * 2685821657736338717ULL & (seed >> 7);
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    Bitboard result = 0;
+    for (int index = 0; index < iterations; index++) {
+        Square square = index & 63;
+        Bitboard occupancy = occupancies[index & (OCCUPANCY_COUNT - 1)] ^ result;
+        result ^= RookAttacks(square, occupancy);
+        result ^= BishopAttacks(square, occupancy);
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    setBackend(previousBackend);
+    
+    // Note: use the result so the loop is not optimized away
+    return result == 1 ? 0 : 2.0 * iterations / elapsed;
+}
@@ -0,0 +1,103 @@
+//
+//  SlidingAttacks.hpp
+//  BChess
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#pragma once
+
+#include "Bitboard.hpp"
+
+// Without this, the C file won't be linked
+extern "C" void initmagicmoves(void);
+
+#include "magicmoves.h"
+
+// PEXT requires BMI2 which is only available on x86-64. The instruction is
+// compiled in a separate function and only used when the CPU supports it.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SLIDING_ATTACKS_PEXT
+#endif
+
+// Attacks of the sliding pieces (rook and bishop, the queen being the union of both)
+// for a particular square and occupancy. Two backends are available:
+// - magic: the multiply-and-shift magic bitboards of magicmoves.c, always available.
+// - pext: tables indexed by the PEXT instruction of the occupancy with the
+//   relevant occupancy mask of the square, used when the CPU supports BMI2.
+class SlidingAttacks {
+public:
+    enum class Backend {
+        magic,
+        pext
+    };
+    
+    // True when the PEXT backend is selected. Read by the attack functions below.
+    static bool usePEXT;
+    
+    // Builds the magic and PEXT tables and selects the fastest backend available.
+    // This is done automatically when the program starts and only once.
+    static void initialize();
+    
+    // Returns true if the CPU supports BMI2 (and so the PEXT instruction)
+    static bool isPEXTAvailable();
+    
+    static Backend getBackend();
+    
+    // Selects the backend to use, returns false if the backend is not available
+    static bool setBackend(Backend backend);
+    
+    // Returns the number of rook and bishop lookups per second using the specified backend
+    static double benchmark(Backend backend, int iterations = 10*1000*1000);
+    
+    static Bitboard rookAttacksPEXT(Square square, Bitboard occupancy);
+    static Bitboard bishopAttacksPEXT(Square square, Bitboard occupancy);
+};
+
+inline static Bitboard RookAttacks(Square square, Bitboard occupancy) {
+#ifdef SLIDING_ATTACKS_PEXT
+    if (SlidingAttacks::usePEXT) {
+        return SlidingAttacks::rookAttacksPEXT(square, occupancy);
+    }
+#endif
+    return Rmagic(square, occupancy);
+}
+
+inline static Bitboard BishopAttacks(Square square, Bitboard occupancy) {
+#ifdef SLIDING_ATTACKS_PEXT
+    if (SlidingAttacks::usePEXT) {
+        return SlidingAttacks::bishopAttacksPEXT(square, occupancy);
+    }
+#endif
+    return Bmagic(square, occupancy);
+}
+
+// Squares strictly between two squares on the same rank, file or diagonal,
+// empty when the two squares are not aligned. Used to find the pieces that
+// block (or pin) a sliding attack, the table is computed at compile time.
+struct BetweenTables {
+    Bitboard squares[64][64];
+    
+    constexpr BetweenTables() : squares() {
+        const int fileDirections[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+        const int rankDirections[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+        for (Square from = 0; from < 64; from++) {
+            for (int direction = 0; direction < 8; direction++) {
+                Bitboard ray = 0;
+                int file = FileFrom(from) + fileDirections[direction];
+                int rank = RankFrom(from) + rankDirections[direction];
+                while (file >= 0 && file <= 7 && rank >= 0 && rank <= 7) {
+                    Square to = SquareFrom(file, rank);
+                    squares[from][to] = ray;
+                    bb_set(ray, to);
+                    file += fileDirections[direction];
+                    rank += rankDirections[direction];
+                }
+            }
+        }
+    }
+};
+
+static constexpr BetweenTables Between = BetweenTables();
+
+static constexpr const Bitboard (&SquaresBetween)[64][64] = Between.squares;
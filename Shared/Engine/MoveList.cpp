@@ -22,64 +22,68 @@ std::string MoveList::description() {
     return text;
 }
 
-void MoveList::addSingleMove(ChessBoard &board, Move move) {
-    ChessBoard validBoard = board;
-    validBoard.move(move);
-    // Note: make sure the move that was just played doesn't make it's king in check.
-    if (!validBoard.isCheck(MOVE_COLOR(move))) {
-        // Determine if the move makes the king of the opposite side in check.
-        // This is used to know which moves to use during quiescence search,
-        // as a check move is not considered a quiet move.
-        // TODO: careful, we cannot just use check move in quiescence search just like that.
-        // Seems that we need to read more about when we can use the stand_pat score.
-        // See http://www.talkchess.com/forum/viewtopic.php?topic_view=threads&p=681015&t=60962
-        //        if (validBoard.isCheck(validBoard.color)) {
-        //            SET_MOVE_IS_CHECK(move);
-        //        }
+MoveList CompactMoveList::decode(ChessBoard board) const {
+    MoveList line;
+    for (int index=0; index<count; index++) {
+        auto move = board.decodeMove(moves[index]);
+        if (!MOVE_ISVALID(move)) {
+            break;
+        }
+        line.push(move);
+        board.move(move);
+    }
+    return line;
+}
+
+void MoveList::addSingleMove(AttackInfo &info, Move move) {
+    // Note: make sure the move doesn't make it's king in check.
+    if (info.isLegal(move)) {
+        // Note: the moves giving check are not flagged here, which would require to play each of them,
+        // the quiescence search generates them instead (see ChessMoveGenerator::generateQuietChecks()).
         
         // Add the valid move to the list
         push(move);
     }
 }
 
-void MoveList::addPromotionMove(ChessBoard &board, Move move, Piece promotedPiece) {
+void MoveList::addPromotionMove(AttackInfo &info, Move move, Piece promotedPiece) {
     SET_MOVE_PROMOTION_PIECE(move, promotedPiece);
-    addSingleMove(board, move);
+    addSingleMove(info, move);
 }
 
-void MoveList::addMove(ChessBoard &board, Move move) {
+void MoveList::addMove(AttackInfo &info, Move move) {
     // Handle any pawn promotion by generating the promoted moves
     if (MOVE_PIECE(move) == PAWN) {
         auto toRank = RankFrom(MOVE_TO(move));
         auto whitePromotion = MOVE_COLOR(move) == WHITE && toRank == 7;
         auto blackPromotion = MOVE_COLOR(move) == BLACK && toRank == 0;
         if (whitePromotion || blackPromotion) {
-            addPromotionMove(board, move, QUEEN);
-            addPromotionMove(board, move, ROOK);
-            addPromotionMove(board, move, BISHOP);
-            addPromotionMove(board, move, KNIGHT);
+            addPromotionMove(info, move, QUEEN);
+            addPromotionMove(info, move, ROOK);
+            addPromotionMove(info, move, BISHOP);
+            addPromotionMove(info, move, KNIGHT);
         } else {
-            addSingleMove(board, move);
+            addSingleMove(info, move);
         }
     } else {
-        addSingleMove(board, move);
+        addSingleMove(info, move);
     }
 }
 
-void MoveList::addMoves(ChessBoard &board, Square from, Bitboard moves, Piece piece) {
+void MoveList::addMoves(AttackInfo &info, Square from, Bitboard moves, Piece piece) {
     while (moves > 0) {
         Square to = lsb(moves);
         bb_clear(moves, to);
         
-        addMove(board, createMove(from, to, board.color, piece));
+        addMove(info, createMove(from, to, info.board.color, piece));
     }
 }
 
-void MoveList::addCaptures(ChessBoard &board, Square from, Bitboard moves, Color attackingPieceColor, Piece attackingPiece, Color capturedPieceColor, Piece capturedPiece) {
+void MoveList::addCaptures(AttackInfo &info, Square from, Bitboard moves, Color attackingPieceColor, Piece attackingPiece, Color capturedPieceColor, Piece capturedPiece) {
     while (moves > 0) {
         Square to = lsb(moves);
         bb_clear(moves, to);
         
-        addMove(board, createCapture(from, to, attackingPieceColor, attackingPiece, capturedPieceColor, capturedPiece));
+        addMove(info, createCapture(from, to, attackingPieceColor, attackingPiece, capturedPieceColor, capturedPiece));
     }
 }
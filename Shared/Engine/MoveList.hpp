@@ -11,6 +11,7 @@
 #include <cassert>
 #include "Move.hpp"
 #include "ChessBoard.hpp"
+#include "AttackInfo.hpp"
 
 const int MAX_MOVES = 256;
 
@@ -18,6 +19,9 @@ struct MoveList {
     Move moves[MAX_MOVES];
     int count = 0;
     
+    // Score of each move, filled by ChessMoveGenerator::scoreMoves() to order the moves
+    int scores[MAX_MOVES];
+    
     Move &operator[] (int index) {
         assert(index < MAX_MOVES);
         assert(index < count);
@@ -30,7 +34,7 @@ struct MoveList {
         count++;
     }
     
-    void push(MoveList line) {
+    void push(const MoveList &line) {
         assert(count+line.count < MAX_MOVES);
         memcpy(moves+count, line.moves, line.count * sizeof(Move));
         count += line.count;
@@ -41,6 +45,29 @@ struct MoveList {
         count--;
     }
     
+    // Moves the move with the best score, from the index to the end of the list, to the index and returns it,
+    // the first one in case of equality (the moves in-between are shifted to keep their order). The moves are
+    // selected one at a time because most of the nodes are cut after one or two moves, which makes sorting
+    // all of them useless.
+    Move selectBest(int index) {
+        assert(index < count);
+        int best = index;
+        for (int candidate=index+1; candidate<count; candidate++) {
+            if (scores[candidate] > scores[best]) {
+                best = candidate;
+            }
+        }
+        if (best != index) {
+            auto move = moves[best];
+            auto score = scores[best];
+            memmove(moves+index+1, moves+index, (best - index) * sizeof(Move));
+            memmove(scores+index+1, scores+index, (best - index) * sizeof(int));
+            moves[index] = move;
+            scores[index] = score;
+        }
+        return moves[index];
+    }
+    
     Move lookup(int index) {
         if (index < count) {
             return moves[index];
@@ -68,10 +95,47 @@ struct MoveList {
 
     std::string description();
     
-    void addSingleMove(ChessBoard &board, Move move);
-    void addPromotionMove(ChessBoard &board, Move move, Piece promotedPiece);
-    void addMove(ChessBoard &board, Move move);
-    void addMoves(ChessBoard &board, Square from, Bitboard moves, Piece piece);
-    void addCaptures(ChessBoard &board, Square from, Bitboard moves, Color attackingPieceColor, Piece attackingPiece, Color capturedPieceColor, Piece capturedPiece);
+    // The attack info of the board is used to validate the moves before adding them
+    void addSingleMove(AttackInfo &info, Move move);
+    void addPromotionMove(AttackInfo &info, Move move, Piece promotedPiece);
+    void addMove(AttackInfo &info, Move move);
+    void addMoves(AttackInfo &info, Square from, Bitboard moves, Piece piece);
+    void addCaptures(AttackInfo &info, Square from, Bitboard moves, Color attackingPieceColor, Piece attackingPiece, Color capturedPieceColor, Piece capturedPiece);
+
+};
 
+// A line of moves, like a principal variation, kept in the compact form (see CompactMove).
+// The full moves are decoded with the board on which the line starts.
+struct CompactMoveList {
+    CompactMove moves[MAX_MOVES];
+    int count = 0;
+    
+    void push(Move move) {
+        assert(count < MAX_MOVES);
+        moves[count] = COMPACT_MOVE(move);
+        count++;
+    }
+    
+    void push(const CompactMoveList &line) {
+        assert(count+line.count < MAX_MOVES);
+        memcpy(moves+count, line.moves, line.count * sizeof(CompactMove));
+        count += line.count;
+    }
+    
+    void pop() {
+        assert(count > 0);
+        count--;
+    }
+    
+    CompactMove lookup(int index) const {
+        if (index < count) {
+            return moves[index];
+        } else {
+            return INVALID_COMPACT_MOVE;
+        }
+    }
+    
+    // Returns the full moves of the line played from the specified board,
+    // up to the first one that cannot be played on it.
+    MoveList decode(ChessBoard board) const;
 };
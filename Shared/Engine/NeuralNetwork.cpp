@@ -0,0 +1,389 @@
+//
+//  NeuralNetwork.cpp
+//  BChess
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#include "NeuralNetwork.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdio.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+using namespace NNUE;
+
+static const char Magic[4] = { 'B', 'C', 'N', 'N' };
+static const uint32_t FileVersion = 1;
+
+static const int InputDimensions = 2 * HalfDimensions;
+
+// Returns the square as seen from the perspective, the board being flipped vertically for black
+inline static Square orient(Color perspective, Square square) {
+    return perspective == WHITE ? square : square ^ 56;
+}
+
+// Index of the feature of a piece (other than a king) on the square, for the perspective whose king is on kingSquare
+inline static int featureIndex(Color perspective, Square kingSquare, Color color, Piece piece, Square square) {
+    int relativePiece = (color == perspective ? 0 : 5) + piece;
+    return (orient(perspective, kingSquare) * 10 + relativePiece) * 64 + orient(perspective, square);
+}
+
+// Adds (or subtracts) the weights of a feature to the accumulator of a perspective.
+// Note: the unaligned loads are as fast as the aligned ones on aligned memory.
+inline static void addWeights(int16_t *values, const int16_t *weights) {
+#if defined(__AVX2__)
+    for (int i=0; i<HalfDimensions; i+=16) {
+        auto v = _mm256_loadu_si256((const __m256i*)&values[i]);
+        auto w = _mm256_loadu_si256((const __m256i*)&weights[i]);
+        _mm256_storeu_si256((__m256i*)&values[i], _mm256_add_epi16(v, w));
+    }
+#elif defined(__SSSE3__)
+    for (int i=0; i<HalfDimensions; i+=8) {
+        auto v = _mm_loadu_si128((const __m128i*)&values[i]);
+        auto w = _mm_loadu_si128((const __m128i*)&weights[i]);
+        _mm_storeu_si128((__m128i*)&values[i], _mm_add_epi16(v, w));
+    }
+#else
+    for (int i=0; i<HalfDimensions; i++) {
+        values[i] += weights[i];
+    }
+#endif
+}
+
+inline static void subtractWeights(int16_t *values, const int16_t *weights) {
+#if defined(__AVX2__)
+    for (int i=0; i<HalfDimensions; i+=16) {
+        auto v = _mm256_loadu_si256((const __m256i*)&values[i]);
+        auto w = _mm256_loadu_si256((const __m256i*)&weights[i]);
+        _mm256_storeu_si256((__m256i*)&values[i], _mm256_sub_epi16(v, w));
+    }
+#elif defined(__SSSE3__)
+    for (int i=0; i<HalfDimensions; i+=8) {
+        auto v = _mm_loadu_si128((const __m128i*)&values[i]);
+        auto w = _mm_loadu_si128((const __m128i*)&weights[i]);
+        _mm_storeu_si128((__m128i*)&values[i], _mm_sub_epi16(v, w));
+    }
+#else
+    for (int i=0; i<HalfDimensions; i++) {
+        values[i] -= weights[i];
+    }
+#endif
+}
+
+// Computes the dot products of the activations (between 0 and 127) with the 8-bit weights of four outputs,
+// the weights of each output following the ones of the previous output and the count being a multiple of 32.
+// The products of the four outputs are summed in separate registers and reduced together at the end,
+// which costs much less than reducing them one by one.
+// Note: maddubs adds the products two by two in 16 bits, which cannot saturate
+// because 2 * 127 * 128 fits in 16 bits.
+inline static void dotProducts4(const uint8_t *input, const int8_t *weights, int count, int32_t *sums) {
+#if defined(__AVX2__)
+    auto ones = _mm256_set1_epi16(1);
+    auto sum0 = _mm256_setzero_si256(), sum1 = sum0, sum2 = sum0, sum3 = sum0;
+    for (int i=0; i<count; i+=32) {
+        auto a = _mm256_loadu_si256((const __m256i*)&input[i]);
+        sum0 = _mm256_add_epi32(sum0, _mm256_madd_epi16(_mm256_maddubs_epi16(a, _mm256_loadu_si256((const __m256i*)&weights[i])), ones));
+        sum1 = _mm256_add_epi32(sum1, _mm256_madd_epi16(_mm256_maddubs_epi16(a, _mm256_loadu_si256((const __m256i*)&weights[count + i])), ones));
+        sum2 = _mm256_add_epi32(sum2, _mm256_madd_epi16(_mm256_maddubs_epi16(a, _mm256_loadu_si256((const __m256i*)&weights[2 * count + i])), ones));
+        sum3 = _mm256_add_epi32(sum3, _mm256_madd_epi16(_mm256_maddubs_epi16(a, _mm256_loadu_si256((const __m256i*)&weights[3 * count + i])), ones));
+    }
+    auto sum = _mm256_hadd_epi32(_mm256_hadd_epi32(sum0, sum1), _mm256_hadd_epi32(sum2, sum3));
+    _mm_storeu_si128((__m128i*)sums, _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1)));
+#elif defined(__SSSE3__)
+    auto ones = _mm_set1_epi16(1);
+    auto sum0 = _mm_setzero_si128(), sum1 = sum0, sum2 = sum0, sum3 = sum0;
+    for (int i=0; i<count; i+=16) {
+        auto a = _mm_loadu_si128((const __m128i*)&input[i]);
+        sum0 = _mm_add_epi32(sum0, _mm_madd_epi16(_mm_maddubs_epi16(a, _mm_loadu_si128((const __m128i*)&weights[i])), ones));
+        sum1 = _mm_add_epi32(sum1, _mm_madd_epi16(_mm_maddubs_epi16(a, _mm_loadu_si128((const __m128i*)&weights[count + i])), ones));
+        sum2 = _mm_add_epi32(sum2, _mm_madd_epi16(_mm_maddubs_epi16(a, _mm_loadu_si128((const __m128i*)&weights[2 * count + i])), ones));
+        sum3 = _mm_add_epi32(sum3, _mm_madd_epi16(_mm_maddubs_epi16(a, _mm_loadu_si128((const __m128i*)&weights[3 * count + i])), ones));
+    }
+    _mm_storeu_si128((__m128i*)sums, _mm_hadd_epi32(_mm_hadd_epi32(sum0, sum1), _mm_hadd_epi32(sum2, sum3)));
+#else
+    for (int j=0; j<4; j++) {
+        sums[j] = 0;
+        for (int i=0; i<count; i++) {
+            sums[j] += input[i] * weights[j * count + i];
+        }
+    }
+#endif
+}
+
+inline static uint8_t clippedReLU(int value) {
+    return (uint8_t)std::max(0, std::min(value, ActivationMax));
+}
+
+// Clips the values of an accumulator to [0, 127] (see ActivationMax), the count being a multiple of 32
+inline static void clipAccumulator(const int16_t *values, uint8_t *output, int count) {
+#if defined(__AVX2__)
+    auto zero = _mm256_setzero_si256();
+    for (int i=0; i<count; i+=32) {
+        auto a = _mm256_max_epi16(_mm256_loadu_si256((const __m256i*)&values[i]), zero);
+        auto b = _mm256_max_epi16(_mm256_loadu_si256((const __m256i*)&values[i + 16]), zero);
+        // The pack saturates to 127 but interleaves the 128-bit lanes of a and b, which the permutation restores
+        auto packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm256_storeu_si256((__m256i*)&output[i], packed);
+    }
+#elif defined(__SSSE3__)
+    auto zero = _mm_setzero_si128();
+    for (int i=0; i<count; i+=16) {
+        auto a = _mm_max_epi16(_mm_loadu_si128((const __m128i*)&values[i]), zero);
+        auto b = _mm_max_epi16(_mm_loadu_si128((const __m128i*)&values[i + 8]), zero);
+        _mm_storeu_si128((__m128i*)&output[i], _mm_packs_epi16(a, b));
+    }
+#else
+    for (int i=0; i<count; i++) {
+        output[i] = clippedReLU(values[i]);
+    }
+#endif
+}
+
+// Dense layer with a clipped ReLU activation, the output count being a multiple of 4
+inline static void propagate(const uint8_t *input, int inputCount, const int8_t *weights, const int32_t *biases, uint8_t *output, int outputCount) {
+    for (int i=0; i<outputCount; i+=4) {
+        int32_t sums[4];
+        dotProducts4(input, &weights[i * inputCount], inputCount, sums);
+        for (int j=0; j<4; j++) {
+            output[i + j] = clippedReLU((biases[i + j] + sums[j]) >> WeightScaleBits);
+        }
+    }
+}
+
+// Returns the dot product of the activations with the 8-bit weights of the output layer
+inline static int32_t dotProduct(const uint8_t *input, const int8_t *weights, int count) {
+    int32_t sum = 0;
+    for (int i=0; i<count; i++) {
+        sum += input[i] * weights[i];
+    }
+    return sum;
+}
+
+void NeuralNetwork::allocate() {
+    featureBiases.assign(HalfDimensions, 0);
+    featureWeights.assign(FeatureCount * HalfDimensions, 0);
+    biases1.assign(Hidden1, 0);
+    weights1.assign(Hidden1 * InputDimensions, 0);
+    biases2.assign(Hidden2, 0);
+    weights2.assign(Hidden2 * Hidden1, 0);
+    outputWeights.assign(Hidden2, 0);
+}
+
+// The file starts with the magic "BCNN", the version of the format and the dimensions of the network,
+// followed by the biases and weights of each layer, in the order of the class members.
+// Note: the values are stored in little-endian, which is the byte order of all the supported platforms.
+template <typename T> static bool readArray(FILE *file, std::vector<T> &array) {
+    return fread(array.data(), sizeof(T), array.size(), file) == array.size();
+}
+
+template <typename T> static bool writeArray(FILE *file, const std::vector<T> &array) {
+    return fwrite(array.data(), sizeof(T), array.size(), file) == array.size();
+}
+
+bool NeuralNetwork::load(std::string path) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+
+    char magic[4];
+    uint32_t header[5];
+    uint32_t expectedHeader[5] = { FileVersion, FeatureCount, HalfDimensions, Hidden1, Hidden2 };
+    bool valid = fread(magic, 1, sizeof(magic), file) == sizeof(magic) && memcmp(magic, Magic, sizeof(Magic)) == 0 &&
+                 fread(header, sizeof(uint32_t), 5, file) == 5 && memcmp(header, expectedHeader, sizeof(header)) == 0;
+
+    // Read the weights into a separate network to leave this one unchanged if the file is invalid
+    NeuralNetwork network;
+    if (valid) {
+        network.allocate();
+        valid = readArray(file, network.featureBiases) && readArray(file, network.featureWeights) &&
+                readArray(file, network.biases1) && readArray(file, network.weights1) &&
+                readArray(file, network.biases2) && readArray(file, network.weights2) &&
+                fread(&network.outputBias, sizeof(int32_t), 1, file) == 1 && readArray(file, network.outputWeights) &&
+                fgetc(file) == EOF;
+    }
+    fclose(file);
+
+    if (valid) {
+        network.ready = true;
+        network.version = version + 1;
+        *this = std::move(network);
+    }
+    return valid;
+}
+
+bool NeuralNetwork::save(std::string path) {
+    if (!ready) {
+        return false;
+    }
+
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    uint32_t header[5] = { FileVersion, FeatureCount, HalfDimensions, Hidden1, Hidden2 };
+    bool success = fwrite(Magic, 1, sizeof(Magic), file) == sizeof(Magic) &&
+                   fwrite(header, sizeof(uint32_t), 5, file) == 5 &&
+                   writeArray(file, featureBiases) && writeArray(file, featureWeights) &&
+                   writeArray(file, biases1) && writeArray(file, weights1) &&
+                   writeArray(file, biases2) && writeArray(file, weights2) &&
+                   fwrite(&outputBias, sizeof(int32_t), 1, file) == 1 && writeArray(file, outputWeights);
+    return fclose(file) == 0 && success;
+}
+
+void NeuralNetwork::randomize(uint64_t seed) {
+    allocate();
+
+    // https://en.wikipedia.org/wiki/Xorshift
+    uint64_t state = seed | 1;
+    auto random = [&state](int range) {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return int((state * 2685821657736338717ULL) >> 33) % (2 * range + 1) - range;
+    };
+
+    // The ranges keep the accumulators and the hidden layers away from
+    // the limits of the clipped ReLU for most positions.
+    for (auto &bias : featureBiases) bias = random(32);
+    for (auto &weight : featureWeights) weight = random(16);
+    for (auto &bias : biases1) bias = random(1024);
+    for (auto &weight : weights1) weight = random(4);
+    for (auto &bias : biases2) bias = random(1024);
+    for (auto &weight : weights2) weight = random(16);
+    outputBias = random(256);
+    for (auto &weight : outputWeights) weight = random(64);
+
+    ready = true;
+    version++;
+}
+
+void NeuralNetwork::refresh(const ChessBoard &board, Color perspective, NeuralAccumulator &accumulator) const {
+    auto kings = board.pieces[perspective][KING];
+    Square kingSquare = kings > 0 ? lsb(kings) : 0; // No king can happen when testing
+
+    auto values = accumulator.values[perspective];
+    memcpy(values, featureBiases.data(), HalfDimensions * sizeof(int16_t));
+    for (unsigned color=0; color<COUNT; color++) {
+        for (unsigned piece=PAWN; piece<KING; piece++) {
+            Bitboard pieces = board.pieces[color][piece];
+            while (pieces > 0) {
+                Square square = lsb(pieces);
+                bb_clear(pieces, square);
+
+                int index = featureIndex(perspective, kingSquare, Color(color), Piece(piece), square);
+                addWeights(values, &featureWeights[index * HalfDimensions]);
+            }
+        }
+    }
+
+    accumulator.kingSquare[perspective] = kingSquare;
+    accumulator.computed[perspective] = true;
+}
+
+void NeuralNetwork::update(Move move, Color perspective, NeuralAccumulator &accumulator) const {
+    assert(!needsRefresh(move, perspective));
+
+    auto values = accumulator.values[perspective];
+    auto kingSquare = accumulator.kingSquare[perspective];
+    auto color = MOVE_COLOR(move);
+    auto piece = MOVE_PIECE(move);
+    auto from = MOVE_FROM(move);
+    auto to = MOVE_TO(move);
+
+    auto add = [&](Color featureColor, Piece featurePiece, Square square) {
+        addWeights(values, &featureWeights[featureIndex(perspective, kingSquare, featureColor, featurePiece, square) * HalfDimensions]);
+    };
+    auto remove = [&](Color featureColor, Piece featurePiece, Square square) {
+        subtractWeights(values, &featureWeights[featureIndex(perspective, kingSquare, featureColor, featurePiece, square) * HalfDimensions]);
+    };
+
+    if (piece == KING) {
+        // The king of the other perspective is not a feature but castling moves a rook (see ChessBoard::move)
+        if ((from == e1 || from == e8) && (to == from + 2 || to == from - 2)) {
+            if (to > from) {
+                remove(color, ROOK, to + 1);
+                add(color, ROOK, to - 1);
+            } else {
+                remove(color, ROOK, to - 2);
+                add(color, ROOK, to + 1);
+            }
+        }
+    } else {
+        remove(color, piece, from);
+        auto promotionPiece = MOVE_PROMOTION_PIECE(move);
+        add(color, promotionPiece > PAWN ? promotionPiece : piece, to);
+    }
+
+    if (MOVE_IS_ENPASSANT(move)) {
+        remove(INVERSE(color), PAWN, color == WHITE ? to - 8 : to + 8);
+    } else if (MOVE_IS_CAPTURE(move)) {
+        remove(INVERSE(color), MOVE_CAPTURED_PIECE(move), to);
+    }
+
+    accumulator.computed[perspective] = true;
+}
+
+int NeuralNetwork::evaluate(const ChessBoard &board, const NeuralAccumulator &accumulator) const {
+    assert(accumulator.computed[WHITE] && accumulator.computed[BLACK]);
+
+    // The side to move comes first, the network evaluating the position for that side
+    alignas(32) uint8_t input[InputDimensions];
+    Color perspectives[2] = { board.color, INVERSE(board.color) };
+    for (int half=0; half<2; half++) {
+        clipAccumulator(accumulator.values[perspectives[half]], &input[half * HalfDimensions], HalfDimensions);
+    }
+
+    alignas(32) uint8_t hidden1[Hidden1];
+    propagate(input, InputDimensions, weights1.data(), biases1.data(), hidden1, Hidden1);
+
+    alignas(32) uint8_t hidden2[Hidden2];
+    propagate(hidden1, Hidden1, weights2.data(), biases2.data(), hidden2, Hidden2);
+
+    int value = (outputBias + dotProduct(hidden2, outputWeights.data(), Hidden2)) / OutputScale;
+
+    // Note: always evaluate from white's point of view
+    return board.color == WHITE ? value : -value;
+}
+
+int NeuralNetwork::evaluate(const ChessBoard &board) const {
+    NeuralAccumulator accumulator;
+    refresh(board, WHITE, accumulator);
+    refresh(board, BLACK, accumulator);
+    return evaluate(board, accumulator);
+}
+
+const NeuralAccumulator &NeuralAccumulatorStack::accumulator(const NeuralNetwork &network, const ChessBoard &board) {
+    auto &current = accumulators[ply];
+    for (unsigned perspective=0; perspective<COUNT; perspective++) {
+        if (current.computed[perspective]) {
+            continue;
+        }
+
+        // Look for the closest ancestor that is computed, which can only be reused
+        // if the king of the perspective didn't move in-between.
+        int start = ply;
+        while (start > 0 && !accumulators[start].computed[perspective] && !NeuralNetwork::needsRefresh(accumulators[start].move, Color(perspective))) {
+            start--;
+        }
+
+        if (start < ply && accumulators[start].computed[perspective]) {
+            memcpy(current.values[perspective], accumulators[start].values[perspective], sizeof(current.values[perspective]));
+            current.kingSquare[perspective] = accumulators[start].kingSquare[perspective];
+            for (int index=start+1; index<=ply; index++) {
+                network.update(accumulators[index].move, Color(perspective), current);
+            }
+        } else {
+            network.refresh(board, Color(perspective), current);
+        }
+    }
+    return current;
+}
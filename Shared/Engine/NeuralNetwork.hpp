@@ -0,0 +1,155 @@
+//
+//  NeuralNetwork.hpp
+//  BChess
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#pragma once
+
+#include "ChessBoard.hpp"
+
+#include <string>
+#include <vector>
+
+// Efficiently updatable neural network (NNUE) evaluating a position, an alternative
+// to the hand-crafted evaluation of ChessEvaluater when weights are available.
+// https://www.chessprogramming.org/NNUE
+//
+// The input are the HalfKP features: for each side (the perspective), the location of each piece
+// other than the kings relative to the location of the king of that side. The first layer is
+// computed for each perspective in an accumulator which is updated incrementally when a move is
+// played: only the features of the pieces that moved are added or removed, except when the king
+// of that perspective moves, in which case all the features change and the accumulator is refreshed.
+// The accumulators of both perspectives, the side to move first, go through two small dense layers
+// with 8-bit weights and an output layer giving the evaluation.
+//
+// Note: the squares are flipped vertically for the black perspective, which sees its pieces
+// as "own" pieces, so the network evaluates both colors the same way.
+//
+// Note: experimental, not used unless enabled (see ChessEvaluater::neuralEvaluation).
+namespace NNUE {
+    // King square x (5 piece types x 2 colors) x piece square
+    static const int FeatureCount = 64 * 10 * 64;
+
+    static const int HalfDimensions = 128;
+    static const int Hidden1 = 32;
+    static const int Hidden2 = 32;
+
+    // The output of the accumulators and of the hidden layers is clipped to [0, 127] (ReLU)
+    // and the weights of the hidden layers are scaled by 2^WeightScaleBits
+    static const int ActivationMax = 127;
+    static const int WeightScaleBits = 6;
+
+    // The output of the network divided by OutputScale is the evaluation in centipawns
+    static const int OutputScale = 16;
+}
+
+// First layer of the network for both perspectives, for a particular position.
+// Note: not declared with alignas(32) because the accumulators are kept in a std::vector, which
+// doesn't guarantee such an alignment before C++17; the values are accessed with unaligned loads.
+struct NeuralAccumulator {
+    int16_t values[COUNT][NNUE::HalfDimensions];
+
+    bool computed[COUNT] = { false, false };
+
+    // Square of the king of each perspective when the accumulator was computed
+    Square kingSquare[COUNT] = { 0, 0 };
+
+    // Move that led to the position of this accumulator (see NeuralAccumulatorStack)
+    Move move = INVALID_MOVE;
+};
+
+class NeuralNetwork {
+public:
+    // Returns true if the network has weights, either loaded or randomized
+    bool isReady() const {
+        return ready;
+    }
+
+    // Incremented each time the weights change, which invalidates the evaluations already computed
+    int getVersion() const {
+        return version;
+    }
+
+    // Loads the weights from a file created by save(). Returns false, leaving
+    // the network unchanged, if the file cannot be read or has an invalid format.
+    bool load(std::string path);
+    bool save(std::string path);
+
+    // Initializes the weights with pseudo-random values, which don't evaluate
+    // anything useful but can be used to test and benchmark the network.
+    void randomize(uint64_t seed);
+
+    // Computes the accumulator of the specified perspective from all the pieces of the board
+    void refresh(const ChessBoard &board, Color perspective, NeuralAccumulator &accumulator) const;
+
+    // Updates the accumulator of the specified perspective with the pieces changed by the move,
+    // which must not be a move of the king of that perspective (see needsRefresh()).
+    void update(Move move, Color perspective, NeuralAccumulator &accumulator) const;
+
+    // Returns true if the move changes all the features of the perspective
+    static bool needsRefresh(Move move, Color perspective) {
+        return MOVE_PIECE(move) == KING && MOVE_COLOR(move) == perspective;
+    }
+
+    // Returns the evaluation, in centipawns from white's point of view, of the board whose
+    // accumulator has been computed (the second version computes it from scratch).
+    int evaluate(const ChessBoard &board, const NeuralAccumulator &accumulator) const;
+    int evaluate(const ChessBoard &board) const;
+
+private:
+    bool ready = false;
+    int version = 0;
+
+    std::vector<int16_t> featureBiases;
+    std::vector<int16_t> featureWeights; // HalfDimensions weights for each feature
+
+    std::vector<int32_t> biases1;
+    std::vector<int8_t> weights1; // 2 * HalfDimensions weights for each output
+
+    std::vector<int32_t> biases2;
+    std::vector<int8_t> weights2; // Hidden1 weights for each output
+
+    int32_t outputBias = 0;
+    std::vector<int8_t> outputWeights;
+
+    void allocate();
+};
+
+// Accumulators of the line being searched, one for each ply. The accumulator of a node is only computed
+// when the node is evaluated, from the closest ancestor whose accumulator is already computed by applying
+// the moves in-between. Because the search plays the moves on a copy of the board, undoing a move is only
+// a matter of popping its accumulator.
+class NeuralAccumulatorStack {
+    std::vector<NeuralAccumulator> accumulators;
+    int ply = 0;
+
+public:
+    NeuralAccumulatorStack() : accumulators(1) { }
+
+    // Starts a new line from a root position
+    void reset() {
+        ply = 0;
+        accumulators[0].computed[WHITE] = accumulators[0].computed[BLACK] = false;
+    }
+
+    void push(Move move) {
+        ply++;
+        if (ply == (int)accumulators.size()) {
+            accumulators.resize(ply + 1);
+        }
+        auto &accumulator = accumulators[ply];
+        accumulator.move = move;
+        accumulator.computed[WHITE] = accumulator.computed[BLACK] = false;
+    }
+
+    void pop() {
+        assert(ply > 0);
+        ply--;
+    }
+
+    // Returns the accumulator of the current ply, computing it if needed,
+    // the board being the position reached by the moves pushed so far.
+    const NeuralAccumulator &accumulator(const NeuralNetwork &network, const ChessBoard &board);
+};
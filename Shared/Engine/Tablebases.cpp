@@ -0,0 +1,1216 @@
+//
+//  Tablebases.cpp
+//  BChess
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#include "Tablebases.hpp"
+#include "ChessMoveGenerator.hpp"
+#include "Endgames.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// Largest number of pieces of a table, kings included
+static const int MaxTablePieces = 7;
+
+// Largest number of pawns of the same color in a table
+static const int MaxLeadingPawns = 5;
+
+enum TableKind {
+    WDL_TABLE, DTZ_TABLE
+};
+
+// Flags of each section of a file (see Section)
+enum SectionFlag {
+    SIDE_TO_MOVE = 1, DTZ_MAPPED = 2, WIN_IN_PLIES = 4, LOSS_IN_PLIES = 8, DTZ_WIDE = 16, SINGLE_VALUE = 128
+};
+
+#pragma mark - Squares
+
+// Distance of a square from the a1-h8 diagonal: negative below it, zero on it and positive above it
+inline static int diagonalOffset(Square square) {
+    return int(RankFrom(square)) - int(FileFrom(square));
+}
+
+inline static Square mirrorFiles(Square square) {
+    return Square(square ^ 7);
+}
+
+inline static Square mirrorRanks(Square square) {
+    return Square(square ^ 56);
+}
+
+inline static Square mirrorDiagonal(Square square) {
+    return Square(((square >> 3) | (square << 3)) & 63);
+}
+
+// Code of a pawn square, from 47 for a2 down to 0 for e7: the files are taken from the edges
+// (a and h, then b and g...), each one from its second rank, the file a before the file h.
+inline static int pawnCode(Square square) {
+    int file = FileFrom(square);
+    int edgeDistance = std::min(file, 7 - file);
+    return 47 - 12 * edgeDistance - 2 * (RankFrom(square) - 1) - (file > 3 ? 1 : 0);
+}
+
+// Squares of the a1-d1-d4 triangle in the order of their code, the ones on the diagonal last
+static const Square TriangleSquares[10] = { b1, c1, d1, c2, d2, d3, a1, b2, c3, d4 };
+
+// Codes of the squares and of the combinations of squares used to index the positions
+class SquareCodes {
+public:
+    SquareCodes();
+
+    // Number of ways to choose k squares among n squares
+    uint64_t choose(int n, int k) const {
+        return n >= 0 && n < 64 && k >= 0 && k <= MaxTablePieces ? binomial[n][k] : 0;
+    }
+
+    // Code of a square of the triangle, from 0 to 9
+    int triangle[64] = { };
+
+    // Code of a square below the diagonal, from 0 to 27
+    int belowDiagonal[64] = { };
+
+    // Code of the 462 placements of the two kings for each code of the first one in the triangle
+    int kings[10][64] = { };
+
+    // First code of the placements of the leading pawns for their count and the square of the pawn with
+    // the largest code, and their number of placements for each file of that pawn (a to d).
+    uint64_t leadingPawns[MaxLeadingPawns + 1][64] = { };
+    uint64_t leadingPawnsPerFile[MaxLeadingPawns + 1][4] = { };
+
+private:
+    uint64_t binomial[64][MaxTablePieces + 1] = { };
+};
+
+SquareCodes::SquareCodes() {
+    for (int n=0; n<64; n++) {
+        binomial[n][0] = 1;
+        for (int k=1; k<=MaxTablePieces && n > 0; k++) {
+            binomial[n][k] = binomial[n - 1][k - 1] + binomial[n - 1][k];
+        }
+    }
+
+    int code = 0;
+    for (Square square=0; square<64; square++) {
+        if (diagonalOffset(square) < 0) {
+            belowDiagonal[square] = code++;
+        }
+    }
+
+    for (int index=0; index<10; index++) {
+        triangle[TriangleSquares[index]] = index;
+    }
+
+    // The second king is on any square not next to the first one, but not above the diagonal when the
+    // first one is on it. The placements with both kings on the diagonal come after all the others.
+    code = 0;
+    std::vector<std::pair<int, Square>> diagonalPlacements;
+    for (int index=0; index<10; index++) {
+        Square first = TriangleSquares[index];
+        for (Square second=0; second<64; second++) {
+            if (second == first || bb_test(KingMoves[first], second)) {
+                continue;
+            }
+            if (diagonalOffset(first) == 0) {
+                if (diagonalOffset(second) > 0) {
+                    continue;
+                }
+                if (diagonalOffset(second) == 0) {
+                    diagonalPlacements.push_back({ index, second });
+                    continue;
+                }
+            }
+            kings[index][second] = code++;
+        }
+    }
+    for (auto placement : diagonalPlacements) {
+        kings[placement.first][placement.second] = code++;
+    }
+
+    // The placements of the leading pawns are ordered by the square of the pawn with the largest code,
+    // rank by rank: the other leading pawns are any combination of the squares with a lower code.
+    for (int count=1; count<=MaxLeadingPawns; count++) {
+        for (File file=0; file<4; file++) {
+            uint64_t placements = 0;
+            for (Rank rank=1; rank<7; rank++) {
+                Square square = SquareFrom(file, rank);
+                leadingPawns[count][square] = placements;
+                placements += choose(pawnCode(square), count - 1);
+            }
+            leadingPawnsPerFile[count][file] = placements;
+        }
+    }
+}
+
+static const SquareCodes Codes;
+
+#pragma mark - Reading
+
+inline static uint16_t readUInt16(const uint8_t *bytes) {
+    return uint16_t(bytes[0] | (bytes[1] << 8));
+}
+
+inline static uint32_t readUInt32(const uint8_t *bytes) {
+    return uint32_t(readUInt16(bytes)) | (uint32_t(readUInt16(bytes + 2)) << 16);
+}
+
+// The compressed values are read as big-endian numbers, the first value being in the most significant bits
+inline static uint64_t readBigEndian(const uint8_t *bytes, int count) {
+    uint64_t value = 0;
+    for (int index=0; index<count; index++) {
+        value = (value << 8) | bytes[index];
+    }
+    return value;
+}
+
+// Reads the header of a file, which is little-endian, checking the bounds of the file
+class FileReader {
+public:
+    FileReader(const uint8_t *bytes, size_t size) : bytes(bytes), size(size) { }
+
+    bool isValid() const {
+        return offset <= size;
+    }
+
+    // Returns the address of the next bytes and skips them (nullptr if they are outside of the file)
+    const uint8_t *skip(uint64_t count) {
+        if (offset > size || count > size - offset) {
+            offset = size + 1;
+            return nullptr;
+        }
+        auto address = bytes + offset;
+        offset += size_t(count);
+        return address;
+    }
+
+    uint8_t readByte() {
+        auto address = skip(1);
+        return address ? *address : 0;
+    }
+
+    uint16_t readShort() {
+        auto address = skip(2);
+        return address ? readUInt16(address) : 0;
+    }
+
+    uint32_t readInt() {
+        auto address = skip(4);
+        return address ? readUInt32(address) : 0;
+    }
+
+    void align(size_t alignment) {
+        skip((alignment - offset % alignment) % alignment);
+    }
+
+private:
+    const uint8_t *bytes;
+    size_t size;
+    size_t offset = 0;
+};
+
+// Reads a block of compressed values, bit by bit
+class BitReader {
+public:
+    BitReader(const uint8_t *bytes) : next(bytes + 8), bits(readBigEndian(bytes, 8)) { }
+
+    // Next 64 bits, the first one being the most significant
+    uint64_t peek() const {
+        return bits;
+    }
+
+    void consume(int count) {
+        bits <<= count;
+        available -= count;
+        if (available <= 32) {
+            bits |= readBigEndian(next, 4) << (32 - available);
+            next += 4;
+            available += 32;
+        }
+    }
+
+private:
+    const uint8_t *next;
+    uint64_t bits;
+    int available = 64;
+};
+
+#pragma mark - Sections
+
+struct TableFile;
+
+// A file stores its values in sections: one for each side to move (in a WDL table whose colors don't have
+// the same pieces) and one for each file of the leading pawn (in a table with pawns).
+//
+// The values are compressed in two steps: the most frequent pair of symbols is replaced with a new symbol
+// until the pairs are rare enough (Re-Pair), then the symbols are stored with a canonical Huffman code
+// in blocks of a fixed size. A sparse index gives the block of every span-th value.
+// https://en.wikipedia.org/wiki/Canonical_Huffman_code
+class Section {
+public:
+    // Pieces in the order of the index, with their color (8 for black) and kind (1 for a pawn to 6 for a king),
+    // split in groups of pieces whose squares are encoded together.
+    uint8_t pieces[MaxTablePieces] = { };
+    int groupCount = 0;
+    int groupLength[MaxTablePieces] = { };
+
+    // Multiplier of the code of each group in the index, and number of positions of the section
+    uint64_t groupFactor[MaxTablePieces] = { };
+    uint64_t positions = 0;
+
+    uint8_t flags = 0;
+
+    // DTZ values of each outcome (win, loss, cursed win, blessed loss), when the DTZ values are mapped
+    const uint8_t *dtzValues[4] = { };
+
+    // Parts of the file read for each section, after the DTZ values
+    enum Part {
+        SPARSE_INDEX, BLOCK_SIZES, BLOCKS
+    };
+
+    bool readGroups(const TableFile &table, int leadingOrder, int pawnsOrder, int file);
+    bool readCompression(FileReader &reader);
+    void readDTZValues(FileReader &reader);
+    bool readPart(FileReader &reader, Part part);
+
+    // Returns the value stored at the index
+    int value(uint64_t index) const;
+
+private:
+    int singleValue = 0;
+
+    size_t blockSize = 0;
+    uint64_t span = 0;
+    uint32_t blockCount = 0;
+    uint32_t storedBlockCount = 0;
+
+    // Lowest symbol of the codes of each length, from the shortest one, and the first code of each length
+    // aligned on the most significant bit. The longer codes have lower values.
+    int shortestCode = 0;
+    const uint8_t *lowestSymbols = nullptr;
+    std::vector<uint64_t> firstCodes;
+
+    // Two symbols of 12 bits for each symbol: the symbols it replaces, or its value followed by 0xFFF.
+    const uint8_t *symbols = nullptr;
+    std::vector<int> symbolValueCount;
+
+    // Block and offset in that block (6 bytes) of the value at the middle of each span
+    const uint8_t *sparseIndex = nullptr;
+
+    // Number of values of each block, minus one
+    const uint8_t *blockValueCounts = nullptr;
+
+    const uint8_t *blocks = nullptr;
+
+    int leftSymbol(int symbol) const {
+        auto bytes = symbols + 3 * symbol;
+        return bytes[0] | ((bytes[1] & 0xF) << 8);
+    }
+
+    int rightSymbol(int symbol) const {
+        auto bytes = symbols + 3 * symbol;
+        return (bytes[1] >> 4) | (bytes[2] << 4);
+    }
+
+    int countSymbolValues(int symbol);
+
+    int64_t blockValues(uint32_t block) const {
+        return int64_t(readUInt16(blockValueCounts + 2 * size_t(block))) + 1;
+    }
+};
+
+#pragma mark - Files
+
+struct TableFile {
+    TableKind kind;
+    std::string path;
+
+    // Material with the stronger side, the first one in the name, being white (or black)
+    MaterialKey key = 0;
+    MaterialKey mirroredKey = 0;
+
+    int pieceCount = 0;
+    bool hasPawns = false;
+    bool pawnsOnBothSides = false;
+
+    // True if a piece, other than a king, is the only one of its kind and color
+    bool hasUniquePiece = false;
+
+    TableFile(TableKind kind, std::string path, MaterialKey key, MaterialKey mirroredKey);
+    ~TableFile();
+
+    // True if both colors have the same pieces
+    bool isSymmetric() const {
+        return key == mirroredKey;
+    }
+
+    // Maps the file the first time it is probed. Returns false if the file is missing or invalid.
+    bool open();
+
+    Section &section(int side, int file) {
+        return sections[kind == WDL_TABLE ? side : 0][hasPawns ? file : 0];
+    }
+
+private:
+    Section sections[COUNT][4];
+
+    std::once_flag opening;
+    bool valid = false;
+
+    void *address = nullptr;
+    size_t size = 0;
+
+    bool read(const uint8_t *bytes);
+};
+
+TableFile::TableFile(TableKind kind, std::string path, MaterialKey key, MaterialKey mirroredKey) :
+    kind(kind), path(path), key(key), mirroredKey(mirroredKey) {
+    for (Piece piece=PAWN; piece<PCOUNT; piece=Piece(piece + 1)) {
+        for (Color color : { WHITE, BLACK }) {
+            int count = int(MATERIAL_COUNT(key, color, piece));
+            pieceCount += count;
+            if (piece != KING && count == 1) {
+                hasUniquePiece = true;
+            }
+        }
+    }
+    hasPawns = MATERIAL_COUNT(key, WHITE, PAWN) + MATERIAL_COUNT(key, BLACK, PAWN) > 0;
+    pawnsOnBothSides = MATERIAL_COUNT(key, WHITE, PAWN) > 0 && MATERIAL_COUNT(key, BLACK, PAWN) > 0;
+}
+
+TableFile::~TableFile() {
+    if (address) {
+        munmap(address, size);
+    }
+}
+
+bool TableFile::open() {
+    std::call_once(opening, [this]() {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            return;
+        }
+        struct stat status;
+        // The size of a valid file is always a multiple of 64 bytes plus 16 bytes
+        if (fstat(fd, &status) == 0 && status.st_size % 64 == 16) {
+            auto mapping = mmap(nullptr, size_t(status.st_size), PROT_READ, MAP_SHARED, fd, 0);
+            if (mapping != MAP_FAILED) {
+                // The positions are probed in any order, reading ahead would be useless
+                madvise(mapping, size_t(status.st_size), MADV_RANDOM);
+                address = mapping;
+                size = size_t(status.st_size);
+                valid = read((const uint8_t *)address);
+            }
+        }
+        close(fd);
+    });
+    return valid;
+}
+
+// The header of a file describes the sections, then come their compression parameters,
+// the DTZ values (DTZ tables only), the sparse indexes, the size of the blocks and the blocks.
+bool TableFile::read(const uint8_t *bytes) {
+    static const uint8_t Signatures[2][4] = {
+        { 0x71, 0xE8, 0x23, 0x5D }, // WDL
+        { 0xD7, 0x66, 0x0C, 0xA5 }  // DTZ
+    };
+
+    FileReader reader(bytes, size);
+    auto signature = reader.skip(4);
+    if (!signature || memcmp(signature, Signatures[kind], 4) != 0) {
+        return false;
+    }
+
+    enum { SPLIT = 1, PAWNS = 2 };
+    auto layout = reader.readByte();
+    if (bool(layout & SPLIT) == isSymmetric() || bool(layout & PAWNS) != hasPawns) {
+        return false;
+    }
+
+    int sides = kind == WDL_TABLE && !isSymmetric() ? 2 : 1;
+    int files = hasPawns ? 4 : 1;
+
+    // The order of the groups and the pieces of each section, one nibble for each side to move
+    for (int file=0; file<files; file++) {
+        auto leadingOrder = reader.readByte();
+        auto pawnsOrder = pawnsOnBothSides ? reader.readByte() : 0xFF;
+        auto pieces = reader.skip(uint64_t(pieceCount));
+        if (!pieces) {
+            return false;
+        }
+        for (int side=0; side<sides; side++) {
+            int shift = 4 * side;
+            auto &section = this->section(side, file);
+            MaterialKey material = 0;
+            for (int index=0; index<pieceCount; index++) {
+                uint8_t piece = (pieces[index] >> shift) & 0xF;
+                if ((piece & 7) < 1 || (piece & 7) > 6) {
+                    return false;
+                }
+                section.pieces[index] = piece;
+                material += MATERIAL_KEY(Color(piece >> 3), Piece((piece & 7) - 1));
+            }
+            if (material != key || !section.readGroups(*this, (leadingOrder >> shift) & 0xF, (pawnsOrder >> shift) & 0xF, file)) {
+                return false;
+            }
+        }
+    }
+    reader.align(2);
+
+    for (int file=0; file<files; file++) {
+        for (int side=0; side<sides; side++) {
+            if (!section(side, file).readCompression(reader)) {
+                return false;
+            }
+        }
+    }
+
+    if (kind == DTZ_TABLE) {
+        for (int file=0; file<files; file++) {
+            section(0, file).readDTZValues(reader);
+        }
+        reader.align(2);
+    }
+
+    for (auto part : { Section::SPARSE_INDEX, Section::BLOCK_SIZES, Section::BLOCKS }) {
+        for (int file=0; file<files; file++) {
+            for (int side=0; side<sides; side++) {
+                if (!section(side, file).readPart(reader, part)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return reader.isValid();
+}
+
+// The first group has the leading pawns (the pawns of one color) or, without pawns, three unique
+// pieces (or only the kings). The next groups have the pawns of the other color and then the pieces
+// of the same kind. The orders tell where the leading pawns and the other pawns are in the index.
+bool Section::readGroups(const TableFile &table, int leadingOrder, int pawnsOrder, int file) {
+    int firstLength = 1;
+    if (table.hasPawns) {
+        if ((pieces[0] & 7) != 1) {
+            return false;
+        }
+        while (firstLength < table.pieceCount && pieces[firstLength] == pieces[0]) {
+            firstLength++;
+        }
+        if (firstLength > MaxLeadingPawns) {
+            return false;
+        }
+    } else {
+        firstLength = table.hasUniquePiece ? 3 : 2;
+    }
+
+    groupCount = 0;
+    groupLength[groupCount++] = firstLength;
+    for (int index=firstLength; index<table.pieceCount; index += groupLength[groupCount++]) {
+        groupLength[groupCount] = 1;
+        while (index + groupLength[groupCount] < table.pieceCount && pieces[index + groupLength[groupCount]] == pieces[index]) {
+            groupLength[groupCount]++;
+        }
+    }
+
+    // Number of placements of each group, the squares taken by the groups before being skipped
+    uint64_t placements[MaxTablePieces];
+    if (table.hasPawns) {
+        placements[0] = Codes.leadingPawnsPerFile[firstLength][file];
+    } else {
+        placements[0] = table.hasUniquePiece ? 31332 : 462;
+    }
+    int group = 1;
+    int freeSquares = 64 - firstLength;
+    if (table.pawnsOnBothSides) {
+        if (groupCount < 2) {
+            return false;
+        }
+        placements[group] = Codes.choose(48 - firstLength, groupLength[group]);
+        freeSquares -= groupLength[group++];
+    }
+    for (; group<groupCount; group++) {
+        placements[group] = Codes.choose(freeSquares, groupLength[group]);
+        freeSquares -= groupLength[group];
+    }
+
+    // Group at each position of the index, the leading pawns and the other pawns being at the position
+    // given by the file and the other groups filling the remaining positions in their order.
+    int order[MaxTablePieces];
+    std::fill(order, order + groupCount, -1);
+    if (leadingOrder >= groupCount) {
+        return false;
+    }
+    order[leadingOrder] = 0;
+    int nextGroup = 1;
+    if (table.pawnsOnBothSides) {
+        if (pawnsOrder >= groupCount || pawnsOrder == leadingOrder) {
+            return false;
+        }
+        order[pawnsOrder] = nextGroup++;
+    }
+    for (int position=0; position<groupCount; position++) {
+        if (order[position] == -1) {
+            order[position] = nextGroup++;
+        }
+    }
+
+    positions = 1;
+    for (int position=0; position<groupCount; position++) {
+        groupFactor[order[position]] = positions;
+        positions *= placements[order[position]];
+    }
+    return true;
+}
+
+bool Section::readCompression(FileReader &reader) {
+    flags = reader.readByte();
+    if (flags & SINGLE_VALUE) {
+        // All the positions have the same value
+        singleValue = reader.readByte();
+        return reader.isValid();
+    }
+
+    int blockSizeBits = reader.readByte();
+    int spanBits = reader.readByte();
+    int padding = reader.readByte();
+    blockCount = reader.readInt();
+    storedBlockCount = blockCount + uint32_t(padding);
+    int longestCode = reader.readByte();
+    shortestCode = reader.readByte();
+    if (blockSizeBits > 31 || spanBits > 31 || shortestCode < 1 || longestCode < shortestCode || longestCode > 64) {
+        return false;
+    }
+    blockSize = size_t(1) << blockSizeBits;
+    span = uint64_t(1) << spanBits;
+
+    int lengthCount = longestCode - shortestCode + 1;
+    lowestSymbols = reader.skip(2 * uint64_t(lengthCount));
+    int symbolCount = reader.readShort();
+    symbols = reader.skip(3 * uint64_t(symbolCount) + uint64_t(symbolCount & 1));
+    if (!reader.isValid()) {
+        return false;
+    }
+
+    // The codes of one length are consecutive: the first code of a length is half the value
+    // following the last code of the next length.
+    firstCodes.assign(size_t(lengthCount), 0);
+    for (int length=lengthCount-2; length>=0; length--) {
+        uint64_t longerCodes = uint64_t(readUInt16(lowestSymbols + 2 * length)) - readUInt16(lowestSymbols + 2 * (length + 1));
+        firstCodes[length] = (firstCodes[length + 1] + longerCodes) / 2;
+    }
+    for (int length=0; length<lengthCount; length++) {
+        firstCodes[length] <<= 64 - (shortestCode + length);
+    }
+
+    symbolValueCount.assign(size_t(symbolCount), -1);
+    for (int symbol=0; symbol<symbolCount; symbol++) {
+        if (countSymbolValues(symbol) < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Computes the number of values (minus one) a symbol stands for. Returns -1 if a symbol is invalid.
+int Section::countSymbolValues(int symbol) {
+    if (symbol >= int(symbolValueCount.size())) {
+        return -1;
+    }
+    if (symbolValueCount[symbol] >= 0) {
+        return symbolValueCount[symbol];
+    }
+
+    // A symbol cannot stand for itself: seen again before being computed, it counts for one value
+    symbolValueCount[symbol] = 0;
+    if (rightSymbol(symbol) != 0xFFF) {
+        int left = countSymbolValues(leftSymbol(symbol));
+        int right = countSymbolValues(rightSymbol(symbol));
+        if (left < 0 || right < 0) {
+            return -1;
+        }
+        symbolValueCount[symbol] = left + right + 1;
+    }
+    return symbolValueCount[symbol];
+}
+
+// The DTZ values of each outcome are mapped to the range of the values stored when it is shorter
+void Section::readDTZValues(FileReader &reader) {
+    if (!(flags & DTZ_MAPPED)) {
+        return;
+    }
+    bool wide = flags & DTZ_WIDE;
+    if (wide) {
+        reader.align(2);
+    }
+    for (int outcome=0; outcome<4; outcome++) {
+        int count = wide ? reader.readShort() : reader.readByte();
+        dtzValues[outcome] = reader.skip(uint64_t(count) * (wide ? 2 : 1));
+    }
+}
+
+// Reads a part of the section: the sparse index, the number of values of each block or the blocks,
+// which are aligned on 64 bytes. A section with a single value has none of them.
+bool Section::readPart(FileReader &reader, Part part) {
+    if (flags & SINGLE_VALUE) {
+        return true;
+    }
+    switch (part) {
+        case SPARSE_INDEX:
+            sparseIndex = reader.skip(6 * ((positions + span - 1) / span));
+            return sparseIndex != nullptr;
+        case BLOCK_SIZES:
+            blockValueCounts = reader.skip(2 * uint64_t(storedBlockCount));
+            return blockValueCounts != nullptr;
+        case BLOCKS:
+            reader.align(64);
+            blocks = reader.skip(uint64_t(blockCount) * blockSize);
+            return blocks != nullptr;
+    }
+    return false;
+}
+
+int Section::value(uint64_t index) const {
+    if (flags & SINGLE_VALUE) {
+        return singleValue;
+    }
+
+    // Find the block of the value from the closest value of the sparse index
+    auto entry = sparseIndex + 6 * (index / span);
+    uint32_t block = readUInt32(entry);
+    int64_t offset = int64_t(readUInt16(entry + 4)) + int64_t(index % span) - int64_t(span / 2);
+    while (offset < 0) {
+        offset += blockValues(--block);
+    }
+    while (offset >= blockValues(block)) {
+        offset -= blockValues(block++);
+    }
+
+    // Decode the symbols of the block until the one standing for the value
+    BitReader reader(blocks + size_t(block) * blockSize);
+    int symbol;
+    while (true) {
+        auto bits = reader.peek();
+        int length = 0;
+        while (bits < firstCodes[length]) {
+            length++;
+        }
+        symbol = readUInt16(lowestSymbols + 2 * length) + int((bits - firstCodes[length]) >> (64 - shortestCode - length));
+        if (offset <= symbolValueCount[symbol]) {
+            break;
+        }
+        offset -= symbolValueCount[symbol] + 1;
+        reader.consume(shortestCode + length);
+    }
+
+    // Then the pairs it replaces, down to the value
+    while (symbolValueCount[symbol] > 0) {
+        int left = leftSymbol(symbol);
+        if (offset <= symbolValueCount[left]) {
+            symbol = left;
+        } else {
+            offset -= symbolValueCount[left] + 1;
+            symbol = rightSymbol(symbol);
+        }
+    }
+    return leftSymbol(symbol);
+}
+
+#pragma mark - Tables
+
+struct TablePair {
+    TableFile *wdl = nullptr;
+    TableFile *dtz = nullptr;
+};
+
+static std::vector<std::unique_ptr<TableFile>> Files;
+static std::map<MaterialKey, TablePair> TablesByMaterial;
+static int MaxPiecesLoaded = 0;
+
+// The material of a table from its name, like KRPvKR, the pieces of white being before the 'v'.
+// Returns false if the name isn't the one of a table.
+static bool parseTableName(std::string name, MaterialKey &key, MaterialKey &mirroredKey) {
+    auto separator = name.find('v');
+    if (separator == std::string::npos || name.find('K', 1) != separator + 1) {
+        return false;
+    }
+    auto white = name.substr(0, separator);
+    auto black = name.substr(separator + 1);
+    key = Endgames::materialKey(white + black);
+    mirroredKey = Endgames::materialKey(black + white);
+    return key != 0 && mirroredKey != 0;
+}
+
+// Outcome of a lookup in a table
+enum class Lookup {
+    FAILED, FOUND,
+    // The DTZ table only stores the positions with the other side to move
+    OTHER_SIDE
+};
+
+// Index of the first group of pieces: the leading pawns, the three unique pieces or the kings
+static uint64_t leadingGroupIndex(TableFile &table, Section &section, Square squares[]) {
+    if (table.hasPawns) {
+        // The pawn with the largest code is first, the others being a combination of the lower codes
+        int count = section.groupLength[0];
+        std::sort(squares + 1, squares + count, [](Square a, Square b) {
+            return pawnCode(a) < pawnCode(b);
+        });
+        uint64_t index = Codes.leadingPawns[count][squares[0]];
+        for (int i=1; i<count; i++) {
+            index += Codes.choose(pawnCode(squares[i]), i);
+        }
+        return index;
+    }
+
+    Square first = squares[0];
+    Square second = squares[1];
+    if (!table.hasUniquePiece) {
+        return uint64_t(Codes.kings[Codes.triangle[first]][second]);
+    }
+
+    // The three unique pieces: the first one in the triangle, the second one, then the third one skipping
+    // the squares taken. When the first pieces are on the diagonal, the next one is not above it.
+    Square third = squares[2];
+    int secondSkip = second > first;
+    int thirdSkip = (third > first) + (third > second);
+    static const uint64_t FirstOffDiagonal = 6 * 63 * 62;
+    static const uint64_t SecondOffDiagonal = 4 * 28 * 62;
+    static const uint64_t ThirdOffDiagonal = 4 * 7 * 28;
+    if (diagonalOffset(first) != 0) {
+        return (uint64_t(Codes.triangle[first]) * 63 + (second - secondSkip)) * 62 + (third - thirdSkip);
+    }
+    if (diagonalOffset(second) != 0) {
+        return FirstOffDiagonal
+            + (uint64_t(RankFrom(first)) * 28 + Codes.belowDiagonal[second]) * 62 + (third - thirdSkip);
+    }
+    if (diagonalOffset(third) != 0) {
+        return FirstOffDiagonal + SecondOffDiagonal
+            + (uint64_t(RankFrom(first)) * 7 + (RankFrom(second) - secondSkip)) * 28 + Codes.belowDiagonal[third];
+    }
+    return FirstOffDiagonal + SecondOffDiagonal + ThirdOffDiagonal
+        + (uint64_t(RankFrom(first)) * 7 + (RankFrom(second) - secondSkip)) * 6 + (RankFrom(third) - thirdSkip);
+}
+
+// Reads the value of the position in a table: the WDL value, or the DTZ value of the outcome in plies
+static Lookup readTable(ChessBoard &board, TableKind kind, Tablebases::WDL wdl, int &value) {
+    auto material = board.getMaterialKey();
+    auto entry = TablesByMaterial.find(material);
+    if (entry == TablesByMaterial.end()) {
+        return Lookup::FAILED;
+    }
+    auto table = kind == WDL_TABLE ? entry->second.wdl : entry->second.dtz;
+    if (!table || !table->open()) {
+        return Lookup::FAILED;
+    }
+
+    // The stronger side of the table is white: the colors are swapped, and the board flipped vertically,
+    // when black is the stronger side, or when both sides have the same pieces and black is to move.
+    bool swapColors = material != table->key || (table->isSymmetric() && board.color == BLACK);
+    int side = int(board.color == BLACK) ^ int(swapColors);
+    auto boardSquare = [&](Square square) {
+        return swapColors ? mirrorRanks(square) : square;
+    };
+
+    // The tables with pawns have a section for each file (a to d) of the leading pawn, the one closest
+    // to the edge of the board and, on that file, to its first rank.
+    int file = 0;
+    Square leadingPawn = 0;
+    if (table->hasPawns) {
+        Color color = Color((table->section(0, 0).pieces[0] >> 3) ^ int(swapColors));
+        int largestCode = -1;
+        for (Bitboard pawns = board.pieces[color][PAWN]; pawns; pawns &= pawns - 1) {
+            Square square = boardSquare(lsb(pawns));
+            if (pawnCode(square) > largestCode) {
+                largestCode = pawnCode(square);
+                leadingPawn = square;
+            }
+        }
+        file = std::min(int(FileFrom(leadingPawn)), 7 - int(FileFrom(leadingPawn)));
+    }
+
+    auto &section = table->section(side, file);
+    if (kind == DTZ_TABLE && (section.flags & SIDE_TO_MOVE) != side && !(table->isSymmetric() && !table->hasPawns)) {
+        return Lookup::OTHER_SIDE;
+    }
+
+    // The squares of the pieces in the order of the section, the leading pawn first
+    Square squares[MaxTablePieces];
+    Bitboard remaining[COUNT][PCOUNT];
+    memcpy(remaining, board.pieces, sizeof(remaining));
+    for (int index=0; index<table->pieceCount; index++) {
+        auto piece = section.pieces[index];
+        auto &bitboard = remaining[(piece >> 3) ^ int(swapColors)][(piece & 7) - 1];
+        squares[index] = boardSquare(lsb(bitboard));
+        bitboard &= bitboard - 1;
+        if (table->hasPawns && squares[index] == leadingPawn) {
+            std::swap(squares[0], squares[index]);
+        }
+    }
+
+    // Use the symmetries of the board: the first piece goes to the files a to d and, without pawns, to the
+    // a1-d1-d4 triangle, the first piece of its group off the diagonal being below it.
+    auto transform = [&](Square (*symmetry)(Square)) {
+        for (int index=0; index<table->pieceCount; index++) {
+            squares[index] = symmetry(squares[index]);
+        }
+    };
+    if (FileFrom(squares[0]) > 3) {
+        transform(mirrorFiles);
+    }
+    if (!table->hasPawns) {
+        if (RankFrom(squares[0]) > 3) {
+            transform(mirrorRanks);
+        }
+        for (int index=0; index<section.groupLength[0]; index++) {
+            if (diagonalOffset(squares[index]) != 0) {
+                if (diagonalOffset(squares[index]) > 0) {
+                    transform(mirrorDiagonal);
+                }
+                break;
+            }
+        }
+    }
+
+    uint64_t index = leadingGroupIndex(*table, section, squares) * section.groupFactor[0];
+
+    // Each other group is a combination of the squares not taken by the groups before it
+    // (and, for the pawns of the other color, of the squares of the ranks 2 to 7).
+    int start = section.groupLength[0];
+    for (int group=1; group<section.groupCount; group++) {
+        int length = section.groupLength[group];
+        std::sort(squares + start, squares + start + length);
+        int excluded = group == 1 && table->pawnsOnBothSides ? 8 : 0;
+        uint64_t combination = 0;
+        for (int i=0; i<length; i++) {
+            Square square = squares[start + i];
+            int taken = int(std::count_if(squares, squares + start, [square](Square other) {
+                return other < square;
+            }));
+            combination += Codes.choose(square - taken - excluded, i + 1);
+        }
+        index += combination * section.groupFactor[group];
+        start += length;
+    }
+
+    value = section.value(index);
+    if (kind == WDL_TABLE) {
+        value -= 2;
+        return Lookup::FOUND;
+    }
+
+    if (section.flags & DTZ_MAPPED) {
+        int outcome = wdl == Tablebases::WIN ? 0 : wdl == Tablebases::LOSS ? 1 : wdl == Tablebases::CURSED_WIN ? 2 : 3;
+        auto values = section.dtzValues[outcome];
+        value = section.flags & DTZ_WIDE ? readUInt16(values + 2 * value) : values[value];
+    }
+
+    // The distance is stored in moves, unless the flags tell it is in plies
+    bool inPlies = (wdl == Tablebases::WIN && (section.flags & WIN_IN_PLIES)) ||
+                   (wdl == Tablebases::LOSS && (section.flags & LOSS_IN_PLIES));
+    value = (inPlies ? value : 2 * value) + 1;
+    return Lookup::FOUND;
+}
+
+#pragma mark - Probing
+
+inline static int sign(int value) {
+    return (value > 0) - (value < 0);
+}
+
+// DTZ of a position whose best move is a capture or a pawn move reaching the outcome
+static int zeroingMoveDTZ(Tablebases::WDL wdl) {
+    switch (wdl) {
+        case Tablebases::WIN:
+            return 1;
+        case Tablebases::CURSED_WIN:
+            return 101;
+        case Tablebases::BLESSED_LOSS:
+            return -101;
+        case Tablebases::LOSS:
+            return -1;
+        default:
+            return 0;
+    }
+}
+
+struct Outcome {
+    Tablebases::WDL wdl;
+
+    // True if the outcome is reached by a capture or a pawn move: its DTZ is then known without the DTZ table
+    bool byZeroingMove;
+};
+
+// The tables don't store the value of the positions where the best move is a capture (or, in the DTZ tables,
+// a pawn move): any value that compresses better is stored instead. These moves are searched first and the
+// table is only read if none of them is the best move.
+static bool searchOutcome(ChessBoard &board, bool pawnMoves, Outcome &outcome) {
+    if (bb_count(board.getOccupancy()) == 2) {
+        outcome = { Tablebases::DRAW, false }; // Only the kings
+        return true;
+    }
+
+    auto best = Tablebases::LOSS;
+    int searched = 0;
+    auto moves = ChessMoveGenerator::generateMoves(board);
+    for (int index=0; index<moves.count; index++) {
+        auto move = moves[index];
+        if (!MOVE_IS_CAPTURE(move) && !(pawnMoves && MOVE_PIECE(move) == PAWN)) {
+            continue;
+        }
+        searched++;
+
+        auto newBoard = board;
+        newBoard.move(move);
+        Outcome reply;
+        if (!searchOutcome(newBoard, false, reply)) {
+            return false;
+        }
+        best = std::max(best, Tablebases::WDL(-reply.wdl));
+        if (best == Tablebases::WIN) {
+            outcome = { best, true };
+            return true;
+        }
+    }
+
+    // The table doesn't know about en-passant: it cannot be trusted when all the moves have been searched
+    if (searched > 0 && searched == moves.count) {
+        outcome = { best, true };
+        return true;
+    }
+
+    int stored;
+    if (readTable(board, WDL_TABLE, Tablebases::DRAW, stored) != Lookup::FOUND) {
+        return false;
+    }
+    if (best >= stored) {
+        outcome = { best, best > Tablebases::DRAW };
+    } else {
+        outcome = { Tablebases::WDL(stored), false };
+    }
+    return true;
+}
+
+static bool searchDTZ(ChessBoard &board, int &dtz) {
+    Outcome outcome;
+    if (!searchOutcome(board, true, outcome)) {
+        return false;
+    }
+    if (outcome.wdl == Tablebases::DRAW || outcome.byZeroingMove) {
+        dtz = zeroingMoveDTZ(outcome.wdl);
+        return true;
+    }
+
+    int stored;
+    auto lookup = readTable(board, DTZ_TABLE, outcome.wdl, stored);
+    if (lookup == Lookup::FAILED) {
+        return false;
+    }
+    if (lookup == Lookup::FOUND) {
+        bool cursed = outcome.wdl == Tablebases::CURSED_WIN || outcome.wdl == Tablebases::BLESSED_LOSS;
+        dtz = (stored + (cursed ? 100 : 0)) * sign(outcome.wdl);
+        return true;
+    }
+
+    // The table only stores the other side to move: the DTZ is the best one of the moves, plus one ply
+    int best = 0xFFFF;
+    auto moves = ChessMoveGenerator::generateMoves(board);
+    for (int index=0; index<moves.count; index++) {
+        auto move = moves[index];
+        bool zeroing = MOVE_IS_CAPTURE(move) || MOVE_PIECE(move) == PAWN;
+
+        auto newBoard = board;
+        newBoard.move(move);
+
+        int value;
+        if (zeroing) {
+            // The DTZ before the move, with the outcome of the position after the move
+            Outcome reply;
+            if (!searchOutcome(newBoard, false, reply)) {
+                return false;
+            }
+            value = -zeroingMoveDTZ(reply.wdl);
+        } else {
+            if (!searchDTZ(newBoard, value)) {
+                return false;
+            }
+            value = -value;
+        }
+
+        if (value == 1 && newBoard.isCheck(newBoard.color) && ChessMoveGenerator::generateMoves(newBoard).count == 0) {
+            best = 1; // Mate
+        }
+        if (!zeroing) {
+            value += sign(value);
+        }
+        if (value < best && sign(value) == sign(outcome.wdl)) {
+            best = value;
+        }
+    }
+
+    // Without any legal move, the side to move is mated
+    dtz = best == 0xFFFF ? -1 : best;
+    return true;
+}
+
+} // namespace
+
+#pragma mark - Public
+
+int Tablebases::load(std::string path) {
+    TablesByMaterial.clear();
+    Files.clear();
+    MaxPiecesLoaded = 0;
+
+    int count = 0;
+    size_t start = 0;
+    while (start <= path.size()) {
+        auto end = std::min(path.find(':', start), path.size());
+        auto directory = path.substr(start, end - start);
+        start = end + 1;
+
+        DIR *dir = directory.empty() ? nullptr : opendir(directory.c_str());
+        if (!dir) {
+            continue;
+        }
+        while (auto item = readdir(dir)) {
+            std::string name = item->d_name;
+            auto dot = name.rfind('.');
+            if (dot == std::string::npos) {
+                continue;
+            }
+            auto extension = name.substr(dot);
+            if (extension != ".rtbw" && extension != ".rtbz") {
+                continue;
+            }
+            auto kind = extension == ".rtbw" ? WDL_TABLE : DTZ_TABLE;
+
+            MaterialKey key, mirroredKey;
+            if (!parseTableName(name.substr(0, dot), key, mirroredKey)) {
+                continue;
+            }
+            std::unique_ptr<TableFile> table(new TableFile(kind, directory + "/" + name, key, mirroredKey));
+            if (table->pieceCount > MaxTablePieces) {
+                continue;
+            }
+
+            // The first directory of the path having a table is the one used
+            auto &pair = TablesByMaterial[key];
+            auto &file = kind == WDL_TABLE ? pair.wdl : pair.dtz;
+            if (file) {
+                continue;
+            }
+            file = table.get();
+            TablesByMaterial[mirroredKey] = pair;
+
+            if (kind == WDL_TABLE) {
+                count++;
+                MaxPiecesLoaded = std::max(MaxPiecesLoaded, table->pieceCount);
+            }
+            Files.push_back(std::move(table));
+        }
+        closedir(dir);
+    }
+    return count;
+}
+
+int Tablebases::maxPieces() {
+    return MaxPiecesLoaded;
+}
+
+bool Tablebases::canProbe(ChessBoard &board) {
+    return board.castling == 0 && bb_count(board.getOccupancy()) <= MaxPiecesLoaded;
+}
+
+bool Tablebases::probeWDL(ChessBoard &board, WDL &wdl) {
+    Outcome outcome;
+    if (!searchOutcome(board, false, outcome)) {
+        return false;
+    }
+    wdl = outcome.wdl;
+    return true;
+}
+
+bool Tablebases::probeDTZ(ChessBoard &board, int &dtz) {
+    return searchDTZ(board, dtz);
+}
+
+bool Tablebases::filterRootMoves(ChessBoard &board, MoveList &moves) {
+    int dtz;
+    if (!searchDTZ(board, dtz)) {
+        return false;
+    }
+
+    // DTZ of each move, counted from the root position
+    std::vector<int> values(moves.count);
+    for (int index=0; index<moves.count; index++) {
+        auto newBoard = board;
+        newBoard.move(moves[index]);
+
+        int value;
+        if (dtz > 0 && newBoard.isCheck(newBoard.color) && ChessMoveGenerator::generateMoves(newBoard).count == 0) {
+            value = 1; // Mate
+        } else if (newBoard.halfMoveClock == 0) {
+            Outcome outcome;
+            if (!searchOutcome(newBoard, false, outcome)) {
+                return false;
+            }
+            value = zeroingMoveDTZ(WDL(-outcome.wdl));
+        } else {
+            if (!searchDTZ(newBoard, value)) {
+                return false;
+            }
+            value = -value;
+            value += sign(value);
+        }
+        values[index] = value;
+    }
+
+    // Winning: keep the winning moves that still win before the fifty-move rule, or only the fastest ones.
+    // Losing: keep all the moves unless the fifty-move rule is close, in which case the slowest ones are kept.
+    // Drawing: keep the moves that draw.
+    int halfMoveClock = board.halfMoveClock;
+    int minValue = 0;
+    int maxValue = 0;
+    if (dtz > 0) {
+        int fastest = 0xFFFF;
+        for (auto value : values) {
+            if (value > 0) {
+                fastest = std::min(fastest, value);
+            }
+        }
+        minValue = 1;
+        maxValue = fastest + halfMoveClock <= 99 ? 99 - halfMoveClock : fastest;
+    } else if (dtz < 0) {
+        int slowest = 0;
+        for (auto value : values) {
+            slowest = std::min(slowest, value);
+        }
+        if (-slowest * 2 + halfMoveClock < 100) {
+            return true;
+        }
+        minValue = maxValue = slowest;
+    }
+
+    MoveList filteredMoves;
+    for (int index=0; index<moves.count; index++) {
+        if (values[index] >= minValue && values[index] <= maxValue) {
+            filteredMoves.push(moves[index]);
+        }
+    }
+    moves = filteredMoves;
+    return true;
+}
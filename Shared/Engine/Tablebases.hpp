@@ -0,0 +1,58 @@
+//
+//  Tablebases.hpp
+//  BChess
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#pragma once
+
+#include "ChessBoard.hpp"
+#include "MoveList.hpp"
+
+#include <string>
+
+// Probing of the Syzygy endgame tablebases, which store for every position with few pieces
+// the outcome with a perfect play (WDL tables, .rtbw) and the distance to the next capture or
+// pawn move that keeps that outcome (DTZ tables, .rtbz).
+// https://www.chessprogramming.org/Syzygy_Bases
+//
+// The files are memory-mapped the first time one of their positions is probed: only the pages
+// actually read are loaded by the system, which lets the tables be much larger than the memory.
+// The format (index of a position, compression of the values) is the one written by the generator
+// of Ronald de Man: https://github.com/syzygy1/tb
+//
+// Note: the tables ignore castling, so a position with castling rights cannot be probed.
+class Tablebases {
+public:
+    // Outcome of a position for the side to move. A cursed win (or a blessed loss) is a win
+    // (or a loss) that cannot be achieved before the fifty-move rule claims a draw.
+    enum WDL: int {
+        LOSS = -2, BLESSED_LOSS = -1, DRAW = 0, CURSED_WIN = 1, WIN = 2
+    };
+
+    // Loads the tables found in the directories of the path, separated by ':', replacing the tables
+    // loaded before. An empty path unloads all the tables. Returns the number of WDL tables found.
+    // Note: no search must be running because the tables in use are unmapped.
+    static int load(std::string path);
+
+    // Largest number of pieces, kings included, of the tables loaded (0 if there is none)
+    static int maxPieces();
+
+    // Returns true if the position has few enough pieces and no castling right
+    static bool canProbe(ChessBoard &board);
+
+    // Probes the outcome of the position, which must have been checked with canProbe().
+    // Returns false if a table needed is missing or cannot be read.
+    static bool probeWDL(ChessBoard &board, WDL &wdl);
+
+    // Probes the distance, in plies, to the next capture or pawn move (or mate) with the best play:
+    // positive for a win, negative for a loss and zero for a draw. A value greater than 100
+    // (or lower than -100) is a cursed win (or a blessed loss). Returns false if a table is missing.
+    static bool probeDTZ(ChessBoard &board, int &dtz);
+
+    // Keeps only the moves that preserve the outcome of the root position and, when winning, make
+    // progress fast enough to win before the fifty-move rule applies. The search then only needs to
+    // pick one of these moves. Returns false, leaving the moves unchanged, if a table is missing.
+    static bool filterRootMoves(ChessBoard &board, MoveList &moves);
+};
@@ -0,0 +1,274 @@
+//
+//  TexelTuner.cpp
+//  BChess
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#include "TexelTuner.hpp"
+#include "FFEN.hpp"
+#include "FUtility.hpp"
+
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+
+using namespace std::chrono;
+
+// Returns the stage of each weight (see ChessEvaluater::Weights::Table)
+static std::vector<uint8_t> weightStages() {
+    std::vector<uint8_t> stages(ChessEvaluater::WeightCount);
+    ChessEvaluater::Weights weights;
+    for (auto table : weights.tables()) {
+        auto start = table.values - (int *)&weights;
+        std::fill(stages.begin() + start, stages.begin() + start + table.count, table.stage);
+    }
+    return stages;
+}
+
+static const std::vector<uint8_t> WeightStages = weightStages();
+
+bool TexelTuner::parse(std::string line, std::vector<Entry> &entries, std::vector<Position> &positions) {
+    // The first four fields of the FEN are the ones of an EPD, the
+    // result of the game can be anywhere after them.
+    std::vector<std::string> fields;
+    split4(line, fields);
+    if (fields.size() < 5) {
+        return false;
+    }
+
+    std::string fen = fields[0] + " " + fields[1] + " " + fields[2] + " " + fields[3];
+    std::string remaining;
+    for (size_t index=4; index<fields.size(); index++) {
+        remaining += fields[index] + " ";
+    }
+
+    int result;
+    if (remaining.find("1/2-1/2") != std::string::npos) {
+        result = 1;
+    } else if (remaining.find("1-0") != std::string::npos) {
+        result = 2;
+    } else if (remaining.find("0-1") != std::string::npos) {
+        result = 0;
+    } else if (remaining.find('[') != std::string::npos) {
+        result = (int)std::lround(atof(remaining.c_str() + remaining.find('[') + 1) * 2);
+    } else {
+        return false;
+    }
+    if (result < 0 || result > 2) {
+        return false;
+    }
+
+    ChessBoard board;
+    if (!FFEN::setFEN(fen, board)) {
+        return false;
+    }
+
+    AttackInfo info(board);
+    EvaluationTrace trace;
+    ChessEvaluater::evaluatePosition(info, trace);
+
+    Position position;
+    position.start = (uint32_t)entries.size();
+    position.count = 0;
+    position.phase = (uint8_t)trace.phase;
+    position.result = (uint8_t)result;
+    for (int index=0; index<ChessEvaluater::WeightCount; index++) {
+        if (trace.coefficients[index] != 0) {
+            entries.push_back({ (uint16_t)(index | (WeightStages[index] << StageShift)), (int16_t)trace.coefficients[index] });
+            position.count++;
+        }
+    }
+    positions.push_back(position);
+    return true;
+}
+
+bool TexelTuner::addPosition(std::string line) {
+    return parse(line, entries, positions);
+}
+
+size_t TexelTuner::load(std::string path) {
+    std::ifstream file(path);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(file, line)) {
+        lines.push_back(line);
+    }
+
+    // Each thread traces its own range of lines, which are then appended in order
+    std::vector<std::vector<Entry>> threadEntries(threads);
+    std::vector<std::vector<Position>> threadPositions(threads);
+    parallelFor(lines.size(), threads, [&](int thread, size_t start, size_t end) {
+        for (size_t index=start; index<end; index++) {
+            parse(lines[index], threadEntries[thread], threadPositions[thread]);
+        }
+    });
+
+    size_t count = 0;
+    for (int thread=0; thread<threads; thread++) {
+        auto offset = (uint32_t)entries.size();
+        for (auto position : threadPositions[thread]) {
+            position.start += offset;
+            positions.push_back(position);
+        }
+        entries.insert(entries.end(), threadEntries[thread].begin(), threadEntries[thread].end());
+        count += threadPositions[thread].size();
+    }
+    return count;
+}
+
+double TexelTuner::evaluate(const Position &position, const double *weights) {
+    // Sum of the middlegame, endgame and untapered terms
+    double sums[ChessEvaluater::STAGE_COUNT + 1] = { };
+    auto end = position.start + position.count;
+    for (auto index=position.start; index<end; index++) {
+        auto entry = entries[index];
+        sums[entry.index >> StageShift] += entry.coefficient * weights[entry.index & IndexMask];
+    }
+    return (sums[ChessEvaluater::MIDDLEGAME] * position.phase + sums[ChessEvaluater::ENDGAME] * (TotalPhase - position.phase)) / TotalPhase + sums[ChessEvaluater::STAGE_COUNT];
+}
+
+double TexelTuner::evaluate(size_t index, const std::vector<double> &weights) {
+    return evaluate(positions[index], weights.data());
+}
+
+// Expected score of white for the evaluation: the sigmoid maps 400 centipawns (divided by K) to a 10:1 ratio
+inline static double sigmoid(double scalingConstant, double value) {
+    return 1.0 / (1.0 + std::pow(10.0, -scalingConstant * value / 400.0));
+}
+
+double TexelTuner::computeGradient(size_t start, size_t end, const double *weights, double *gradient) {
+    double error = 0;
+    for (size_t index=start; index<end; index++) {
+        auto &position = positions[index];
+        double expected = sigmoid(scalingConstant, evaluate(position, weights));
+        double result = position.result / 2.0;
+        error += (result - expected) * (result - expected);
+
+        if (gradient) {
+            // The derivative of the squared error without the constant factor 2 * K * ln(10) / 400,
+            // applied once for all the positions, multiplied by the coefficient of each weight.
+            double derivative = (expected - result) * expected * (1 - expected);
+            double taper[ChessEvaluater::STAGE_COUNT + 1] = {
+                derivative * position.phase / TotalPhase,
+                derivative * (TotalPhase - position.phase) / TotalPhase,
+                derivative
+            };
+            auto last = position.start + position.count;
+            for (auto entryIndex=position.start; entryIndex<last; entryIndex++) {
+                auto entry = entries[entryIndex];
+                gradient[entry.index & IndexMask] += entry.coefficient * taper[entry.index >> StageShift];
+            }
+        }
+    }
+    return error;
+}
+
+double TexelTuner::error(const std::vector<double> &weights) {
+    std::vector<double> errors(threads);
+    parallelFor(positions.size(), threads, [&](int thread, size_t start, size_t end) {
+        errors[thread] = computeGradient(start, end, weights.data(), nullptr);
+    });
+    double error = 0;
+    for (auto threadError : errors) {
+        error += threadError;
+    }
+    return positions.empty() ? 0 : error / positions.size();
+}
+
+std::vector<double> TexelTuner::currentWeights() {
+    auto values = (const int *)&ChessEvaluater::getWeights();
+    return std::vector<double>(values, values + ChessEvaluater::WeightCount);
+}
+
+double TexelTuner::computeScalingConstant() {
+    // Refine K one decimal at a time around the best value so far
+    auto weights = currentWeights();
+    double best = 1.0;
+    double bestError = DBL_MAX;
+    double step = 1.0;
+    for (int iteration=0; iteration<4; iteration++) {
+        double center = best;
+        for (int offset=-10; offset<=10; offset++) {
+            double candidate = center + offset * step / 10;
+            if (candidate <= 0) {
+                continue;
+            }
+            scalingConstant = candidate;
+            double candidateError = error(weights);
+            if (candidateError < bestError) {
+                bestError = candidateError;
+                best = candidate;
+            }
+        }
+        step /= 10;
+    }
+    scalingConstant = best;
+    return best;
+}
+
+ChessEvaluater::Weights TexelTuner::tune(int epochs, Callback callback) {
+    auto weights = currentWeights();
+
+    // The value of the king is not an actual weight, both colors always having one
+    std::vector<bool> frozen(ChessEvaluater::WeightCount, false);
+    auto &evaluaterWeights = ChessEvaluater::getWeights();
+    for (int stage=0; stage<ChessEvaluater::STAGE_COUNT; stage++) {
+        frozen[&evaluaterWeights.pieceValue[stage][KING] - (const int *)&evaluaterWeights] = true;
+    }
+
+    // https://en.wikipedia.org/wiki/Stochastic_gradient_descent#Adam
+    const double beta1 = 0.9;
+    const double beta2 = 0.999;
+    const double epsilon = 1e-8;
+    std::vector<double> momentum(ChessEvaluater::WeightCount, 0);
+    std::vector<double> velocity(ChessEvaluater::WeightCount, 0);
+
+    std::vector<std::vector<double>> gradients(threads, std::vector<double>(ChessEvaluater::WeightCount));
+    std::vector<double> errors(threads);
+    for (int epoch=1; epoch<=epochs; epoch++) {
+        auto start = high_resolution_clock::now();
+
+        parallelFor(positions.size(), threads, [&](int thread, size_t start, size_t end) {
+            std::fill(gradients[thread].begin(), gradients[thread].end(), 0);
+            errors[thread] = computeGradient(start, end, weights.data(), gradients[thread].data());
+        });
+
+        double error = 0;
+        for (auto threadError : errors) {
+            error += threadError;
+        }
+        error /= std::max((size_t)1, positions.size());
+
+        double factor = 2 * scalingConstant * std::log(10.0) / 400 / std::max((size_t)1, positions.size());
+        for (int index=0; index<ChessEvaluater::WeightCount; index++) {
+            if (frozen[index]) {
+                continue;
+            }
+            double gradient = 0;
+            for (int thread=0; thread<threads; thread++) {
+                gradient += gradients[thread][index];
+            }
+            gradient *= factor;
+
+            momentum[index] = beta1 * momentum[index] + (1 - beta1) * gradient;
+            velocity[index] = beta2 * velocity[index] + (1 - beta2) * gradient * gradient;
+            double correctedMomentum = momentum[index] / (1 - std::pow(beta1, epoch));
+            double correctedVelocity = velocity[index] / (1 - std::pow(beta2, epoch));
+            weights[index] -= learningRate * correctedMomentum / (std::sqrt(correctedVelocity) + epsilon);
+        }
+
+        duration<double> elapsed = high_resolution_clock::now() - start;
+        if (callback) {
+            callback(epoch, error, positions.size() / std::max(elapsed.count(), 1e-9));
+        }
+    }
+
+    ChessEvaluater::Weights tunedWeights = ChessEvaluater::getWeights();
+    auto values = (int *)&tunedWeights;
+    for (int index=0; index<ChessEvaluater::WeightCount; index++) {
+        values[index] = (int)std::lround(weights[index]);
+    }
+    return tunedWeights;
+}
@@ -0,0 +1,94 @@
+//
+//  TexelTuner.hpp
+//  BChess
+//
+//  Copyright © 2026 Jean Bovet. All rights reserved.
+//
+
+#pragma once
+
+#include "ChessEvaluater.hpp"
+
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Tunes the weights of the hand-crafted evaluation with the Texel method: the evaluation of positions labelled
+// with the result of their game is mapped to an expected score with a sigmoid, and the weights are fitted by
+// gradient descent to minimize the mean squared error between the expected score and the actual result.
+// https://www.chessprogramming.org/Texel%27s_Tuning_Method
+//
+// The evaluation being linear in the weights, each position is stored as the coefficients of the weights
+// in its evaluation (see EvaluationTrace), which is all the tuner needs to evaluate it with any weights and
+// to compute the gradient, without generating the attacks again. A position takes about 150 bytes.
+// Note: the positions should be quiet because the evaluation doesn't take the captures into account.
+class TexelTuner {
+public:
+    // Number of threads loading and evaluating the positions
+    int threads = std::max(1, (int)std::thread::hardware_concurrency());
+
+    // Learning rate of the gradient descent, in centipawns
+    double learningRate = 1.0;
+
+    // Adds the positions of a file with one position per line: a FEN (or EPD) followed by the result
+    // of the game, either "1-0", "0-1", "1/2-1/2" or the score of white, like [1.0], [0.5] or [0.0].
+    // The lines that cannot be parsed are skipped. Returns the number of positions added.
+    // Note: the positions are traced with the current ChessEvaluater::positionalAnalysis.
+    size_t load(std::string path);
+
+    // Adds a single position (same format as a line of the file above)
+    bool addPosition(std::string line);
+
+    size_t count() {
+        return positions.size();
+    }
+
+    // Returns the evaluation of a position, from white's point of view, with the specified weights
+    double evaluate(size_t index, const std::vector<double> &weights);
+
+    // Returns the mean squared error of the positions with the specified weights
+    double error(const std::vector<double> &weights);
+
+    // Finds the scaling constant K of the sigmoid that minimizes the error with the current weights,
+    // which is then used by tune(). It depends on the scale of the evaluation, not on the weights.
+    double computeScalingConstant();
+
+    // Runs the gradient descent for the specified number of epochs, starting with the current weights
+    // of ChessEvaluater, and returns the tuned weights. The callback is invoked after each epoch
+    // with the error and the number of positions evaluated per second.
+    typedef std::function<void(int epoch, double error, double positionsPerSecond)> Callback;
+    ChessEvaluater::Weights tune(int epochs, Callback callback = nullptr);
+
+private:
+    // Coefficient of a weight in the evaluation of a position. The stage of the weight is
+    // stored with its index to interpolate the coefficient without looking it up.
+    struct Entry {
+        uint16_t index;
+        int16_t coefficient;
+    };
+
+    static const uint16_t IndexMask = 0x3FFF;
+    static const int StageShift = 14;
+
+    struct Position {
+        uint32_t start;
+        uint16_t count;
+        uint8_t phase;
+        uint8_t result; // In half-points for white: 0, 1 or 2
+    };
+
+    std::vector<Entry> entries;
+    std::vector<Position> positions;
+
+    double scalingConstant = 1.0;
+
+    bool parse(std::string line, std::vector<Entry> &entries, std::vector<Position> &positions);
+
+    double evaluate(const Position &position, const double *weights);
+
+    // Returns the error of the positions of the range and adds their gradient
+    double computeGradient(size_t start, size_t end, const double *weights, double *gradient);
+
+    std::vector<double> currentWeights();
+};
@@ -16,12 +16,12 @@
 
 typedef uint64_t Bitboard;
 
-inline static bool bb_test(Bitboard bitboard, Square square) {
+inline static constexpr bool bb_test(Bitboard bitboard, Square square) {
     uint64_t test = bitboard & (1UL << square);
     return test > 0;
 }
 
-inline static bool bb_test(Bitboard bitboard, File file, Rank rank) {
+inline static constexpr bool bb_test(Bitboard bitboard, File file, Rank rank) {
     return bb_test(bitboard, SquareFrom(file, rank));
 }
 
@@ -33,11 +33,11 @@ inline static void bb_clear(Bitboard &bitboard, File file, Rank rank) {
     bb_clear(bitboard, SquareFrom(file, rank));
 }
 
-inline static void bb_set(Bitboard &bitboard, Square square) {
+inline static constexpr void bb_set(Bitboard &bitboard, Square square) {
     bitboard |= 1UL << square;
 }
 
-inline static void bb_set(Bitboard &bitboard, File file, Rank rank) {
+inline static constexpr void bb_set(Bitboard &bitboard, File file, Rank rank) {
     if (file >= 0 && file <= 7 && rank >= 0 && rank <= 7) {
         bb_set(bitboard, SquareFrom(file, rank));
     }
@@ -8,7 +8,9 @@
 
 #pragma once
 
-enum Color: unsigned {
+#include <cstdint>
+
+enum Color: uint8_t {
     WHITE, BLACK, COUNT
 };
 
@@ -19,15 +19,15 @@ typedef uint8_t Rank;
 
 #define SquareUndefined UINT8_MAX
 
-inline static Square SquareFrom(File file, Rank rank) {
+inline static constexpr Square SquareFrom(File file, Rank rank) {
     return 8 * rank + file;
 }
 
-inline static File FileFrom(Square square) {
+inline static constexpr File FileFrom(Square square) {
     return square & 7;
 }
 
-inline static Rank RankFrom(int square) {
+inline static constexpr Rank RankFrom(int square) {
     return (Rank)(square >> 3);
 }
 
@@ -130,3 +130,45 @@ inline static Move createEnPassant(Square from, Square to, Color color, Piece pi
     return m;
 }
 
+// A compact move needs 16 bits to be stored, the other information of the move
+// being found again from the board it is played on (see ChessBoard::decodeMove()).
+// It is used where the moves are stored in large numbers, like the transposition table.
+// bit 0-5: origin square (from 0 to 63)
+// bit 6-11: destination square (from 0 to 63)
+// bit 12-13: promotion PIECE, from KNIGHT (0) to QUEEN (3)
+// bit 14-15: flag (see CompactMoveFlag)
+typedef uint16_t CompactMove;
+
+enum CompactMoveFlag: uint16_t {
+    COMPACT_NORMAL, COMPACT_PROMOTION, COMPACT_ENPASSANT, COMPACT_CASTLING
+};
+
+static const CompactMove INVALID_COMPACT_MOVE = 0;
+
+inline static CompactMove COMPACT_MOVE(Move move) {
+    CompactMove compact = move & 0xFFF;
+    if (MOVE_PROMOTION_PIECE(move) > PAWN) {
+        compact |= (MOVE_PROMOTION_PIECE(move) - KNIGHT) << 12 | COMPACT_PROMOTION << 14;
+    } else if (MOVE_IS_ENPASSANT(move)) {
+        compact |= COMPACT_ENPASSANT << 14;
+    } else if (MOVE_IS_CASTLING(move)) {
+        compact |= COMPACT_CASTLING << 14;
+    }
+    return compact;
+}
+
+inline static Square COMPACT_MOVE_FROM(CompactMove compact) {
+    return compact & 63;
+}
+
+inline static Square COMPACT_MOVE_TO(CompactMove compact) {
+    return (compact >> 6) & 63;
+}
+
+inline static Piece COMPACT_MOVE_PROMOTION_PIECE(CompactMove compact) {
+    return Piece(KNIGHT + ((compact >> 12) & 3));
+}
+
+inline static CompactMoveFlag COMPACT_MOVE_FLAG(CompactMove compact) {
+    return CompactMoveFlag(compact >> 14);
+}